@@ -61,6 +61,18 @@ typedef struct {
     radio_sx126x_regional_param_t                regional_radio_param;
 } halo_drv_semtech_ctx_t;
 
+/* Histogram of sx126x_wait_on_busy() durations, bucket 0 counts calls which
+ * found BUSY already low, bucket n counts waits below 4^(n+1) us, the last
+ * bucket everything above */
+#define SX126X_BUSY_WAIT_HIST_BUCKETS               8
+
+typedef struct {
+    uint32_t                                     histogram[SX126X_BUSY_WAIT_HIST_BUCKETS];
+    uint32_t                                     irq_waits;
+    uint32_t                                     timeouts;
+    uint32_t                                     max_us;
+} sx126x_busy_wait_stats_t;
+
 /* enum for calibration bands in semtech radio */
 typedef enum {
     SX126X_BAND_900M,
@@ -111,6 +123,39 @@ const halo_drv_semtech_ctx_t* sx126x_get_drv_ctx(void);
 
 int32_t sx126x_wait_on_busy(void);
 
+void sx126x_get_busy_wait_stats(sx126x_busy_wait_stats_t *stats);
+
+void sx126x_reset_busy_wait_stats(void);
+
+/*
+ * @brief Queue the following sx126x_hal_write() transactions instead of
+ * sending them. They are sent back to back by sx126x_hal_batch_commit() with
+ * a single wakeup check. A read sends the queue first. Batches nest, the
+ * outermost commit sends. Every begin is ended by exactly one commit or
+ * abort.
+ */
+void sx126x_hal_batch_begin(void);
+
+/*
+ * @brief Send the queued transactions
+ * @param [in] drv_ctx driver context
+ * @return RADIO_ERROR_NONE when every transaction was sent
+ */
+int32_t sx126x_hal_batch_commit(const halo_drv_semtech_ctx_t *drv_ctx);
+
+/*
+ * @brief End a batch without sending it, for a sequence which failed half
+ * way. The queue is dropped when the outermost batch is aborted.
+ */
+void sx126x_hal_batch_abort(void);
+
+/*
+ * @brief Delay in sequence with the queued transactions, right away when
+ * nothing is queued
+ * @param [in] delay_us delay in us
+ */
+void sx126x_hal_delay_us(uint16_t delay_us);
+
 void set_gpio_cfg_awake(const halo_drv_semtech_ctx_t *drv_ctx);
 
 void set_gpio_cfg_sleep(const halo_drv_semtech_ctx_t *drv_ctx);
@@ -130,6 +175,16 @@ void set_lora_exit_mode(sid_pal_radio_cad_param_exit_mode_t cad_exit_mode);
 
 int32_t set_radio_sx126x_trim_cap_val(uint16_t trim);
 
+/**
+ * Crystal trim offset for a temperature, added to both XTA and XTB trim values.
+ * The default returns 0, boards with a characterised crystal override it.
+ * Not used when the radio runs from a tcxo.
+ *
+ * @param [in] temperature filtered temperature in milli degree Celsius
+ * @return signed trim step offset
+ */
+int8_t sx126x_xtal_trim_temperature_offset(int32_t temperature);
+
 int32_t get_radio_sx126x_pa_config(radio_sx126x_pa_cfg_t *cfg);
 
 #ifdef __cplusplus
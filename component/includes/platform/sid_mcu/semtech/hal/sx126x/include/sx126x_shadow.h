@@ -0,0 +1,115 @@
+/***************************************************************************//**
+ * @file
+ * @brief sx126x_shadow.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SX126X_SHADOW_H
+#define SX126X_SHADOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// Skips configuration commands whose bytes equal the last ones written to the
+// radio, only commands with no side effect besides the configuration are kept
+#ifndef SX126X_SHADOW_ENABLE
+#define SX126X_SHADOW_ENABLE                1
+#endif
+
+typedef struct {
+  uint32_t writes;          // write transactions which reached the radio
+  uint32_t saved;           // write transactions skipped as redundant
+  uint32_t invalidations;   // shadow drops on sleep, reset, wakeup or error
+} sx126x_shadow_stats_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Checks a write against the shadow, counts it as saved if it is redundant
+ * @param[in] command Command bytes as given to sx126x_hal_write
+ * @param[in] command_length Length of command
+ * @param[in] data Data bytes as given to sx126x_hal_write, can be NULL
+ * @param[in] data_length Length of data
+ * @return true if the radio already holds this configuration
+ ******************************************************************************/
+bool sx126x_shadow_is_redundant(const uint8_t *command, uint16_t command_length,
+                                const uint8_t *data, uint16_t data_length);
+
+/*******************************************************************************
+ * Records a write which was sent to the radio
+ * @param[in] command Command bytes as given to sx126x_hal_write
+ * @param[in] command_length Length of command
+ * @param[in] data Data bytes as given to sx126x_hal_write, can be NULL
+ * @param[in] data_length Length of data
+ * @param[in] success false if the transaction failed, the radio state is then
+ *                    unknown and the shadow is dropped
+ ******************************************************************************/
+void sx126x_shadow_update(const uint8_t *command, uint16_t command_length,
+                          const uint8_t *data, uint16_t data_length, bool success);
+
+/*******************************************************************************
+ * Drops the whole shadow, the next configuration writes go to the radio
+ ******************************************************************************/
+void sx126x_shadow_invalidate(void);
+
+/*******************************************************************************
+ * Copies the shadow statistics
+ * @param[out] stats Statistics
+ ******************************************************************************/
+void sx126x_shadow_get_stats(sx126x_shadow_stats_t *stats);
+
+/*******************************************************************************
+ * Clears the shadow statistics
+ ******************************************************************************/
+void sx126x_shadow_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SX126X_SHADOW_H */
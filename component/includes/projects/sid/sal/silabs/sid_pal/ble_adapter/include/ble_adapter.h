@@ -44,12 +44,45 @@ extern "C" {
 // -----------------------------------------------------------------------------
 //                                   Includes
 // -----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
 #include "sl_bt_api.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+// Notification TX queue statistics of the current connection
+typedef struct {
+  uint32_t frames_queued;                   // Frames accepted by ble_adapter_send_data()
+  uint32_t frames_rejected;                 // Frames refused because the queue was full
+  uint32_t frames_sent;                     // Frames handed over to the stack
+  uint32_t frames_dropped;                  // Frames failed or flushed on disconnect
+  uint32_t bytes_sent;
+  uint32_t buffer_full;                     // Times the stack had no TX buffer left
+  uint32_t bursts;                          // Queue drains that sent at least one frame
+  uint16_t burst_frames_last;               // Frames sent by the last drain, packed into the same connection event(s)
+  uint16_t burst_frames_max;
+  uint16_t queue_depth;
+  uint16_t queue_depth_max;
+} sl_ble_adapter_tx_stats_t;
+
+// Connection parameters in effect on the current connection, as reported by
+// the stack, and the requests of the throughput profile
+typedef struct {
+  uint16_t interval;                        // In units of 1.25 ms
+  uint16_t latency;                         // In connection intervals
+  uint16_t timeout;                         // In units of 10 ms
+  uint16_t txsize;                          // Maximum LL PDU payload the stack sends
+  uint16_t tx_data_len;                     // Negotiated LL TX octets
+  uint16_t rx_data_len;                     // Negotiated LL RX octets
+  uint16_t mtu;                             // Negotiated ATT MTU
+  uint8_t phy;                              // sl_bt_gap_phy_t in use
+  bool is_bulk;                             // Short connection interval requested
+  uint32_t bulk_requests;
+  uint32_t idle_requests;
+} sl_ble_adapter_conn_stats_t;
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -59,6 +92,9 @@ extern "C" {
 // -----------------------------------------------------------------------------
 void sl_ble_adapter_on_event(sl_bt_msg_t *evt);
 void sl_ble_adapter_on_kernel_start(void);
+void sl_ble_adapter_get_tx_stats(sl_ble_adapter_tx_stats_t *stats);
+void sl_ble_adapter_reset_tx_stats(void);
+void sl_ble_adapter_get_conn_stats(sl_ble_adapter_conn_stats_t *stats);
 
 #ifdef __cplusplus
 }
@@ -189,6 +189,24 @@ typedef struct efr32xgxx_pkt_params_gfsk_s {
   efr32xgxx_gfsk_dc_free_t       dc_free;                  //!< Whitening configuration
 } efr32xgxx_pkt_params_gfsk_t;
 
+// PHY profile switches, a switch is a RAIL channel config change
+typedef struct efr32xgxx_phy_switch_stats_s {
+  uint32_t switches;  // channel configs applied
+  uint32_t skipped;   // requests for the profile already active
+  uint32_t last_us;   // duration of the last switch
+  uint32_t max_us;    // longest switch
+} efr32xgxx_phy_switch_stats_t;
+
+// Radio calibrations run while the radio is idle
+typedef struct efr32xgxx_cal_stats_s {
+  uint32_t count;           // calibration runs
+  uint32_t errors;          // runs that failed
+  uint32_t ircal_restored;  // IR calibrations restored from NVM3
+  uint32_t last_us;         // duration of the last run
+  uint32_t max_us;          // longest run
+  uint32_t total_us;        // time spent calibrating since boot
+} efr32xgxx_cal_stats_t;
+
 // -----------------------------------------------------------------------------
 //                          Public Function Declarations
 // -----------------------------------------------------------------------------
@@ -210,6 +228,7 @@ int32_t efr32xgxx_set_sleep(void);
 int32_t efr32xgxx_set_standby(void);
 int32_t efr32xgxx_set_tx(const uint32_t timeout);
 int32_t efr32xgxx_set_rx(const uint32_t timeout);
+int32_t efr32xgxx_set_rx_duty_cycle(const uint32_t rx_time, const uint32_t sleep_time);
 int32_t efr32xgxx_set_tx_cw(void);
 int32_t efr32xgxx_set_tx_cpbl(void);
 int32_t efr32xgxx_set_rf_freq(const uint32_t freq_in_hz);
@@ -219,6 +238,8 @@ uint32_t efr32xgxx_get_gfsk_time_on_air_in_ms(const efr32xgxx_pkt_params_gfsk_t*
                                               const efr32xgxx_mod_params_gfsk_t* mod_p);
 int32_t efr32xgxx_set_gfsk_sync_word(const uint8_t* sync_word, const uint8_t sync_word_len);
 int32_t efr32xgxx_set_gfsk_mod_params(const efr32xgxx_mod_params_gfsk_t* params);
+void efr32xgxx_get_phy_switch_stats(efr32xgxx_phy_switch_stats_t *stats);
+void efr32xgxx_get_cal_stats(efr32xgxx_cal_stats_t *stats);
 int32_t efr32xgxx_set_gfsk_pkt_params(const efr32xgxx_pkt_params_gfsk_t* params);
 
 uint32_t compute_crc32(const uint8_t* buffer, uint16_t length);
@@ -52,11 +52,18 @@ extern "C" {
 #include <stdbool.h>
 
 #include <sid_pal_gpio_ifc.h>
+#include <sid_time_types.h>
 #include "em_gpio.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
+// Allow GPIO callbacks to run outside the edge interrupt, from a task when a
+// kernel is present or from a software interrupt otherwise
+#ifndef SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+#define SL_SID_GPIO_IRQ_DEFERRED_ENABLE 0
+#endif
+
 enum SL_PINout {
   SL_PIN_BUSY = 0,
   SL_PIN_ANTSW,
@@ -82,6 +89,36 @@ struct GPIO_LookupItem{
   void * callbackarg;
 };
 
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+/*******************************************************************************
+ * Get the time elapsed since the last edge interrupt of a pin. The edge is
+ * timestamped on the uptime counter before the callback runs, so subtracting
+ * this from the current time gives the edge time.
+ *
+ * @param[in]   gpio_number     gpio_lookup_table index
+ * @param[out]  latency         time elapsed since the edge
+ *
+ * @retval SID_ERROR_NONE in case of success
+ * @retval SID_ERROR_NOT_FOUND if no edge was seen on the pin yet
+ ******************************************************************************/
+sid_error_t sli_sid_gpio_get_irq_latency(uint32_t gpio_number, struct sid_timespec * latency);
+
+/*******************************************************************************
+ * Run the callback of a pin outside interrupt context. Only the edge timestamp
+ * is taken in the ISR, the callback is scheduled to the GPIO task or software
+ * interrupt.
+ *
+ * @param[in]   gpio_number     gpio_lookup_table index
+ * @param[in]   deferred        true to defer the callback, false to run it
+ *                              from the edge interrupt
+ *
+ * @retval SID_ERROR_NONE in case of success
+ * @retval SID_ERROR_NOSUPPORT if SL_SID_GPIO_IRQ_DEFERRED_ENABLE is not set
+ ******************************************************************************/
+sid_error_t sli_sid_gpio_set_irq_deferred(uint32_t gpio_number, bool deferred);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,100 @@
+/***************************************************************************//**
+ * @file
+ * @brief mfg_store.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef MFG_STORE_H
+#define MFG_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sid_pal_mfg_store_ifc.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// Loads the immutable sidewalk values (identity, certificate chains, APID,
+// app server key) into RAM at sid_pal_mfg_store_init, private keys are never
+// cached
+#ifndef SL_SID_MFG_STORE_CACHE_ENABLE
+#define SL_SID_MFG_STORE_CACHE_ENABLE       1
+#endif
+
+// RAM reserved for the cached values, values that do not fit are read from NVM3
+#ifndef SL_SID_MFG_STORE_CACHE_POOL_SIZE
+#define SL_SID_MFG_STORE_CACHE_POOL_SIZE    1536
+#endif
+
+typedef struct {
+  uint32_t hits;            // reads served from RAM, including absent values
+  uint32_t misses;          // reads that went to NVM3
+  uint16_t cached_values;   // values present in the cache
+  uint16_t cached_bytes;    // bytes of the pool in use
+  bool is_valid;            // false after a write or erase changed the layout
+} sli_sid_mfg_store_cache_stats_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Returns a pointer to a cached mfg value, no copy is made
+ * @param[in] value Mfg value identifier
+ * @param[out] length Length of the value, can be NULL
+ * @return Pointer to the value, NULL if it is not cached or not provisioned.
+ *         The pointer stays valid until the next mfg store write, erase or init.
+ ******************************************************************************/
+const uint8_t *sli_sid_mfg_store_get_ptr(uint16_t value, uint16_t *length);
+
+/*******************************************************************************
+ * Copies the mfg cache statistics
+ * @param[out] stats Statistics
+ ******************************************************************************/
+void sli_sid_mfg_store_get_cache_stats(sli_sid_mfg_store_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MFG_STORE_H */
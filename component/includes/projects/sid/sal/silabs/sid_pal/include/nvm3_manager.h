@@ -46,6 +46,7 @@ extern "C" {
 //                                   Includes
 // -----------------------------------------------------------------------------
 
+#include <stdbool.h>
 #include "nvm3.h"
 #include "sid_error.h"
 
@@ -57,29 +58,80 @@ extern "C" {
 
 #define SLI_SID_NVM3_KEY_BASE         0xA0000 // reserved for sidewalk in gsdk
 
+// The top 0x200 keys of the former 0x0 - 0x1FFF APP range are kept by the
+// sidewalk PAL and components for their own objects (calibration results,
+// caches). Applications get 0x0 - 0x1DFF, the KV and MFG ranges are unchanged.
 #define SLI_SID_NVM3_KEY_MIN_APP_REL  0x0
-#define SLI_SID_NVM3_KEY_MAX_APP_REL  0x1FFF
+#define SLI_SID_NVM3_KEY_MAX_APP_REL  0x1DFF
+#define SLI_SID_NVM3_KEY_MIN_PAL_REL  0x0
+#define SLI_SID_NVM3_KEY_MAX_PAL_REL  0x1FF
 #define SLI_SID_NVM3_KEY_MIN_KV_REL   0x0     // defined in sid_pal_storage_kv_internal_group_ids.h
 #define SLI_SID_NVM3_KEY_MAX_KV_REL   0x6FFF  // defined in sid_pal_storage_kv_internal_group_ids.h
 #define SLI_SID_NVM3_KEY_MIN_MFG_REL  0x0     // defined in sid_pal_mfg_store_ifc.h
 #define SLI_SID_NVM3_KEY_MAX_MFG_REL  0x6FFF  // defined in sid_pal_mfg_store_ifc.h
 
-#define SLI_SID_NVM3_KEY_MIN_APP      (SLI_SID_NVM3_KEY_BASE + SLI_SID_NVM3_KEY_MIN_APP_REL)        // 0xA0000 - 0xA1FFF
+#define SLI_SID_NVM3_KEY_MIN_APP      (SLI_SID_NVM3_KEY_BASE + SLI_SID_NVM3_KEY_MIN_APP_REL)        // 0xA0000 - 0xA1DFF
 #define SLI_SID_NVM3_KEY_MAX_APP      (SLI_SID_NVM3_KEY_BASE + SLI_SID_NVM3_KEY_MAX_APP_REL)
-#define SLI_SID_NVM3_KEY_MIN_KV       (SLI_SID_NVM3_KEY_MAX_APP + 1)                                // 0xA2000 - 0xA8FFF
-#define SLI_SID_NVM3_KEY_MAX_KV       (SLI_SID_NVM3_KEY_MAX_APP + 1 + SLI_SID_NVM3_KEY_MAX_KV_REL)
+#define SLI_SID_NVM3_KEY_MIN_PAL      (SLI_SID_NVM3_KEY_MAX_APP + 1)                                // 0xA1E00 - 0xA1FFF
+#define SLI_SID_NVM3_KEY_MAX_PAL      (SLI_SID_NVM3_KEY_MAX_APP + 1 + SLI_SID_NVM3_KEY_MAX_PAL_REL)
+#define SLI_SID_NVM3_KEY_MIN_KV       (SLI_SID_NVM3_KEY_MAX_PAL + 1)                                // 0xA2000 - 0xA8FFF
+#define SLI_SID_NVM3_KEY_MAX_KV       (SLI_SID_NVM3_KEY_MAX_PAL + 1 + SLI_SID_NVM3_KEY_MAX_KV_REL)
 #define SLI_SID_NVM3_KEY_MIN_MFG      (SLI_SID_NVM3_KEY_MAX_KV + 1)
 #define SLI_SID_NVM3_KEY_MAX_MFG      (SLI_SID_NVM3_KEY_MAX_KV + 1 + SLI_SID_NVM3_KEY_MAX_MFG_REL)  // 0xA9000 - 0xAFFFF
 
 #define SLI_SID_NVM3_KEY_BASE_APP     SLI_SID_NVM3_KEY_MIN_APP
+#define SLI_SID_NVM3_KEY_BASE_PAL     SLI_SID_NVM3_KEY_MIN_PAL
 #define SLI_SID_NVM3_KEY_BASE_KV      SLI_SID_NVM3_KEY_MIN_KV
 #define SLI_SID_NVM3_KEY_BASE_MFG     SLI_SID_NVM3_KEY_MIN_MFG
 
 // -- DO NOT MODIFY END --
 
+// Allocations inside the PAL range, relative to SLI_SID_NVM3_KEY_BASE_PAL
+#define SLI_SID_NVM3_PAL_KEY_RADIO_IRCAL          0x000   // efr32xgxx IR calibration, 1 key
+#define SLI_SID_NVM3_PAL_KEY_QR_CODE_CACHE        0x100   // QR code cache, up to 0x100 keys
+#define SLI_SID_NVM3_PAL_KEY_QR_CODE_CACHE_COUNT  0x100
+
 #define SLI_SID_NVM3_VALIDATE_KEY(region, key)    ((uint32_t)key <= SLI_SID_NVM3_KEY_MAX_##region##_REL)
 #define SLI_SID_NVM3_MAP_KEY(region, key)         (SLI_SID_NVM3_KEY_BASE_##region + (uint32_t)key)
 
+// Repacks requested by sli_sid_nvm3_write are run later in small steps by
+// sli_sid_nvm3_process, from an idle priority task when a kernel is present.
+// Bare-metal applications must call it from their main loop until it returns
+// false before going to sleep (see the PDP example), otherwise the repack only
+// happens when a write runs out of space. When 0 every write repacks
+// synchronously.
+#ifndef SL_SID_NVM3_BACKGROUND_REPACK_ENABLE
+#define SL_SID_NVM3_BACKGROUND_REPACK_ENABLE      1
+#endif
+
+#ifndef SL_SID_NVM3_REPACK_TASK_STACK_SIZE
+#define SL_SID_NVM3_REPACK_TASK_STACK_SIZE        1024  // in bytes
+#endif
+
+// Key ranges the write statistics are kept for
+typedef enum {
+  SLI_SID_NVM3_RANGE_APP = 0,
+  SLI_SID_NVM3_RANGE_PAL,       // objects kept by the PAL and components
+  SLI_SID_NVM3_RANGE_KV,
+  SLI_SID_NVM3_RANGE_MFG,
+  SLI_SID_NVM3_RANGE_OTHER,     // keys outside of the sidewalk region
+  SLI_SID_NVM3_RANGE_COUNT
+} sli_sid_nvm3_range_t;
+
+typedef struct {
+  uint32_t writes[SLI_SID_NVM3_RANGE_COUNT];
+  uint32_t bytes_written[SLI_SID_NVM3_RANGE_COUNT];
+  uint32_t write_errors;
+  uint32_t repack_requests;       // writes after which nvm3 asked for a repack
+  uint32_t repack_steps;          // nvm3_repack calls
+  uint32_t repack_errors;
+  uint32_t repack_forced;         // synchronous repacks after a storage full error
+  uint32_t repack_time_total_ms;
+  uint32_t repack_time_max_ms;
+  uint32_t page_erases_estimate;  // since boot, from the bytes written and the object overhead
+  uint32_t erase_count;           // lifetime erase count of the least worn page, from nvm3
+} sli_sid_nvm3_stats_t;
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -95,6 +147,46 @@ extern "C" {
  ******************************************************************************/
 sid_error_t sli_sid_nvm3_convert_ecode_to_sid_error(Ecode_t nvm3_return_code);
 
+/*******************************************************************************
+ * Creates the background repack task. Called once the default nvm3 instance
+ * is open, further calls do nothing.
+ ******************************************************************************/
+void sli_sid_nvm3_init(void);
+
+/*******************************************************************************
+ * Writes an object to the default nvm3 instance and accounts for it in the
+ * statistics. A repack needed after the write is scheduled instead of being
+ * run by the caller, see SL_SID_NVM3_BACKGROUND_REPACK_ENABLE.
+ * @param[in] key Object key
+ * @param[in] value Object data
+ * @param[in] len Object length in bytes
+ * @return nvm3 error code
+ ******************************************************************************/
+Ecode_t sli_sid_nvm3_write(nvm3_ObjectKey_t key, const void *value, size_t len);
+
+/*******************************************************************************
+ * Runs one repack step of the default nvm3 instance if a repack is pending.
+ * Must not be called from interrupt context.
+ * @return true if more repack work is pending
+ ******************************************************************************/
+bool sli_sid_nvm3_process(void);
+
+/*******************************************************************************
+ * Tells whether a repack is pending
+ ******************************************************************************/
+bool sli_sid_nvm3_is_repack_pending(void);
+
+/*******************************************************************************
+ * Copies the nvm3 statistics
+ * @param[out] stats Statistics
+ ******************************************************************************/
+void sli_sid_nvm3_get_stats(sli_sid_nvm3_stats_t *stats);
+
+/*******************************************************************************
+ * Clears the nvm3 statistics that are counted since boot
+ ******************************************************************************/
+void sli_sid_nvm3_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+ * @file
+ * @brief temperature.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef TEMPERATURE_H
+#define TEMPERATURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sid_error.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// Number of threshold callbacks which can be registered
+#ifndef SLI_SID_TEMPERATURE_MAX_CALLBACKS
+#define SLI_SID_TEMPERATURE_MAX_CALLBACKS     4
+#endif
+
+/*******************************************************************************
+ * Threshold callback, called from the sampling context (sleeptimer interrupt
+ * or the task feeding an external sensor) so it must not block.
+ *
+ * @param[in]   temperature     filtered temperature in milli degree Celsius
+ * @param[in]   context         context given at registration
+ ******************************************************************************/
+typedef void (*sli_sid_temperature_cb_t)(int32_t temperature, void *context);
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Get the filtered temperature. Does not access the sensor.
+ *
+ * @param[out]  temperature     filtered temperature in milli degree Celsius
+ *
+ * @retval SID_ERROR_NONE in case of success
+ * @retval SID_ERROR_UNINITIALIZED if no sample has been taken yet
+ ******************************************************************************/
+sid_error_t sli_sid_temperature_get(int32_t *temperature);
+
+/*******************************************************************************
+ * Register a callback fired when the filtered temperature moved by at least
+ * delta since the last time the callback was fired. The callback also fires
+ * on the first sample.
+ *
+ * @param[in]   delta           threshold in milli degree Celsius
+ * @param[in]   callback        callback to call
+ * @param[in]   context         passed to the callback
+ *
+ * @retval SID_ERROR_NONE in case of success
+ * @retval SID_ERROR_OOM if all callback slots are used
+ ******************************************************************************/
+sid_error_t sli_sid_temperature_register_cb(int32_t delta,
+                                            sli_sid_temperature_cb_t callback,
+                                            void *context);
+
+/*******************************************************************************
+ * Feed a reading of an external sensor (e.g. Si70xx). The first reading
+ * stops the internal sensor sampling, the caller owns the sampling rate from
+ * then on.
+ *
+ * @param[in]   temperature     measured temperature in milli degree Celsius
+ ******************************************************************************/
+void sli_sid_temperature_feed(int32_t temperature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEMPERATURE_H
@@ -25,7 +25,7 @@
  *** GLOBAL FUNCTIONS
  ******************************************************************************/
 
-sl_sid_app_msg_st_t sli_sid_app_msg_dev_mgmt_cmd_handler(sl_sid_app_msg_t *msg)
+sl_sid_app_msg_st_t sli_sid_app_msg_dev_mgmt_cmd_handler(const sl_sid_app_msg_view_t *msg)
 {
   sl_sid_app_msg_st_t status = SL_SID_APP_MSG_ERR_ST_SUCCESS;
 
@@ -36,9 +36,11 @@ sl_sid_app_msg_st_t sli_sid_app_msg_dev_mgmt_cmd_handler(sl_sid_app_msg_t *msg)
           return SL_SID_APP_MSG_ERR_ST_APP_WRONG_OP;
         }
 
+        SLI_SID_APP_MSG_RETURN_ST_IF_VALUE_SHORT(msg, sli_sid_app_msg_dev_mgmt_rst_dev_set_t);
+
         sl_sid_app_msg_dev_mgmt_rst_dev_ctx_t ctx = {
-          .param_send.in_millisecs = ((sli_sid_app_msg_dev_mgmt_rst_dev_set_t *)msg->value)->in_millisecs,
-          .param_send.reset_type = ((sli_sid_app_msg_dev_mgmt_rst_dev_set_t *)msg->value)->reset_type,
+          .param_send.in_millisecs = ((const sli_sid_app_msg_dev_mgmt_rst_dev_set_t *)msg->value)->in_millisecs,
+          .param_send.reset_type = ((const sli_sid_app_msg_dev_mgmt_rst_dev_set_t *)msg->value)->reset_type,
           .hdl.operation = msg->tag.op,
           .hdl.sequence = msg->tag.seq
         };
@@ -52,9 +54,11 @@ sl_sid_app_msg_st_t sli_sid_app_msg_dev_mgmt_cmd_handler(sl_sid_app_msg_t *msg)
           return SL_SID_APP_MSG_ERR_ST_APP_WRONG_OP;
         }
 
+        SLI_SID_APP_MSG_RETURN_ST_IF_VALUE_SHORT(msg, sli_sid_app_msg_dev_mgmt_button_press_set_t);
+
         sl_sid_app_msg_dev_mgmt_button_press_ctx_t ctx = {
-          .param_send.button = ((sli_sid_app_msg_dev_mgmt_button_press_set_t *)msg->value)->button,
-          .param_send.duration = ((sli_sid_app_msg_dev_mgmt_button_press_set_t *)msg->value)->duration,
+          .param_send.button = ((const sli_sid_app_msg_dev_mgmt_button_press_set_t *)msg->value)->button,
+          .param_send.duration = ((const sli_sid_app_msg_dev_mgmt_button_press_set_t *)msg->value)->duration,
           .is_emulation = true,
           .hdl.operation = msg->tag.op,
           .hdl.sequence = msg->tag.seq
@@ -69,8 +73,10 @@ sl_sid_app_msg_st_t sli_sid_app_msg_dev_mgmt_cmd_handler(sl_sid_app_msg_t *msg)
           return SL_SID_APP_MSG_ERR_ST_APP_WRONG_OP;
         }
 
+        SLI_SID_APP_MSG_RETURN_ST_IF_VALUE_SHORT(msg, sli_sid_app_msg_dev_mgmt_toggle_led_set_t);
+
         sl_sid_app_msg_dev_mgmt_toggle_led_ctx_t ctx = {
-          .param_send.led = ((sli_sid_app_msg_dev_mgmt_toggle_led_set_t *)msg->value)->led,
+          .param_send.led = ((const sli_sid_app_msg_dev_mgmt_toggle_led_set_t *)msg->value)->led,
           .hdl.operation = msg->tag.op,
           .hdl.sequence = msg->tag.seq
         };
@@ -87,7 +93,7 @@ sl_sid_app_msg_st_t sli_sid_app_msg_dev_mgmt_cmd_handler(sl_sid_app_msg_t *msg)
 }
 
 sl_sid_app_msg_st_t sl_sid_app_msg_dev_mgmt_rst_dev_prepare_send(
-  sl_sid_app_msg_dev_mgmt_rst_dev_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg)
+  sl_sid_app_msg_dev_mgmt_rst_dev_ctx_t *ctx, struct sid_msg *send_sid_msg)
 {
   SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx);
 
@@ -101,7 +107,7 @@ sl_sid_app_msg_st_t sl_sid_app_msg_dev_mgmt_rst_dev_prepare_send(
 }
 
 sl_sid_app_msg_st_t sl_sid_app_msg_dev_mgmt_button_press_prepare_send(
-  sl_sid_app_msg_dev_mgmt_button_press_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg)
+  sl_sid_app_msg_dev_mgmt_button_press_ctx_t *ctx, struct sid_msg *send_sid_msg)
 {
   SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx);
 
@@ -115,7 +121,7 @@ sl_sid_app_msg_st_t sl_sid_app_msg_dev_mgmt_button_press_prepare_send(
 }
 
 sl_sid_app_msg_st_t sl_sid_app_msg_dev_mgmt_toggle_led_prepare_send(
-  sl_sid_app_msg_dev_mgmt_toggle_led_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg)
+  sl_sid_app_msg_dev_mgmt_toggle_led_ctx_t *ctx, struct sid_msg *send_sid_msg)
 {
   SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx);
 
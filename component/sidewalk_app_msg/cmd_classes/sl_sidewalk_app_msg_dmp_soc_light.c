@@ -25,7 +25,7 @@
  *** GLOBAL FUNCTIONS
  ******************************************************************************/
 
-sl_sid_app_msg_st_t sli_sid_app_msg_dmp_soc_light_cmd_handler(sl_sid_app_msg_t *msg)
+sl_sid_app_msg_st_t sli_sid_app_msg_dmp_soc_light_cmd_handler(const sl_sid_app_msg_view_t *msg)
 {
   sl_sid_app_msg_st_t status = SL_SID_APP_MSG_ERR_ST_SUCCESS;
 
@@ -67,7 +67,7 @@ sl_sid_app_msg_st_t sli_sid_app_msg_dmp_soc_light_cmd_handler(sl_sid_app_msg_t *
 }
 
 sl_sid_app_msg_st_t sl_sid_app_msg_dmp_soc_light_ble_start_stop_prepare_send(
-  sl_sid_app_msg_dmp_soc_light_ble_start_stop_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg)
+  sl_sid_app_msg_dmp_soc_light_ble_start_stop_ctx_t *ctx, struct sid_msg *send_sid_msg)
 {
   SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx);
 
@@ -81,7 +81,7 @@ sl_sid_app_msg_st_t sl_sid_app_msg_dmp_soc_light_ble_start_stop_prepare_send(
 }
 
 sl_sid_app_msg_st_t sl_sid_app_msg_dmp_soc_light_update_counter_prepare_send(
-  sl_sid_app_msg_dmp_soc_light_update_counter_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg)
+  sl_sid_app_msg_dmp_soc_light_update_counter_ctx_t *ctx, struct sid_msg *send_sid_msg)
 {
   SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx);
 
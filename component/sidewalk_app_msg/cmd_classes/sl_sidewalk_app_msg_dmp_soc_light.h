@@ -82,43 +82,43 @@ typedef struct {
  *** PUBLIC FUNCTIONS
  ******************************************************************************/
 
-sl_sid_app_msg_st_t sli_sid_app_msg_dmp_soc_light_cmd_handler(sl_sid_app_msg_t *msg);
+sl_sid_app_msg_st_t sli_sid_app_msg_dmp_soc_light_cmd_handler(const sl_sid_app_msg_view_t *msg);
 
 /***************************************************************************//**
  * @brief
  *   Prepares corresponding application message to be sent.
  * 
  * @note
- *   Application has to declare the application message and pass its reference
- *   to the function. Allocated memory of the declared message will be used for
- *   serialization.
+ *   Application has to supply the TX buffer in send_sid_msg (data and size).
+ *   The message is encoded directly into it, SL_SID_APP_MSG_TX_BUF_SIZE(ctx)
+ *   gives the required size.
  *
  * @param[in] ctx Related application message context
- * @param[out] send_app_msg Application message to be sent
+ * @param[in,out] send_sid_msg Sidewalk message to be sent
  * 
  * @return
  *   Status code
  ******************************************************************************/
 sl_sid_app_msg_st_t sl_sid_app_msg_dmp_soc_light_ble_start_stop_prepare_send(
-  sl_sid_app_msg_dmp_soc_light_ble_start_stop_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg);
+  sl_sid_app_msg_dmp_soc_light_ble_start_stop_ctx_t *ctx, struct sid_msg *send_sid_msg);
 
 /***************************************************************************//**
  * @brief
  *   Prepares corresponding application message to be sent.
  * 
  * @note
- *   Application has to declare the application message and pass its reference
- *   to the function. Allocated memory of the declared message will be used for
- *   serialization.
+ *   Application has to supply the TX buffer in send_sid_msg (data and size).
+ *   The message is encoded directly into it, SL_SID_APP_MSG_TX_BUF_SIZE(ctx)
+ *   gives the required size.
  *
  * @param[in] ctx Related application message context
- * @param[out] send_app_msg Application message to be sent
+ * @param[in,out] send_sid_msg Sidewalk message to be sent
  * 
  * @return
  *   Status code
  ******************************************************************************/
 sl_sid_app_msg_st_t sl_sid_app_msg_dmp_soc_light_update_counter_prepare_send(
-  sl_sid_app_msg_dmp_soc_light_update_counter_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg);
+  sl_sid_app_msg_dmp_soc_light_update_counter_ctx_t *ctx, struct sid_msg *send_sid_msg);
 
 /***************************************************************************//**
  * @brief
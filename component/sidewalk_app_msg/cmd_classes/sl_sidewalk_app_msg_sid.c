@@ -25,7 +25,7 @@
  *** GLOBAL FUNCTIONS
  ******************************************************************************/
 
-sl_sid_app_msg_st_t sli_sid_app_msg_sid_cmd_handler(sl_sid_app_msg_t *msg)
+sl_sid_app_msg_st_t sli_sid_app_msg_sid_cmd_handler(const sl_sid_app_msg_view_t *msg)
 {
   sl_sid_app_msg_st_t status = SL_SID_APP_MSG_ERR_ST_SUCCESS;
 
@@ -36,8 +36,10 @@ sl_sid_app_msg_st_t sli_sid_app_msg_sid_cmd_handler(sl_sid_app_msg_t *msg)
           return SL_SID_APP_MSG_ERR_ST_APP_WRONG_OP;
         }
 
+        SLI_SID_APP_MSG_RETURN_ST_IF_VALUE_SHORT(msg, sli_sid_app_msg_sid_mtu_get_t);
+
         sl_sid_app_msg_sid_mtu_ctx_t ctx = {
-          .param_rcv.link_type = ((sli_sid_app_msg_sid_mtu_get_t *)msg->value)->link_type,
+          .param_rcv.link_type = ((const sli_sid_app_msg_sid_mtu_get_t *)msg->value)->link_type,
           .hdl.operation = msg->tag.op,
           .hdl.sequence = msg->tag.seq
         };
@@ -68,7 +70,7 @@ sl_sid_app_msg_st_t sli_sid_app_msg_sid_cmd_handler(sl_sid_app_msg_t *msg)
 }
 
 sl_sid_app_msg_st_t sl_sid_app_msg_sid_mtu_prepare_send(
-  sl_sid_app_msg_sid_mtu_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg)
+  sl_sid_app_msg_sid_mtu_ctx_t *ctx, struct sid_msg *send_sid_msg)
 {
   SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx);
 
@@ -80,7 +82,7 @@ sl_sid_app_msg_st_t sl_sid_app_msg_sid_mtu_prepare_send(
 }
 
 sl_sid_app_msg_st_t sl_sid_app_msg_sid_time_prepare_send(
-  sl_sid_app_msg_sid_time_ctx_t *ctx, sl_sid_app_msg_t *send_app_msg)
+  sl_sid_app_msg_sid_time_ctx_t *ctx, struct sid_msg *send_sid_msg)
 {
   SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx);
 
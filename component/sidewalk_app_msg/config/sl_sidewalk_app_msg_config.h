@@ -0,0 +1,67 @@
+/***************************************************************************//**
+ * @file
+ * @brief Sidewalk application message configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SIDEWALK_APP_MSG_CONFIG_H
+#define SL_SIDEWALK_APP_MSG_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h> Sidewalk application message transaction configuration
+
+// <o> SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT <1-32>
+// <i> Maximum number of SET/GET requests waiting for their ack/response
+// <i> Default: 4
+// <d> 4
+#ifndef SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT
+#define SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT 4
+#endif
+
+// <o> SL_SID_APP_MSG_TRANSACTION_DEFAULT_TIMEOUT_MS <1-4294967295>
+// <i> Timeout of a request when no timeout is given at start, in ms
+// <i> Default: 60000
+// <d> 60000
+#ifndef SL_SID_APP_MSG_TRANSACTION_DEFAULT_TIMEOUT_MS
+#define SL_SID_APP_MSG_TRANSACTION_DEFAULT_TIMEOUT_MS 60000
+#endif
+
+// <o> SL_SID_APP_MSG_TRANSACTION_HISTORY_SIZE <1-64>
+// <i> Number of completed requests remembered to suppress duplicate
+// <i> responses. Their sequence numbers are not reused while remembered.
+// <i> Default: 8
+// <d> 8
+#ifndef SL_SID_APP_MSG_TRANSACTION_HISTORY_SIZE
+#define SL_SID_APP_MSG_TRANSACTION_HISTORY_SIZE 8
+#endif
+
+// </h>
+
+// <<< end of configuration section >>>
+
+#endif // SL_SIDEWALK_APP_MSG_CONFIG_H
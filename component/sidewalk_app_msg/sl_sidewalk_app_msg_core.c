@@ -23,15 +23,14 @@
 #include "sl_sidewalk_app_msg_dev_mgmt.h"
 #include "sl_sidewalk_app_msg_dmp_soc_light.h"
 #include "sl_sidewalk_app_msg_sid.h"
+#include "sl_sidewalk_app_msg_transaction.h"
 
 /*******************************************************************************
  *** STATIC FUNCTION PROTOTYPES
  ******************************************************************************/
 
-static sl_sid_app_msg_st_t serialize(sl_sid_app_msg_t *msg, uint8_t **pkt, uint16_t *pkt_len);
-static sl_sid_app_msg_st_t deserialize(sl_sid_app_msg_t **msg, uint8_t *pkt, uint16_t pkt_len);
-static sl_sid_app_msg_st_t validate(sl_sid_app_msg_t *msg);
-static sl_sid_app_msg_st_t receive(sl_sid_app_msg_t **rcvd_app_msg, const struct sid_msg *rcvd_sid_msg);
+static sl_sid_app_msg_st_t validate(const sl_sid_app_msg_tag_t *tag);
+static sl_sid_app_msg_st_t receive(sl_sid_app_msg_view_t *rcvd_app_msg, const struct sid_msg *rcvd_sid_msg);
 static inline sl_sid_app_msg_st_t sli_sid_app_msg_prepare_op_for_send(
   sl_sid_app_msg_op_t op_rcv, sl_sid_app_msg_op_t *op_send);
 
@@ -41,21 +40,26 @@ static inline sl_sid_app_msg_st_t sli_sid_app_msg_prepare_op_for_send(
 
 sl_sid_app_msg_st_t sl_sid_app_msg_handler(const struct sid_msg *rcvd_sid_msg)
 {
-  sl_sid_app_msg_t *rcvd_app_msg;
+  sl_sid_app_msg_view_t rcvd_app_msg;
 
   SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(receive(&rcvd_app_msg, rcvd_sid_msg));
 
-  switch (rcvd_app_msg->tag.cmd_cls) {
+  // Acks and responses belong to requests sent by this device
+  if (rcvd_app_msg.tag.op == SL_SID_APP_MSG_OP_ACK || rcvd_app_msg.tag.op == SL_SID_APP_MSG_OP_RESP) {
+    return sli_sid_app_msg_transaction_on_response(&rcvd_app_msg);
+  }
+
+  switch (rcvd_app_msg.tag.cmd_cls) {
     case SLI_SID_APP_MSG_CMD_CLS_DEV_MGMT:
-      SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_dev_mgmt_cmd_handler(rcvd_app_msg));
+      SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_dev_mgmt_cmd_handler(&rcvd_app_msg));
       break;
 
     case SLI_SID_APP_MSG_CMD_CLS_SID:
-      SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_sid_cmd_handler(rcvd_app_msg));
+      SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_sid_cmd_handler(&rcvd_app_msg));
       break;
 
     case SLI_SID_APP_MSG_CMD_CLS_DMP_SOC_LIGHT:
-      SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_dmp_soc_light_cmd_handler(rcvd_app_msg));
+      SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_dmp_soc_light_cmd_handler(&rcvd_app_msg));
       break;
 
     default:
@@ -65,113 +69,134 @@ sl_sid_app_msg_st_t sl_sid_app_msg_handler(const struct sid_msg *rcvd_sid_msg)
   return SL_SID_APP_MSG_ERR_ST_SUCCESS;
 }
 
-sl_sid_app_msg_st_t sl_sid_app_msg_prepare_sid_msg(sl_sid_app_msg_t *app_msg, struct sid_msg *sid_msg)
-{
-  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_2(app_msg, sid_msg);
-
-  SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(validate(app_msg));
-  uint8_t *pkt;
-  uint16_t pkt_len;
-  SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(serialize(app_msg, &pkt, &pkt_len));
-  sid_msg->data = (void *)pkt;
-  sid_msg->size = (size_t)pkt_len;
-
-  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
-}
-
 sl_sid_app_msg_st_t sli_sid_app_msg_prepare_send(
-  sl_sid_app_msg_t *app_msg, uint8_t cmd_cls, uint8_t cmd_id, sl_sid_app_msg_op_t op, uint8_t seq, void *val, uint16_t val_len)
+  struct sid_msg *send_sid_msg, uint8_t cmd_cls, uint8_t cmd_id, sl_sid_app_msg_op_t op, uint8_t seq, const void *val, uint16_t val_len)
 {
-  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_2(app_msg, val);
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_3(send_sid_msg, send_sid_msg->data, val);
 
   sl_sid_app_msg_op_t op_send;
   SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_prepare_op_for_send(op, &op_send));
 
+  sl_sid_app_msg_tag_t tag = {
+    .proto_ver = SLI_SID_APP_MSG_PROTO_VER,
+    .cmd_cls = cmd_cls,
+    .cmd_id = cmd_id,
+    .op = (uint8_t)op_send
+  };
+
   if (op_send == SL_SID_APP_MSG_OP_NTFY || op_send == SL_SID_APP_MSG_OP_SET || op_send == SL_SID_APP_MSG_OP_GET) {
     uint8_t seq_gen;
     SLI_SID_APP_MSG_GENERATE_SEQ_NO(&seq_gen, sizeof(uint8_t));
-    app_msg->tag.seq = seq_gen;
+    tag.seq = seq_gen & ((1 << SLI_SID_APP_MSG_SEQ_BITS) - 1);
   } else if (op_send == SL_SID_APP_MSG_OP_ACK || op_send == SL_SID_APP_MSG_OP_RESP) {
-    app_msg->tag.seq = seq;
+    tag.seq = seq;
   } else {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_OP;
   }
-  app_msg->tag.proto_ver = SLI_SID_APP_MSG_PROTO_VER;
-  app_msg->tag.cmd_cls = cmd_cls;
-  app_msg->tag.cmd_id = cmd_id;
-  app_msg->tag.op = op_send;
-  app_msg->length = val_len;
-  memcpy((void *)app_msg->value, (const void *)val, app_msg->length);
 
-  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+  return sli_sid_app_msg_encode(send_sid_msg, &tag, val, val_len);
 }
 
-/*******************************************************************************
- *** STATIC FUNCTIONS
- ******************************************************************************/
-static sl_sid_app_msg_st_t serialize(sl_sid_app_msg_t *msg, uint8_t **pkt, uint16_t *pkt_len)
+sl_sid_app_msg_st_t sli_sid_app_msg_encode(
+  struct sid_msg *send_sid_msg, const sl_sid_app_msg_tag_t *tag, const void *val, uint16_t val_len)
 {
-  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_3(msg, pkt, pkt_len);
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_3(send_sid_msg, send_sid_msg->data, tag);
 
-  *pkt = (uint8_t *)&msg[0];
-  *pkt_len = msg->length + SLI_SID_APP_MSG_HEADER_LEN_BYTES;
+  if (val_len > 0 && val == NULL) {
+    return SL_SID_APP_MSG_ERR_ST_APP_INVALID_IN_PARAM;
+  }
 
-  if (*pkt_len > SLI_SID_APP_MSG_MAX_MTU_SIZE) {
+  size_t pkt_len = (size_t)val_len + SLI_SID_APP_MSG_HEADER_LEN_BYTES;
+  if (pkt_len > SLI_SID_APP_MSG_MAX_MTU_SIZE || pkt_len > send_sid_msg->size) {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_LEN;
   }
 
+  uint8_t *pkt = (uint8_t *)send_sid_msg->data;
+  SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_encode_header(tag, (uint8_t)val_len, pkt));
+  if (val_len > 0) {
+    memcpy(&pkt[SLI_SID_APP_MSG_HEADER_LEN_BYTES], val, val_len);
+  }
+  send_sid_msg->size = pkt_len;
+
   return SL_SID_APP_MSG_ERR_ST_SUCCESS;
 }
 
-static sl_sid_app_msg_st_t deserialize(sl_sid_app_msg_t **msg, uint8_t *pkt, uint16_t pkt_len)
+sl_sid_app_msg_st_t sli_sid_app_msg_encode_header(const sl_sid_app_msg_tag_t *tag, uint8_t length, uint8_t *buf)
 {
-  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_2(msg, pkt);
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_2(tag, buf);
+  SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(validate(tag));
+
+  uint16_t tag_word = (uint16_t)tag->cmd_id
+                      | ((uint16_t)tag->op << SLI_SID_APP_MSG_CMD_ID_BITS)
+                      | ((uint16_t)tag->seq << (SLI_SID_APP_MSG_CMD_ID_BITS + SLI_SID_APP_MSG_OP_BITS));
+
+  buf[0] = (uint8_t)(tag->proto_ver | (tag->cmd_cls << SLI_SID_APP_MSG_PROTO_VER_BITS));
+  buf[1] = (uint8_t)(tag_word & 0xFF);
+  buf[2] = (uint8_t)(tag_word >> CHAR_BIT);
+  buf[3] = length;
+
+  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+}
 
-  *msg = (sl_sid_app_msg_t *)&pkt[0];
+sl_sid_app_msg_st_t sli_sid_app_msg_decode(sl_sid_app_msg_view_t *view, const uint8_t *pkt, size_t pkt_len)
+{
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_2(view, pkt);
 
-  if ((pkt_len > SLI_SID_APP_MSG_MAX_MTU_SIZE) ||
-      (pkt_len != ((*msg)->length + SLI_SID_APP_MSG_HEADER_LEN_BYTES))) {
+  if ((pkt_len < SLI_SID_APP_MSG_HEADER_LEN_BYTES) ||
+      (pkt_len > SLI_SID_APP_MSG_MAX_MTU_SIZE) ||
+      (pkt_len != ((size_t)pkt[3] + SLI_SID_APP_MSG_HEADER_LEN_BYTES))) {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_LEN;
   }
 
-  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+  uint16_t tag_word = (uint16_t)pkt[1] | ((uint16_t)pkt[2] << CHAR_BIT);
+
+  view->tag.proto_ver = pkt[0] & ((1 << SLI_SID_APP_MSG_PROTO_VER_BITS) - 1);
+  view->tag.cmd_cls = pkt[0] >> SLI_SID_APP_MSG_PROTO_VER_BITS;
+  view->tag.cmd_id = tag_word & ((1 << SLI_SID_APP_MSG_CMD_ID_BITS) - 1);
+  view->tag.op = (tag_word >> SLI_SID_APP_MSG_CMD_ID_BITS) & ((1 << SLI_SID_APP_MSG_OP_BITS) - 1);
+  view->tag.seq = tag_word >> (SLI_SID_APP_MSG_CMD_ID_BITS + SLI_SID_APP_MSG_OP_BITS);
+  view->length = pkt[3];
+  view->value = &pkt[SLI_SID_APP_MSG_HEADER_LEN_BYTES];
+
+  return validate(&view->tag);
 }
 
-static sl_sid_app_msg_st_t validate(sl_sid_app_msg_t *msg)
+/*******************************************************************************
+ *** STATIC FUNCTIONS
+ ******************************************************************************/
+
+static sl_sid_app_msg_st_t validate(const sl_sid_app_msg_tag_t *tag)
 {
-  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_1(msg);
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_1(tag);
 
-  if (msg->tag.proto_ver != SLI_SID_APP_MSG_PROTO_VER) {
+  if (tag->proto_ver != SLI_SID_APP_MSG_PROTO_VER) {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_PROTO_VER;
   }
 
-  if (msg->tag.cmd_cls >= (1 << SLI_SID_APP_MSG_CMD_CLS_BITS)) {
+  if (tag->cmd_cls >= (1 << SLI_SID_APP_MSG_CMD_CLS_BITS)) {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_CMD_CLS;
   }
 
-  if (msg->tag.cmd_id >= (1 << SLI_SID_APP_MSG_CMD_ID_BITS)) {
+  if (tag->cmd_id >= (1 << SLI_SID_APP_MSG_CMD_ID_BITS)) {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_CMD_ID;
   }
 
-  if (msg->tag.op >= (1 << SLI_SID_APP_MSG_OP_BITS)) {
+  if (tag->op >= (1 << SLI_SID_APP_MSG_OP_BITS)) {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_OP;
   }
 
-  if (msg->tag.seq >= (1 << SLI_SID_APP_MSG_SEQ_BITS)) {
+  if (tag->seq >= (1 << SLI_SID_APP_MSG_SEQ_BITS)) {
     return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_SEQ;
   }
 
   return SL_SID_APP_MSG_ERR_ST_SUCCESS;
 }
 
-static sl_sid_app_msg_st_t receive(sl_sid_app_msg_t **app_msg, const struct sid_msg *sid_msg)
+static sl_sid_app_msg_st_t receive(sl_sid_app_msg_view_t *app_msg, const struct sid_msg *sid_msg)
 {
   SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_2(app_msg, sid_msg);
 
-  SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(deserialize(app_msg, (uint8_t *)sid_msg->data, (uint16_t)sid_msg->size));
-  SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(validate(*app_msg));
-
-  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+  return sli_sid_app_msg_decode(app_msg, (const uint8_t *)sid_msg->data, sid_msg->size);
 }
 
 static inline sl_sid_app_msg_st_t sli_sid_app_msg_prepare_op_for_send(
@@ -61,6 +61,12 @@
  *** MACROS AND TYPEDEFS
  ******************************************************************************/
 
+// TX buffer size needed to send any message of the given command context
+#define SL_SID_APP_MSG_TX_BUF_SIZE(ctx)                               \
+  (SLI_SID_APP_MSG_HEADER_LEN_BYTES                                   \
+   + ((sizeof((ctx).param_ack) > sizeof((ctx).param_send))            \
+      ? sizeof((ctx).param_ack) : sizeof((ctx).param_send)))
+
 #define SLI_SID_APP_MSG_GENERATE_SEQ_NO(seq, seq_size)          \
     if (sid_pal_crypto_rand(seq, seq_size) != SID_ERROR_NONE) { \
       *seq = 0;                                                 \
@@ -86,24 +92,29 @@
 
 #define SLI_SID_APP_MSG_PREP_SEND_ACK_FUNC(cmd_cls, cmd_id) \
   sli_sid_app_msg_prepare_send(                             \
-    send_app_msg,                                           \
+    send_sid_msg,                                           \
     cmd_cls,                                                \
     cmd_id,                                                 \
     ctx->hdl.operation,                                     \
     ctx->hdl.sequence,                                      \
-    (void *)&ctx->param_ack,                                \
+    (const void *)&ctx->param_ack,                          \
     sizeof(ctx->param_ack))
 
 #define SLI_SID_APP_MSG_PREP_SEND_PARAM_FUNC(cmd_cls, cmd_id) \
   sli_sid_app_msg_prepare_send(                               \
-    send_app_msg,                                             \
+    send_sid_msg,                                             \
     cmd_cls,                                                  \
     cmd_id,                                                   \
     ctx->hdl.operation,                                       \
     ctx->hdl.sequence,                                        \
-    (void *)&ctx->param_send,                                 \
+    (const void *)&ctx->param_send,                           \
     sizeof(ctx->param_send))
 
+#define SLI_SID_APP_MSG_RETURN_ST_IF_VALUE_SHORT(msg, type) \
+  if ((msg)->length < sizeof(type)) {                       \
+    return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_LEN;             \
+  }
+
 #define SLI_SID_APP_MSG_CLR_PROCESSING_FLAG(ctx)  \
   ctx->hdl.processing = false
 
@@ -120,7 +131,14 @@ typedef enum {
   // application errors
   SL_SID_APP_MSG_ERR_ST_APP_INVALID_IN_PARAM,
   SL_SID_APP_MSG_ERR_ST_APP_WRONG_OP,
-  SL_SID_APP_MSG_ERR_ST_APP_CMD_HDL_NOT_IMPL
+  SL_SID_APP_MSG_ERR_ST_APP_CMD_HDL_NOT_IMPL,
+  // transaction errors
+  SL_SID_APP_MSG_ERR_ST_TRANS_NO_FREE_SLOT,
+  SL_SID_APP_MSG_ERR_ST_TRANS_NO_FREE_SEQ,
+  SL_SID_APP_MSG_ERR_ST_TRANS_TIMEOUT,
+  SL_SID_APP_MSG_ERR_ST_TRANS_DUPLICATE_RESP,
+  SL_SID_APP_MSG_ERR_ST_TRANS_UNEXPECTED_RESP,
+  SL_SID_APP_MSG_ERR_ST_TRANS_TIMER
 } sl_sid_app_msg_st_t ;
 
 // Operations (encoded in 2 bits)
@@ -149,22 +167,29 @@ typedef enum {
   SL_SID_APP_MSG_OP_ACK
 } sl_sid_app_msg_op_t;
 
-// TLV message structure
+// TLV message tag, decoded from/encoded to the packed header on the wire:
+//    byte 0:   proto_ver (LSB SLI_SID_APP_MSG_PROTO_VER_BITS bits)
+//              cmd_cls   (MSB SLI_SID_APP_MSG_CMD_CLS_BITS bits)
+//    byte 1-2: little endian, cmd_id (LSB SLI_SID_APP_MSG_CMD_ID_BITS bits)
+//              op (next SLI_SID_APP_MSG_OP_BITS bits)
+//              seq (MSB SLI_SID_APP_MSG_SEQ_BITS bits)
+//    byte 3:   length
+//    byte 4-n: value
+typedef struct {
+  uint8_t proto_ver;
+  uint8_t cmd_cls;
+  uint8_t cmd_id;
+  uint8_t op;         // sl_sid_app_msg_op_t
+  uint8_t seq;
+} sl_sid_app_msg_tag_t;
+
+// Read-only view of a received TLV message, value points into the received
+// sidewalk message and is only valid until the receive callback returns
 typedef struct {
-  struct {
-    // byte 0
-    uint8_t proto_ver: SLI_SID_APP_MSG_PROTO_VER_BITS; // LSB  SLI_SID_APP_MSG_PROTO_VER_BITS  bits
-    uint8_t cmd_cls: SLI_SID_APP_MSG_CMD_CLS_BITS;     // MSB  SLI_SID_APP_MSG_CMD_CLS_BITS    bits
-    // byte 1-2
-    uint16_t cmd_id: SLI_SID_APP_MSG_CMD_ID_BITS;      // LSB  SLI_SID_APP_MSG_CMD_ID_BITS     bits
-    uint16_t op: SLI_SID_APP_MSG_OP_BITS;              // LSB  SLI_SID_APP_MSG_OP_BITS         bits
-    uint16_t seq: SLI_SID_APP_MSG_SEQ_BITS;            // MSB  SLI_SID_APP_MSG_SEQ_BITS        bits
-  } SL_ATTRIBUTE_PACKED tag;
-  // byte 3
+  sl_sid_app_msg_tag_t tag;
   uint8_t length;
-  // byte 4-n
-  uint8_t value[SLI_SID_APP_MSG_MSG_LEN];
-} SL_ATTRIBUTE_PACKED sl_sid_app_msg_t;
+  const uint8_t *value;
+} sl_sid_app_msg_view_t;
 
 // Message handler
 typedef struct {
@@ -183,24 +208,70 @@ typedef struct {
  *** PUBLIC FUNCTIONS
  ******************************************************************************/
 
+/***************************************************************************//**
+ * @brief
+ *   Encodes an application message directly into the TX buffer of a sidewalk
+ *   message.
+ *
+ * @param[in,out] send_sid_msg Sidewalk message to be sent. data must point to
+ *                             the caller supplied TX buffer and size must hold
+ *                             its capacity. On success size is set to the
+ *                             length of the encoded message.
+ * @param[in] cmd_cls Command class
+ * @param[in] cmd_id Command ID
+ * @param[in] op Operation of the received request (or NTFY)
+ * @param[in] seq Sequence number of the received request
+ * @param[in] val Value to be sent
+ * @param[in] val_len Length of the value
+ *
+ * @return
+ *   Status code
+ ******************************************************************************/
 sl_sid_app_msg_st_t sli_sid_app_msg_prepare_send(
-  sl_sid_app_msg_t *app_msg, uint8_t cmd_cls, uint8_t cmd_id, sl_sid_app_msg_op_t op, uint8_t seq, void *val, uint16_t val_len);
+  struct sid_msg *send_sid_msg, uint8_t cmd_cls, uint8_t cmd_id, sl_sid_app_msg_op_t op, uint8_t seq, const void *val, uint16_t val_len);
 
 /***************************************************************************//**
  * @brief
- *   Converts the application message to be sent over the sidewalk network into
- *   a sidewalk message.
- * 
- *   This is an application level API that must be called prior to each
- *   sidewalk message transmission.
+ *   Encodes an application message with the given tag directly into the TX
+ *   buffer of a sidewalk message.
+ *
+ * @param[in,out] send_sid_msg Sidewalk message to be sent, see
+ *                             sli_sid_app_msg_prepare_send()
+ * @param[in] tag Message tag
+ * @param[in] val Value to be sent, can be NULL if val_len is 0
+ * @param[in] val_len Length of the value
+ *
+ * @return
+ *   Status code
+ ******************************************************************************/
+sl_sid_app_msg_st_t sli_sid_app_msg_encode(
+  struct sid_msg *send_sid_msg, const sl_sid_app_msg_tag_t *tag, const void *val, uint16_t val_len);
+
+/***************************************************************************//**
+ * @brief
+ *   Encodes the packed TLV header.
+ *
+ * @param[in] tag Message tag
+ * @param[in] length Length of the value following the header
+ * @param[out] buf Output buffer of at least SLI_SID_APP_MSG_HEADER_LEN_BYTES
+ *
+ * @return
+ *   Status code
+ ******************************************************************************/
+sl_sid_app_msg_st_t sli_sid_app_msg_encode_header(const sl_sid_app_msg_tag_t *tag, uint8_t length, uint8_t *buf);
+
+/***************************************************************************//**
+ * @brief
+ *   Decodes and validates a received TLV message without copying it.
  *
- * @param[in] app_msg Application message
- * @param[out] sid_msg Sidewalk message to be sent
+ * @param[out] view Message view, its value points into pkt
+ * @param[in] pkt Received message
+ * @param[in] pkt_len Length of the received message
  *
  * @return
  *   Status code
  ******************************************************************************/
-sl_sid_app_msg_st_t sl_sid_app_msg_prepare_sid_msg(sl_sid_app_msg_t *app_msg, struct sid_msg *sid_msg);
+sl_sid_app_msg_st_t sli_sid_app_msg_decode(sl_sid_app_msg_view_t *view, const uint8_t *pkt, size_t pkt_len);
 
 /***************************************************************************//**
  * @brief
@@ -0,0 +1,391 @@
+/***************************************************************************//**
+ * @file sl_sidewalk_app_msg_transaction.c
+ * @brief sidewalk application message transaction layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+
+#include "sl_sidewalk_app_msg_transaction.h"
+#include "sid_pal_critical_region_ifc.h"
+#include "sid_pal_timer_ifc.h"
+#include "sid_pal_uptime_ifc.h"
+#include "sid_time_ops.h"
+
+/*******************************************************************************
+ *** MACROS AND TYPEDEFS
+ ******************************************************************************/
+
+#define SLI_SID_APP_MSG_SEQ_COUNT               (1 << SLI_SID_APP_MSG_SEQ_BITS)
+#define SLI_SID_APP_MSG_CMD_CLS_COUNT           (1 << SLI_SID_APP_MSG_CMD_CLS_BITS)
+
+// The timer argument carries the slot index and the generation it was armed for
+#define SLI_SID_APP_MSG_TIMER_ARG(index, generation)  ((void *)(uintptr_t)(((uint32_t)(generation) << 8) | (index)))
+#define SLI_SID_APP_MSG_TIMER_ARG_INDEX(arg)          ((uint8_t)((uintptr_t)(arg) & 0xFF))
+#define SLI_SID_APP_MSG_TIMER_ARG_GENERATION(arg)     ((uint16_t)((uintptr_t)(arg) >> 8))
+
+// In-flight request
+typedef struct {
+  bool in_use;
+  uint16_t generation;  // incremented on every reserve
+  uint8_t cmd_cls;
+  uint8_t cmd_id;
+  uint8_t op;
+  uint8_t seq;
+  uint32_t start_ms;
+  sl_sid_app_msg_transaction_cb_t cb;
+  void *context;
+  sid_pal_timer_t timer;
+} sli_sid_app_msg_transaction_t;
+
+// Completed request, kept to detect duplicate responses
+typedef struct {
+  bool valid;
+  uint8_t cmd_cls;
+  uint8_t cmd_id;
+  uint8_t op;
+  uint8_t seq;
+} sli_sid_app_msg_transaction_history_t;
+
+/*******************************************************************************
+ *** STATIC FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+static void on_timeout(void *arg, sid_pal_timer_t *originator);
+static uint32_t now_ms(void);
+static bool is_seq_used(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq);
+static sli_sid_app_msg_transaction_t *reserve(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq_start);
+static sli_sid_app_msg_transaction_t *find(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq);
+static void release(sli_sid_app_msg_transaction_t *transaction, bool remember);
+static bool is_in_history(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq);
+
+/*******************************************************************************
+ *** STATIC VARIABLES
+ ******************************************************************************/
+
+static sli_sid_app_msg_transaction_t transactions[SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT];
+static sli_sid_app_msg_transaction_history_t history[SL_SID_APP_MSG_TRANSACTION_HISTORY_SIZE];
+static uint8_t history_next;
+static sl_sid_app_msg_transaction_stats_t stats[SLI_SID_APP_MSG_CMD_CLS_COUNT];
+
+/*******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+sl_sid_app_msg_st_t sl_sid_app_msg_transaction_start(struct sid_msg *send_sid_msg,
+                                                     uint8_t cmd_cls,
+                                                     uint8_t cmd_id,
+                                                     sl_sid_app_msg_op_t op,
+                                                     const void *val,
+                                                     uint16_t val_len,
+                                                     uint32_t timeout_ms,
+                                                     sl_sid_app_msg_transaction_cb_t cb,
+                                                     void *context)
+{
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_1(send_sid_msg);
+
+  if (op != SL_SID_APP_MSG_OP_SET && op != SL_SID_APP_MSG_OP_GET) {
+    return SL_SID_APP_MSG_ERR_ST_APP_WRONG_OP;
+  }
+
+  if (cmd_cls >= SLI_SID_APP_MSG_CMD_CLS_COUNT) {
+    return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_CMD_CLS;
+  }
+
+  if (timeout_ms == 0) {
+    timeout_ms = SL_SID_APP_MSG_TRANSACTION_DEFAULT_TIMEOUT_MS;
+  }
+
+  uint8_t seq_start;
+  SLI_SID_APP_MSG_GENERATE_SEQ_NO(&seq_start, sizeof(uint8_t));
+
+  sid_pal_enter_critical_region();
+  bool slot_free = false;
+  for (uint8_t i = 0; i < SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT; i++) {
+    slot_free |= !transactions[i].in_use;
+  }
+  sli_sid_app_msg_transaction_t *transaction = reserve(cmd_cls, cmd_id, (uint8_t)op, seq_start);
+  sid_pal_exit_critical_region();
+
+  if (transaction == NULL) {
+    return slot_free ? SL_SID_APP_MSG_ERR_ST_TRANS_NO_FREE_SEQ : SL_SID_APP_MSG_ERR_ST_TRANS_NO_FREE_SLOT;
+  }
+
+  sl_sid_app_msg_tag_t tag = {
+    .proto_ver = SLI_SID_APP_MSG_PROTO_VER,
+    .cmd_cls = cmd_cls,
+    .cmd_id = cmd_id,
+    .op = (uint8_t)op,
+    .seq = transaction->seq
+  };
+  sl_sid_app_msg_st_t status = sli_sid_app_msg_encode(send_sid_msg, &tag, val, val_len);
+  if (SLI_SID_APP_MSG_IS_FAILED(status)) {
+    sid_pal_enter_critical_region();
+    release(transaction, false);
+    sid_pal_exit_critical_region();
+    return status;
+  }
+
+  transaction->cb = cb;
+  transaction->context = context;
+  transaction->start_ms = now_ms();
+
+  struct sid_timespec when;
+  sid_pal_uptime_now(&when);
+  sid_add_ms_to_timespec(&when, timeout_ms);
+  if (sid_pal_timer_arm(&transaction->timer, SID_PAL_TIMER_PRIO_CLASS_LOWPOWER, &when, NULL) != SID_ERROR_NONE) {
+    sid_pal_enter_critical_region();
+    release(transaction, false);
+    sid_pal_exit_critical_region();
+    return SL_SID_APP_MSG_ERR_ST_TRANS_TIMER;
+  }
+
+  sid_pal_enter_critical_region();
+  stats[cmd_cls].started++;
+  sid_pal_exit_critical_region();
+
+  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+}
+
+sl_sid_app_msg_st_t sl_sid_app_msg_transaction_abort(const struct sid_msg *send_sid_msg)
+{
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_2(send_sid_msg, send_sid_msg->data);
+
+  sl_sid_app_msg_view_t req;
+  SLI_SID_APP_MSG_RETURN_ST_IF_FAILED(sli_sid_app_msg_decode(&req, (const uint8_t *)send_sid_msg->data, send_sid_msg->size));
+
+  sl_sid_app_msg_st_t status = SL_SID_APP_MSG_ERR_ST_APP_INVALID_IN_PARAM;
+
+  sid_pal_enter_critical_region();
+  sli_sid_app_msg_transaction_t *transaction = find(req.tag.cmd_cls, req.tag.cmd_id, req.tag.op, req.tag.seq);
+  if (transaction != NULL) {
+    (void)sid_pal_timer_cancel(&transaction->timer);
+    release(transaction, false);
+    stats[req.tag.cmd_cls].aborted++;
+    status = SL_SID_APP_MSG_ERR_ST_SUCCESS;
+  }
+  sid_pal_exit_critical_region();
+
+  return status;
+}
+
+uint8_t sl_sid_app_msg_transaction_get_in_flight_count(void)
+{
+  uint8_t count = 0;
+
+  for (uint8_t i = 0; i < SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT; i++) {
+    if (transactions[i].in_use) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+sl_sid_app_msg_st_t sl_sid_app_msg_transaction_get_stats(uint8_t cmd_cls, sl_sid_app_msg_transaction_stats_t *cls_stats)
+{
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_1(cls_stats);
+
+  if (cmd_cls >= SLI_SID_APP_MSG_CMD_CLS_COUNT) {
+    return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_CMD_CLS;
+  }
+
+  sid_pal_enter_critical_region();
+  *cls_stats = stats[cmd_cls];
+  sid_pal_exit_critical_region();
+
+  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+}
+
+void sl_sid_app_msg_transaction_reset_stats(void)
+{
+  sid_pal_enter_critical_region();
+  memset(stats, 0, sizeof(stats));
+  sid_pal_exit_critical_region();
+}
+
+sl_sid_app_msg_st_t sli_sid_app_msg_transaction_on_response(const sl_sid_app_msg_view_t *rsp)
+{
+  SLI_SID_APP_MSG_RETURN_ST_IF_PARAM_INVALID_1(rsp);
+
+  // Ack answers a set, response answers a get
+  uint8_t req_op = (rsp->tag.op == SL_SID_APP_MSG_OP_ACK) ? SL_SID_APP_MSG_OP_SET : SL_SID_APP_MSG_OP_GET;
+  sl_sid_app_msg_transaction_stats_t *cls_stats = &stats[rsp->tag.cmd_cls];
+  sl_sid_app_msg_transaction_cb_t cb = NULL;
+  void *context = NULL;
+
+  sid_pal_enter_critical_region();
+  sli_sid_app_msg_transaction_t *transaction = find(rsp->tag.cmd_cls, rsp->tag.cmd_id, req_op, rsp->tag.seq);
+  if (transaction == NULL) {
+    bool duplicate = is_in_history(rsp->tag.cmd_cls, rsp->tag.cmd_id, req_op, rsp->tag.seq);
+    if (duplicate) {
+      cls_stats->duplicate_resp++;
+    } else {
+      cls_stats->unexpected_resp++;
+    }
+    sid_pal_exit_critical_region();
+    return duplicate ? SL_SID_APP_MSG_ERR_ST_TRANS_DUPLICATE_RESP : SL_SID_APP_MSG_ERR_ST_TRANS_UNEXPECTED_RESP;
+  }
+
+  (void)sid_pal_timer_cancel(&transaction->timer);
+
+  uint32_t latency_ms = now_ms() - transaction->start_ms;
+  if (cls_stats->completed == 0 || latency_ms < cls_stats->latency_min_ms) {
+    cls_stats->latency_min_ms = latency_ms;
+  }
+  if (latency_ms > cls_stats->latency_max_ms) {
+    cls_stats->latency_max_ms = latency_ms;
+  }
+  cls_stats->latency_sum_ms += latency_ms;
+  cls_stats->completed++;
+
+  cb = transaction->cb;
+  context = transaction->context;
+  release(transaction, true);
+  sid_pal_exit_critical_region();
+
+  if (cb != NULL) {
+    cb(SL_SID_APP_MSG_ERR_ST_SUCCESS, rsp, context);
+  }
+
+  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+}
+
+/*******************************************************************************
+ *** STATIC FUNCTIONS
+ ******************************************************************************/
+
+static void on_timeout(void *arg, sid_pal_timer_t *originator)
+{
+  (void)originator;
+  sli_sid_app_msg_transaction_t *transaction = &transactions[SLI_SID_APP_MSG_TIMER_ARG_INDEX(arg)];
+  sl_sid_app_msg_transaction_cb_t cb = NULL;
+  void *context = NULL;
+
+  sid_pal_enter_critical_region();
+  if (!transaction->in_use || transaction->generation != SLI_SID_APP_MSG_TIMER_ARG_GENERATION(arg)) {
+    // Completed, aborted or the slot was reused meanwhile
+    sid_pal_exit_critical_region();
+    return;
+  }
+  stats[transaction->cmd_cls].timed_out++;
+  cb = transaction->cb;
+  context = transaction->context;
+  // A late response to a timed out request is reported as duplicate
+  release(transaction, true);
+  sid_pal_exit_critical_region();
+
+  if (cb != NULL) {
+    cb(SL_SID_APP_MSG_ERR_ST_TRANS_TIMEOUT, NULL, context);
+  }
+}
+
+static uint32_t now_ms(void)
+{
+  struct sid_timespec now;
+
+  sid_pal_uptime_now(&now);
+  return sid_timespec_to_ms(&now);
+}
+
+static bool is_seq_used(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq)
+{
+  // Responses are matched on the op as well, a set and a get of the same
+  // command may share a sequence number
+  return find(cmd_cls, cmd_id, op, seq) != NULL || is_in_history(cmd_cls, cmd_id, op, seq);
+}
+
+static sli_sid_app_msg_transaction_t *reserve(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq_start)
+{
+  sli_sid_app_msg_transaction_t *transaction = NULL;
+
+  for (uint8_t i = 0; i < SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT; i++) {
+    if (!transactions[i].in_use) {
+      transaction = &transactions[i];
+      break;
+    }
+  }
+
+  if (transaction == NULL) {
+    return NULL;
+  }
+
+  for (uint8_t i = 0; i < SLI_SID_APP_MSG_SEQ_COUNT; i++) {
+    uint8_t seq = (uint8_t)(seq_start + i) & (SLI_SID_APP_MSG_SEQ_COUNT - 1);
+    if (!is_seq_used(cmd_cls, cmd_id, op, seq)) {
+      uint8_t index = (uint8_t)(transaction - transactions);
+      transaction->in_use = true;
+      transaction->generation++;
+      // A timeout queued for the previous request of this slot is ignored
+      (void)sid_pal_timer_init(&transaction->timer, on_timeout, SLI_SID_APP_MSG_TIMER_ARG(index, transaction->generation));
+      transaction->cmd_cls = cmd_cls;
+      transaction->cmd_id = cmd_id;
+      transaction->op = op;
+      transaction->seq = seq;
+      transaction->cb = NULL;
+      transaction->context = NULL;
+      return transaction;
+    }
+  }
+
+  return NULL;
+}
+
+static sli_sid_app_msg_transaction_t *find(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq)
+{
+  for (uint8_t i = 0; i < SL_SID_APP_MSG_TRANSACTION_MAX_IN_FLIGHT; i++) {
+    if (transactions[i].in_use
+        && transactions[i].cmd_cls == cmd_cls
+        && transactions[i].cmd_id == cmd_id
+        && transactions[i].op == op
+        && transactions[i].seq == seq) {
+      return &transactions[i];
+    }
+  }
+
+  return NULL;
+}
+
+static void release(sli_sid_app_msg_transaction_t *transaction, bool remember)
+{
+  if (remember) {
+    history[history_next].valid = true;
+    history[history_next].cmd_cls = transaction->cmd_cls;
+    history[history_next].cmd_id = transaction->cmd_id;
+    history[history_next].op = transaction->op;
+    history[history_next].seq = transaction->seq;
+    history_next = (history_next + 1) % SL_SID_APP_MSG_TRANSACTION_HISTORY_SIZE;
+  }
+
+  transaction->in_use = false;
+  transaction->cb = NULL;
+  transaction->context = NULL;
+}
+
+static bool is_in_history(uint8_t cmd_cls, uint8_t cmd_id, uint8_t op, uint8_t seq)
+{
+  for (uint8_t i = 0; i < SL_SID_APP_MSG_TRANSACTION_HISTORY_SIZE; i++) {
+    if (history[i].valid
+        && history[i].cmd_cls == cmd_cls
+        && history[i].cmd_id == cmd_id
+        && history[i].op == op
+        && history[i].seq == seq) {
+      return true;
+    }
+  }
+
+  return false;
+}
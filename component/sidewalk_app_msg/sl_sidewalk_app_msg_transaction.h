@@ -0,0 +1,142 @@
+/***************************************************************************//**
+ * @file sl_sidewalk_app_msg_transaction.h
+ * @brief sidewalk application message transaction layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SID_APP_MSG_TRANSACTION_H
+#define SL_SID_APP_MSG_TRANSACTION_H
+
+/*******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+
+#include "sl_sidewalk_app_msg_core.h"
+#include "sl_sidewalk_app_msg_config.h"
+
+/*******************************************************************************
+ *** MACROS AND TYPEDEFS
+ ******************************************************************************/
+
+// Transaction completion callback
+//    * status is SL_SID_APP_MSG_ERR_ST_SUCCESS when the ack/response arrived,
+//      rsp then points to it and is only valid during the callback
+//    * status is SL_SID_APP_MSG_ERR_ST_TRANS_TIMEOUT when no ack/response
+//      arrived in time, rsp is NULL. Called from timer context.
+typedef void (*sl_sid_app_msg_transaction_cb_t)(sl_sid_app_msg_st_t status,
+                                                 const sl_sid_app_msg_view_t *rsp,
+                                                 void *context);
+
+// Per command class transaction statistics
+typedef struct {
+  uint32_t started;
+  uint32_t completed;
+  uint32_t timed_out;
+  uint32_t aborted;
+  uint32_t duplicate_resp;
+  uint32_t unexpected_resp;
+  uint32_t latency_min_ms;
+  uint32_t latency_max_ms;
+  uint64_t latency_sum_ms;  // average latency is latency_sum_ms / completed
+} sl_sid_app_msg_transaction_stats_t;
+
+/*******************************************************************************
+ *** PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @brief
+ *   Encodes a SET or GET request into the TX buffer of a sidewalk message and
+ *   registers it as in-flight.
+ *
+ *   The sequence number is chosen so that it does not collide with any
+ *   in-flight or recently completed request of the same command and op. The
+ *   callback is called once, either with the matching ack/response or on
+ *   timeout.
+ *
+ * @param[in,out] send_sid_msg Sidewalk message to be sent, see
+ *                             sli_sid_app_msg_prepare_send()
+ * @param[in] cmd_cls Command class
+ * @param[in] cmd_id Command ID
+ * @param[in] op SL_SID_APP_MSG_OP_SET or SL_SID_APP_MSG_OP_GET
+ * @param[in] val Value to be sent, can be NULL if val_len is 0
+ * @param[in] val_len Length of the value
+ * @param[in] timeout_ms Timeout in ms, 0 selects
+ *                       SL_SID_APP_MSG_TRANSACTION_DEFAULT_TIMEOUT_MS
+ * @param[in] cb Completion callback
+ * @param[in] context Passed to the completion callback
+ *
+ * @return
+ *   Status code
+ ******************************************************************************/
+sl_sid_app_msg_st_t sl_sid_app_msg_transaction_start(struct sid_msg *send_sid_msg,
+                                                     uint8_t cmd_cls,
+                                                     uint8_t cmd_id,
+                                                     sl_sid_app_msg_op_t op,
+                                                     const void *val,
+                                                     uint16_t val_len,
+                                                     uint32_t timeout_ms,
+                                                     sl_sid_app_msg_transaction_cb_t cb,
+                                                     void *context);
+
+/***************************************************************************//**
+ * @brief
+ *   Drops an in-flight request without calling its callback, e.g. when
+ *   queueing the encoded message to the sidewalk stack failed.
+ *
+ * @param[in] send_sid_msg Sidewalk message returned by
+ *                         sl_sid_app_msg_transaction_start()
+ *
+ * @return
+ *   Status code
+ ******************************************************************************/
+sl_sid_app_msg_st_t sl_sid_app_msg_transaction_abort(const struct sid_msg *send_sid_msg);
+
+/***************************************************************************//**
+ * @brief
+ *   Returns the number of in-flight requests.
+ ******************************************************************************/
+uint8_t sl_sid_app_msg_transaction_get_in_flight_count(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Copies the transaction statistics of a command class.
+ *
+ * @param[in] cmd_cls Command class
+ * @param[out] stats Statistics
+ *
+ * @return
+ *   Status code
+ ******************************************************************************/
+sl_sid_app_msg_st_t sl_sid_app_msg_transaction_get_stats(uint8_t cmd_cls, sl_sid_app_msg_transaction_stats_t *stats);
+
+/***************************************************************************//**
+ * @brief
+ *   Clears the transaction statistics of all command classes.
+ ******************************************************************************/
+void sl_sid_app_msg_transaction_reset_stats(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Matches a received ack/response against the in-flight requests. Called by
+ *   sl_sid_app_msg_handler().
+ *
+ * @param[in] rsp Received ack/response
+ *
+ * @return
+ *   Status code
+ ******************************************************************************/
+sl_sid_app_msg_st_t sli_sid_app_msg_transaction_on_response(const sl_sid_app_msg_view_t *rsp);
+
+#endif  // SL_SID_APP_MSG_TRANSACTION_H
@@ -0,0 +1,150 @@
+/***************************************************************************//**
+ * @file fake_app_msg_platform.c
+ * @brief host stand-in for the PAL and the TLV codec used by the transaction layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+
+#include <stddef.h>
+#include "fake_app_msg_platform.h"
+#include "sid_pal_critical_region_ifc.h"
+#include "sid_pal_crypto_ifc.h"
+#include "sid_pal_uptime_ifc.h"
+#include "sid_time_ops.h"
+
+/*******************************************************************************
+ *** GLOBAL VARIABLES
+ ******************************************************************************/
+
+fake_app_msg_platform_t fake_app_msg_platform;
+
+/*******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+void fake_app_msg_platform_init(void)
+{
+  fake_app_msg_platform.uptime_ms = 0;
+  fake_app_msg_platform.rand_value = 0;
+  fake_app_msg_platform.last_armed_timer = NULL;
+}
+
+void fake_app_msg_platform_fire(sid_pal_timer_t *timer)
+{
+  if (!timer->is_armed) {
+    return;
+  }
+  timer->is_armed = false;
+  timer->callback(timer->callback_arg, timer);
+}
+
+void sid_pal_enter_critical_region()
+{
+}
+
+void sid_pal_exit_critical_region()
+{
+}
+
+sid_error_t sid_pal_crypto_rand(uint8_t *rand, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    rand[i] = fake_app_msg_platform.rand_value;
+  }
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_uptime_now(struct sid_timespec *time)
+{
+  time->tv_sec = fake_app_msg_platform.uptime_ms / 1000;
+  time->tv_nsec = (fake_app_msg_platform.uptime_ms % 1000) * 1000000;
+  return SID_ERROR_NONE;
+}
+
+uint32_t sid_timespec_to_ms(const struct sid_timespec *tm)
+{
+  return (uint32_t)tm->tv_sec * 1000 + tm->tv_nsec / 1000000;
+}
+
+void sid_add_ms_to_timespec(struct sid_timespec *ts, uint32_t ms)
+{
+  uint32_t total_ms = sid_timespec_to_ms(ts) + ms;
+
+  ts->tv_sec = total_ms / 1000;
+  ts->tv_nsec = (total_ms % 1000) * 1000000;
+}
+
+sid_error_t sid_pal_timer_init(sid_pal_timer_t *timer, sid_pal_timer_cb_t event_callback, void *event_callback_arg)
+{
+  timer->callback = event_callback;
+  timer->callback_arg = event_callback_arg;
+  timer->is_armed = false;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_timer_arm(sid_pal_timer_t *timer,
+                              sid_pal_timer_prio_class_t type,
+                              const struct sid_timespec *when,
+                              const struct sid_timespec *period)
+{
+  (void)type;
+  (void)when;
+  (void)period;
+  timer->is_armed = true;
+  fake_app_msg_platform.last_armed_timer = timer;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_timer_cancel(sid_pal_timer_t *timer)
+{
+  timer->is_armed = false;
+  return SID_ERROR_NONE;
+}
+
+sl_sid_app_msg_st_t sli_sid_app_msg_encode(
+  struct sid_msg *send_sid_msg, const sl_sid_app_msg_tag_t *tag, const void *val, uint16_t val_len)
+{
+  (void)val;
+  (void)val_len;
+  if (send_sid_msg->data == NULL || send_sid_msg->size < FAKE_APP_MSG_ENCODED_LEN) {
+    return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_LEN;
+  }
+
+  uint8_t *buf = (uint8_t *)send_sid_msg->data;
+  buf[0] = tag->cmd_cls;
+  buf[1] = tag->cmd_id;
+  buf[2] = tag->op;
+  buf[3] = tag->seq;
+  send_sid_msg->size = FAKE_APP_MSG_ENCODED_LEN;
+  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+}
+
+sl_sid_app_msg_st_t sli_sid_app_msg_decode(sl_sid_app_msg_view_t *view, const uint8_t *pkt, size_t pkt_len)
+{
+  if (pkt_len < FAKE_APP_MSG_ENCODED_LEN) {
+    return SL_SID_APP_MSG_ERR_ST_PKT_WRONG_LEN;
+  }
+
+  view->tag.proto_ver = SLI_SID_APP_MSG_PROTO_VER;
+  view->tag.cmd_cls = pkt[0];
+  view->tag.cmd_id = pkt[1];
+  view->tag.op = pkt[2];
+  view->tag.seq = pkt[3];
+  view->length = 0;
+  view->value = NULL;
+  return SL_SID_APP_MSG_ERR_ST_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/***************************************************************************//**
+ * @file fake_app_msg_platform.h
+ * @brief host stand-in for the PAL and the TLV codec used by the transaction layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef FAKE_APP_MSG_PLATFORM_H
+#define FAKE_APP_MSG_PLATFORM_H
+
+/*******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sl_sidewalk_app_msg_core.h"
+#include "sid_pal_timer_ifc.h"
+
+/*******************************************************************************
+ *** MACROS AND TYPEDEFS
+ ******************************************************************************/
+
+// The fake codec writes cmd_cls, cmd_id, op and seq as one byte each
+#define FAKE_APP_MSG_ENCODED_LEN  (4)
+
+// Uptime is advanced by the tests, the random generator returns rand_value
+typedef struct {
+  uint32_t uptime_ms;
+  uint8_t rand_value;
+  sid_pal_timer_t *last_armed_timer;
+} fake_app_msg_platform_t;
+
+extern fake_app_msg_platform_t fake_app_msg_platform;
+
+/*******************************************************************************
+ *** PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @brief
+ *   Resets the uptime, the random value and the last armed timer.
+ ******************************************************************************/
+void fake_app_msg_platform_init(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Expires an armed timer and calls its callback.
+ *
+ * @param[in] timer Timer to expire
+ ******************************************************************************/
+void fake_app_msg_platform_fire(sid_pal_timer_t *timer);
+
+#endif  // FAKE_APP_MSG_PLATFORM_H
@@ -0,0 +1,43 @@
+/***************************************************************************//**
+ * @file sid_pal_timer_types.h
+ * @brief host stand-in for the sidewalk PAL timer storage type
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SID_PAL_TIMER_TYPES_H
+#define SID_PAL_TIMER_TYPES_H
+
+/*******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <sid_time_types.h>
+
+/*******************************************************************************
+ *** MACROS AND TYPEDEFS
+ ******************************************************************************/
+
+typedef struct sid_pal_timer_impl_t sid_pal_timer_t;
+
+typedef void (*sid_pal_timer_cb_t)(void *arg, sid_pal_timer_t *originator);
+
+// The timer never expires by itself, the tests fire it
+struct sid_pal_timer_impl_t {
+  sid_pal_timer_cb_t callback;
+  void *callback_arg;
+  bool is_armed;
+};
+
+#endif  // SID_PAL_TIMER_TYPES_H
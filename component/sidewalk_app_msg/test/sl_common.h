@@ -0,0 +1,23 @@
+/***************************************************************************//**
+ * @file sl_common.h
+ * @brief host stand-in for the GSDK common definitions
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_COMMON_H
+#define SL_COMMON_H
+
+#define SL_ATTRIBUTE_PACKED __attribute__((packed))
+
+#endif  // SL_COMMON_H
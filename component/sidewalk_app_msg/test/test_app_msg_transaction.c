@@ -0,0 +1,271 @@
+/***************************************************************************//**
+ * @file test_app_msg_transaction.c
+ * @brief host tests of the application message transaction layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ *** INCLUDES
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sl_sidewalk_app_msg_transaction.h"
+#include "fake_app_msg_platform.h"
+
+/*******************************************************************************
+ *** MACROS AND TYPEDEFS
+ ******************************************************************************/
+
+#define CHECK(cond)                                                    \
+  do {                                                                 \
+    if (!(cond)) {                                                     \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+      failures++;                                                      \
+    }                                                                  \
+  } while (0)
+
+#define TEST_CMD_CLS  (1)
+
+// Completion callback record
+typedef struct {
+  uint32_t calls;
+  sl_sid_app_msg_st_t status;
+  const sl_sid_app_msg_view_t *rsp;
+  void *context;
+} test_completion_t;
+
+// Encoded request
+typedef struct {
+  uint8_t buf[FAKE_APP_MSG_ENCODED_LEN];
+  struct sid_msg msg;
+} test_request_t;
+
+/*******************************************************************************
+ *** STATIC VARIABLES
+ ******************************************************************************/
+
+static int failures;
+static test_completion_t completion;
+
+/*******************************************************************************
+ *** STATIC FUNCTIONS
+ ******************************************************************************/
+
+static void on_complete(sl_sid_app_msg_st_t status, const sl_sid_app_msg_view_t *rsp, void *context)
+{
+  completion.calls++;
+  completion.status = status;
+  completion.rsp = rsp;
+  completion.context = context;
+}
+
+static void setup(void)
+{
+  fake_app_msg_platform_init();
+  sl_sid_app_msg_transaction_reset_stats();
+  memset(&completion, 0, sizeof(completion));
+}
+
+static sl_sid_app_msg_st_t start(test_request_t *req, uint8_t cmd_id, sl_sid_app_msg_op_t op)
+{
+  req->msg.data = req->buf;
+  req->msg.size = sizeof(req->buf);
+  return sl_sid_app_msg_transaction_start(&req->msg, TEST_CMD_CLS, cmd_id, op, NULL, 0, 0, on_complete, req);
+}
+
+static uint8_t seq_of(const test_request_t *req)
+{
+  return req->buf[3];
+}
+
+static sl_sid_app_msg_st_t respond(uint8_t cmd_id, sl_sid_app_msg_op_t op, uint8_t seq)
+{
+  sl_sid_app_msg_view_t rsp = {
+    .tag = {
+      .proto_ver = SLI_SID_APP_MSG_PROTO_VER,
+      .cmd_cls = TEST_CMD_CLS,
+      .cmd_id = cmd_id,
+      .op = (uint8_t)op,
+      .seq = seq
+    }
+  };
+  return sli_sid_app_msg_transaction_on_response(&rsp);
+}
+
+static sl_sid_app_msg_transaction_stats_t get_stats(void)
+{
+  sl_sid_app_msg_transaction_stats_t stats;
+  (void)sl_sid_app_msg_transaction_get_stats(TEST_CMD_CLS, &stats);
+  return stats;
+}
+
+static void test_response_completes_request(void)
+{
+  test_request_t req;
+
+  setup();
+  CHECK(start(&req, 1, SL_SID_APP_MSG_OP_GET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 1);
+
+  fake_app_msg_platform.uptime_ms = 250;
+  CHECK(respond(1, SL_SID_APP_MSG_OP_RESP, seq_of(&req)) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(completion.calls == 1);
+  CHECK(completion.status == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(completion.rsp != NULL);
+  CHECK(completion.context == &req);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 0);
+
+  sl_sid_app_msg_transaction_stats_t stats = get_stats();
+  CHECK(stats.started == 1);
+  CHECK(stats.completed == 1);
+  CHECK(stats.latency_max_ms == 250);
+}
+
+static void test_duplicate_response_reported(void)
+{
+  test_request_t req;
+
+  setup();
+  CHECK(start(&req, 2, SL_SID_APP_MSG_OP_SET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(respond(2, SL_SID_APP_MSG_OP_ACK, seq_of(&req)) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+
+  // The request is in the history, the callback is not called again
+  CHECK(respond(2, SL_SID_APP_MSG_OP_ACK, seq_of(&req)) == SL_SID_APP_MSG_ERR_ST_TRANS_DUPLICATE_RESP);
+  CHECK(completion.calls == 1);
+
+  sl_sid_app_msg_transaction_stats_t stats = get_stats();
+  CHECK(stats.completed == 1);
+  CHECK(stats.duplicate_resp == 1);
+  CHECK(stats.unexpected_resp == 0);
+}
+
+static void test_unexpected_response_reported(void)
+{
+  test_request_t req;
+
+  setup();
+  CHECK(start(&req, 3, SL_SID_APP_MSG_OP_GET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+
+  // Wrong command, then the ack of a set that was never sent
+  CHECK(respond(4, SL_SID_APP_MSG_OP_RESP, seq_of(&req)) == SL_SID_APP_MSG_ERR_ST_TRANS_UNEXPECTED_RESP);
+  CHECK(respond(3, SL_SID_APP_MSG_OP_ACK, seq_of(&req)) == SL_SID_APP_MSG_ERR_ST_TRANS_UNEXPECTED_RESP);
+  CHECK(completion.calls == 0);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 1);
+
+  sl_sid_app_msg_transaction_stats_t stats = get_stats();
+  CHECK(stats.unexpected_resp == 2);
+  CHECK(stats.duplicate_resp == 0);
+
+  CHECK(sl_sid_app_msg_transaction_abort(&req.msg) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(completion.calls == 0);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 0);
+}
+
+static void test_timeout_reported(void)
+{
+  test_request_t req;
+
+  setup();
+  CHECK(start(&req, 5, SL_SID_APP_MSG_OP_SET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+
+  fake_app_msg_platform_fire(fake_app_msg_platform.last_armed_timer);
+  CHECK(completion.calls == 1);
+  CHECK(completion.status == SL_SID_APP_MSG_ERR_ST_TRANS_TIMEOUT);
+  CHECK(completion.rsp == NULL);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 0);
+
+  // A late ack counts as duplicate
+  CHECK(respond(5, SL_SID_APP_MSG_OP_ACK, seq_of(&req)) == SL_SID_APP_MSG_ERR_ST_TRANS_DUPLICATE_RESP);
+  CHECK(completion.calls == 1);
+
+  sl_sid_app_msg_transaction_stats_t stats = get_stats();
+  CHECK(stats.timed_out == 1);
+  CHECK(stats.completed == 0);
+  CHECK(stats.duplicate_resp == 1);
+}
+
+static void test_set_and_get_share_seq(void)
+{
+  test_request_t set_req;
+  test_request_t get_req;
+
+  setup();
+  fake_app_msg_platform.rand_value = 7;
+  CHECK(start(&set_req, 6, SL_SID_APP_MSG_OP_SET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(start(&get_req, 6, SL_SID_APP_MSG_OP_GET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(seq_of(&set_req) == seq_of(&get_req));
+
+  // Each answer completes the request of its own op
+  CHECK(respond(6, SL_SID_APP_MSG_OP_RESP, seq_of(&get_req)) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(completion.context == &get_req);
+  CHECK(respond(6, SL_SID_APP_MSG_OP_ACK, seq_of(&set_req)) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(completion.context == &set_req);
+  CHECK(completion.calls == 2);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 0);
+}
+
+static void test_stale_timeout_ignored(void)
+{
+  test_request_t first;
+  test_request_t second;
+
+  setup();
+  CHECK(start(&first, 7, SL_SID_APP_MSG_OP_GET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  sid_pal_timer_t *timer = fake_app_msg_platform.last_armed_timer;
+  sid_pal_timer_cb_t stale_cb = timer->callback;
+  void *stale_arg = timer->callback_arg;
+
+  // The response wins the race against the expiry of the first request
+  CHECK(respond(7, SL_SID_APP_MSG_OP_RESP, seq_of(&first)) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(completion.calls == 1);
+
+  // The slot and its timer are reused before the expiry is delivered
+  CHECK(start(&second, 7, SL_SID_APP_MSG_OP_GET) == SL_SID_APP_MSG_ERR_ST_SUCCESS);
+  CHECK(fake_app_msg_platform.last_armed_timer == timer);
+  stale_cb(stale_arg, timer);
+  CHECK(completion.calls == 1);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 1);
+
+  // The second request still times out on its own expiry
+  fake_app_msg_platform_fire(timer);
+  CHECK(completion.calls == 2);
+  CHECK(completion.status == SL_SID_APP_MSG_ERR_ST_TRANS_TIMEOUT);
+  CHECK(completion.context == &second);
+  CHECK(get_stats().timed_out == 1);
+  CHECK(sl_sid_app_msg_transaction_get_in_flight_count() == 0);
+}
+
+/*******************************************************************************
+ *** GLOBAL FUNCTIONS
+ ******************************************************************************/
+
+int main(void)
+{
+  test_response_completes_request();
+  test_duplicate_response_reported();
+  test_unexpected_response_reported();
+  test_timeout_reported();
+  test_set_and_get_share_seq();
+  test_stale_timeout_ignored();
+
+  if (failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("app msg transaction: all tests passed\n");
+  return EXIT_SUCCESS;
+}
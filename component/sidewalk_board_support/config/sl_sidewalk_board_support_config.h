@@ -0,0 +1,72 @@
+/***************************************************************************//**
+ * @file
+ * @brief Sidewalk component configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SIDEWALK_BOARD_SUPPORT_CONFIG_H
+#define SL_SIDEWALK_BOARD_SUPPORT_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h> Sidewalk board support sensor sampling configuration
+
+// <o> SL_SIDEWALK_BOARD_SUPPORT_SAMPLE_PERIOD_MS <1-4294967295>
+// <i> Time between the start of two sensor samples in ms
+// <i> Default: 1000
+// <d> 1000
+#ifndef SL_SIDEWALK_BOARD_SUPPORT_SAMPLE_PERIOD_MS
+#define SL_SIDEWALK_BOARD_SUPPORT_SAMPLE_PERIOD_MS 1000
+#endif
+
+// <o> SL_SIDEWALK_BOARD_SUPPORT_OVERSAMPLING <1-255>
+// <i> Conversions run back to back and averaged into one sample
+// <i> Default: 1
+// <d> 1
+#ifndef SL_SIDEWALK_BOARD_SUPPORT_OVERSAMPLING
+#define SL_SIDEWALK_BOARD_SUPPORT_OVERSAMPLING 1
+#endif
+
+// <o> SL_SIDEWALK_BOARD_SUPPORT_DECIMATION <1-255>
+// <i> Samples averaged into one reported value
+// <i> Default: 1
+// <d> 1
+#ifndef SL_SIDEWALK_BOARD_SUPPORT_DECIMATION
+#define SL_SIDEWALK_BOARD_SUPPORT_DECIMATION 1
+#endif
+
+// <o> SL_SIDEWALK_BOARD_SUPPORT_SI70XX_CONVERSION_MS <1-1000>
+// <i> Time given to the Si70xx to complete a humidity and temperature conversion in ms
+// <i> Default: 25
+// <d> 25
+#ifndef SL_SIDEWALK_BOARD_SUPPORT_SI70XX_CONVERSION_MS
+#define SL_SIDEWALK_BOARD_SUPPORT_SI70XX_CONVERSION_MS 25
+#endif
+
+// </h>
+
+#endif // SL_SIDEWALK_BOARD_SUPPORT_CONFIG_H
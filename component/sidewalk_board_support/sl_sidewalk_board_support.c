@@ -55,8 +55,11 @@
 #include "sl_board_control_config.h"
 #endif
 
-#if defined(SL_TEMPERATURE_SENSOR_INTERNAL)
-#include "tempdrv.h"
+#if (defined(SL_TEMPERATURE_SENSOR_EXTERNAL) || defined(SL_TEMPERATURE_SENSOR_INTERNAL))
+#include "sid_pal_temperature_ifc.h"
+#include "temperature.h"
+#include "sl_sidewalk_sensor_sampler.h"
+#include "sl_sidewalk_board_support_config.h"
 #endif
 
 #if defined(SL_SEGMENT_LCD)
@@ -77,12 +80,24 @@
 
 #if (defined(SL_TEMPERATURE_SENSOR_INTERNAL) || defined(SL_TEMPERATURE_SENSOR_EXTERNAL))
 /*******************************************************************************
- * Timer callback to periodically measuring and reporting the temperature and relative humidity.
- * It measures the ambient temperature if sensor is available on the current target.
+ * Timer callback driving the temperature sampler. Each call either starts a
+ * conversion or collects a finished one, the timer is re-armed with the delay
+ * returned by the sampler so the timer task never waits on the sensor.
  *
  * @param pxTimer
  ******************************************************************************/
 static void HN_temperature_timer_cb(TimerHandle_t pxTimer);
+
+/*******************************************************************************
+ * Report a decimated temperature and relative humidity result.
+ *
+ * @param temperature in milli degree Celsius
+ * @param humidity relative humidity in milli percent
+ ******************************************************************************/
+static void HN_temperature_result_cb(int32_t temperature, uint32_t humidity);
+
+static bool temperature_sensor_start(void *context);
+static bool temperature_sensor_read(void *context, int32_t *temperature, uint32_t *humidity);
 #endif
 
 // -----------------------------------------------------------------------------
@@ -95,6 +110,25 @@ static void HN_temperature_timer_cb(TimerHandle_t pxTimer);
 
 #if (defined(SL_TEMPERATURE_SENSOR_INTERNAL) || defined(SL_TEMPERATURE_SENSOR_EXTERNAL))
 static TimerHandle_t temperature_measure_timer_hnd = NULL;
+static sl_sidewalk_sensor_sampler_t temperature_sampler;
+
+static const sl_sidewalk_sensor_driver_t temperature_sensor = {
+  .start = temperature_sensor_start,
+  .read = temperature_sensor_read,
+#if defined(SL_TEMPERATURE_SENSOR_EXTERNAL)
+  .conversion_time_ms = SL_SIDEWALK_BOARD_SUPPORT_SI70XX_CONVERSION_MS,
+#else
+  // The internal sensor is sampled by the temperature service
+  .conversion_time_ms = 0,
+#endif
+  .context = NULL,
+};
+
+static const sl_sidewalk_sensor_sampler_config_t temperature_sampler_config = {
+  .sample_period_ms = SL_SIDEWALK_BOARD_SUPPORT_SAMPLE_PERIOD_MS,
+  .oversampling = SL_SIDEWALK_BOARD_SUPPORT_OVERSAMPLING,
+  .decimation = SL_SIDEWALK_BOARD_SUPPORT_DECIMATION,
+};
 #endif
 
 // -----------------------------------------------------------------------------
@@ -109,6 +143,9 @@ void sl_sidewalk_board_support_init(void)
   GPIO_PinOutSet(SL_BOARD_ENABLE_SENSOR_RHT_PORT, SL_BOARD_ENABLE_SENSOR_RHT_PIN);
 #endif
   sl_si70xx_init(sl_i2cspm_sensor, SI7021_ADDR);
+#elif defined(SL_TEMPERATURE_SENSOR_INTERNAL)
+  // The internal sensor is sampled by the shared temperature service
+  (void)sid_pal_temperature_init();
 #endif
 
 #if defined(SL_SEGMENT_LCD)
@@ -133,9 +170,14 @@ void sl_sidewalk_board_support_init(void)
 void sl_sidewalk_start_temperature_timer(void)
 {
 #if (defined(SL_TEMPERATURE_SENSOR_INTERNAL) || defined(SL_TEMPERATURE_SENSOR_EXTERNAL))
+  sl_sidewalk_sensor_sampler_init(&temperature_sampler,
+                                  &temperature_sensor,
+                                  &temperature_sampler_config,
+                                  HN_temperature_result_cb);
+
   temperature_measure_timer_hnd = xTimerCreate("temperature_timer",
-                                               pdMS_TO_TICKS(1000),
-                                               pdTRUE,
+                                               pdMS_TO_TICKS(SL_SIDEWALK_BOARD_SUPPORT_SAMPLE_PERIOD_MS),
+                                               pdFALSE,
                                                (void*)0,
                                                HN_temperature_timer_cb);
 
@@ -154,24 +196,59 @@ void sl_sidewalk_start_temperature_timer(void)
 #if (defined(SL_TEMPERATURE_SENSOR_INTERNAL) || defined(SL_TEMPERATURE_SENSOR_EXTERNAL))
 static void HN_temperature_timer_cb(TimerHandle_t pxTimer)
 {
-  (void) pxTimer;
+  uint32_t delay_ms;
+
+  do {
+    delay_ms = sl_sidewalk_sensor_sampler_run(&temperature_sampler);
+  } while (delay_ms == 0);
+
+  TickType_t delay_ticks = pdMS_TO_TICKS(delay_ms);
+  if (delay_ticks == 0) {
+    delay_ticks = 1;
+  }
+  xTimerChangePeriod(pxTimer, delay_ticks, 0);
+}
+
+static bool temperature_sensor_start(void *context)
+{
+  (void)context;
+#if defined(SL_TEMPERATURE_SENSOR_EXTERNAL)
+  // Only the command goes out on the bus, the conversion runs in the sensor.
+  // A humidity measurement also converts the temperature, read back with it
+  return sl_si70xx_start_no_hold_measure_rh(sl_i2cspm_sensor, SI7021_ADDR) == SL_STATUS_OK;
+#else
+  return true;
+#endif
+}
+
+static bool temperature_sensor_read(void *context, int32_t *temperature, uint32_t *humidity)
+{
+  (void)context;
+#if defined(SL_TEMPERATURE_SENSOR_EXTERNAL)
+  return sl_si70xx_read_rh_and_temp(sl_i2cspm_sensor, SI7021_ADDR, humidity, temperature) == SL_STATUS_OK;
+#else
+  *humidity = 0;
+  return sli_sid_temperature_get(temperature) == SID_ERROR_NONE;
+#endif
+}
+
+static void HN_temperature_result_cb(int32_t temperature, uint32_t humidity)
+{
   int32_t temp_data;
   static bool isPrevTempData = false;
   char number_buffer[8];
   memset(number_buffer, 0, sizeof(number_buffer));
 
 #if defined(SL_TEMPERATURE_SENSOR_EXTERNAL)
-  uint32_t rh_data;
-  // Measure the values for relative humidity and temperature
-  sl_si70xx_measure_rh_and_temp(sl_i2cspm_sensor,
-                                SI7021_ADDR,
-                                &rh_data,
-                                &temp_data);
+  temp_data = temperature;
+  // Share the reading with the radio temperature compensation
+  sli_sid_temperature_feed(temp_data);
   sprintf(number_buffer, "%.2f", (float)((float)temp_data / 1000.0));
 #elif defined(SL_TEMPERATURE_SENSOR_INTERNAL)
-  temp_data = (int32_t)TEMPDRV_GetTemp();
+  temp_data = (temperature + ((temperature >= 0) ? 500 : -500)) / 1000;
   sprintf(number_buffer, "%d", temp_data);
 #endif
+  (void)humidity;
 
 #if defined(SL_SIDEWALK_SENSOR)
   sl_sidewalk_sensor_report(SL_SIDEWALK_SENSOR_TYPE_TEMPERATURE, number_buffer, SL_SIDEWALK_SENDER_TYPE_PRIORITY_LOW);
@@ -182,7 +259,7 @@ static void HN_temperature_timer_cb(TimerHandle_t pxTimer)
     sl_segment_lcd_temp_display(temp_data);
     isPrevTempData = true;
   } else {
-    sl_segment_lcd_number(rh_data);
+    sl_segment_lcd_number(humidity);
     sl_segment_lcd_symbol(SL_LCD_SYMBOL_P2, 1);
     isPrevTempData = false;
   }
@@ -0,0 +1,166 @@
+/***************************************************************************//**
+ * @file
+ * @brief sl_sidewalk_sensor_sampler.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <string.h>
+
+#include "sl_sidewalk_sensor_sampler.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Drop the conversions of the current burst and compute the delay until the
+ * next sample is due.
+ *
+ * @param[in,out] sampler Sampler
+ * @return Delay in ms until the next sample
+ ******************************************************************************/
+static uint32_t end_burst(sl_sidewalk_sensor_sampler_t *sampler);
+
+// -----------------------------------------------------------------------------
+//                                Global Variables
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+
+void sl_sidewalk_sensor_sampler_init(sl_sidewalk_sensor_sampler_t *sampler,
+                                     const sl_sidewalk_sensor_driver_t *driver,
+                                     const sl_sidewalk_sensor_sampler_config_t *config,
+                                     sl_sidewalk_sensor_result_cb_t result_cb)
+{
+  memset(sampler, 0, sizeof(*sampler));
+  sampler->driver = driver;
+  sampler->result_cb = result_cb;
+  sampler->config = *config;
+  if (sampler->config.oversampling == 0) {
+    sampler->config.oversampling = 1;
+  }
+  if (sampler->config.decimation == 0) {
+    sampler->config.decimation = 1;
+  }
+  sampler->state = SL_SIDEWALK_SENSOR_SAMPLER_IDLE;
+}
+
+uint32_t sl_sidewalk_sensor_sampler_run(sl_sidewalk_sensor_sampler_t *sampler)
+{
+  const sl_sidewalk_sensor_driver_t *driver = sampler->driver;
+  int32_t temperature;
+  uint32_t humidity;
+
+  if (sampler->state == SL_SIDEWALK_SENSOR_SAMPLER_IDLE) {
+    if (!driver->start(driver->context)) {
+      sampler->errors++;
+      return end_burst(sampler);
+    }
+    sampler->state = SL_SIDEWALK_SENSOR_SAMPLER_CONVERTING;
+    sampler->burst_ms = driver->conversion_time_ms;
+    return driver->conversion_time_ms;
+  }
+
+  // Conversion time is over, collect the result
+  if (!driver->read(driver->context, &temperature, &humidity)) {
+    sampler->errors++;
+    return end_burst(sampler);
+  }
+
+  sampler->conversion_temperature_sum += temperature;
+  sampler->conversion_humidity_sum += humidity;
+  sampler->conversions++;
+
+  if (sampler->conversions < sampler->config.oversampling) {
+    if (!driver->start(driver->context)) {
+      sampler->errors++;
+      return end_burst(sampler);
+    }
+    sampler->burst_ms += driver->conversion_time_ms;
+    return driver->conversion_time_ms;
+  }
+
+  sampler->sample_temperature_sum += sampler->conversion_temperature_sum / (int32_t)sampler->conversions;
+  sampler->sample_humidity_sum += sampler->conversion_humidity_sum / sampler->conversions;
+  sampler->samples++;
+
+  if (sampler->samples >= sampler->config.decimation) {
+    int32_t result_temperature = sampler->sample_temperature_sum / (int32_t)sampler->samples;
+    uint32_t result_humidity = sampler->sample_humidity_sum / sampler->samples;
+
+    sampler->sample_temperature_sum = 0;
+    sampler->sample_humidity_sum = 0;
+    sampler->samples = 0;
+    if (sampler->result_cb != NULL) {
+      sampler->result_cb(result_temperature, result_humidity);
+    }
+  }
+
+  return end_burst(sampler);
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+static uint32_t end_burst(sl_sidewalk_sensor_sampler_t *sampler)
+{
+  uint32_t delay_ms = 1;
+
+  if (sampler->config.sample_period_ms > sampler->burst_ms) {
+    delay_ms = sampler->config.sample_period_ms - sampler->burst_ms;
+  }
+
+  sampler->state = SL_SIDEWALK_SENSOR_SAMPLER_IDLE;
+  sampler->conversions = 0;
+  sampler->conversion_temperature_sum = 0;
+  sampler->conversion_humidity_sum = 0;
+  sampler->burst_ms = 0;
+
+  return delay_ms;
+}
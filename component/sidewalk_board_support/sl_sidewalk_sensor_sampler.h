@@ -0,0 +1,133 @@
+/***************************************************************************//**
+ * @file
+ * @brief sl_sidewalk_sensor_sampler.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SIDEWALK_SENSOR_SAMPLER_H
+#define SL_SIDEWALK_SENSOR_SAMPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Sensor driver used by the sampler. Both calls must return without waiting
+ * for the conversion: start only kicks it off, read is called once
+ * conversion_time_ms has elapsed.
+ ******************************************************************************/
+typedef struct {
+  // Start a conversion, returns false on bus error
+  bool (*start)(void *context);
+  // Fetch the result of the last conversion, returns false on bus error
+  bool (*read)(void *context, int32_t *temperature, uint32_t *humidity);
+  // Time needed by the sensor to complete a conversion
+  uint32_t conversion_time_ms;
+  void *context;
+} sl_sidewalk_sensor_driver_t;
+
+/*******************************************************************************
+ * Called with every decimated result, temperature in milli degree Celsius and
+ * relative humidity in milli percent.
+ ******************************************************************************/
+typedef void (*sl_sidewalk_sensor_result_cb_t)(int32_t temperature, uint32_t humidity);
+
+typedef struct {
+  uint32_t sample_period_ms;
+  uint8_t oversampling;
+  uint8_t decimation;
+} sl_sidewalk_sensor_sampler_config_t;
+
+typedef enum {
+  SL_SIDEWALK_SENSOR_SAMPLER_IDLE,
+  SL_SIDEWALK_SENSOR_SAMPLER_CONVERTING,
+} sl_sidewalk_sensor_sampler_state_t;
+
+typedef struct {
+  const sl_sidewalk_sensor_driver_t *driver;
+  sl_sidewalk_sensor_result_cb_t result_cb;
+  sl_sidewalk_sensor_sampler_config_t config;
+  sl_sidewalk_sensor_sampler_state_t state;
+  uint8_t conversions;
+  uint8_t samples;
+  uint32_t burst_ms;
+  int32_t conversion_temperature_sum;
+  uint32_t conversion_humidity_sum;
+  int32_t sample_temperature_sum;
+  uint32_t sample_humidity_sum;
+  uint32_t errors;
+} sl_sidewalk_sensor_sampler_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/**************************************************************************//**
+ * Initialize a sampler. A zero oversampling or decimation is treated as 1.
+ *
+ * @param[out] sampler Sampler to initialize
+ * @param[in] driver Sensor driver
+ * @param[in] config Sampling configuration
+ * @param[in] result_cb Called with every decimated result
+ *****************************************************************************/
+void sl_sidewalk_sensor_sampler_init(sl_sidewalk_sensor_sampler_t *sampler,
+                                     const sl_sidewalk_sensor_driver_t *driver,
+                                     const sl_sidewalk_sensor_sampler_config_t *config,
+                                     sl_sidewalk_sensor_result_cb_t result_cb);
+
+/**************************************************************************//**
+ * Advance the sampler, to be called from a one shot timer. Starts a
+ * conversion or collects the finished one and never waits on the bus.
+ *
+ * @param[in,out] sampler Sampler to advance
+ * @return Delay in ms until the next call
+ *****************************************************************************/
+uint32_t sl_sidewalk_sensor_sampler_run(sl_sidewalk_sensor_sampler_t *sampler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_SIDEWALK_SENSOR_SAMPLER_H
@@ -0,0 +1,112 @@
+/***************************************************************************//**
+ * @file
+ * @brief fake_sensor_driver.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "fake_sensor_driver.h"
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+
+static bool fake_sensor_start(void *context);
+static bool fake_sensor_read(void *context, int32_t *temperature, uint32_t *humidity);
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+
+void fake_sensor_init(fake_sensor_t *sensor, sl_sidewalk_sensor_driver_t *driver, uint32_t conversion_time_ms)
+{
+  memset(sensor, 0, sizeof(*sensor));
+  driver->start = fake_sensor_start;
+  driver->read = fake_sensor_read;
+  driver->conversion_time_ms = conversion_time_ms;
+  driver->context = sensor;
+}
+
+void fake_sensor_push(fake_sensor_t *sensor, int32_t temperature, uint32_t humidity)
+{
+  if (sensor->reading_count < FAKE_SENSOR_MAX_READINGS) {
+    sensor->temperature[sensor->reading_count] = temperature;
+    sensor->humidity[sensor->reading_count] = humidity;
+    sensor->reading_count++;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+static bool fake_sensor_start(void *context)
+{
+  fake_sensor_t *sensor = (fake_sensor_t *)context;
+
+  sensor->start_calls++;
+  if (sensor->start_calls == sensor->fail_start_call) {
+    return false;
+  }
+  sensor->converting = true;
+  return true;
+}
+
+static bool fake_sensor_read(void *context, int32_t *temperature, uint32_t *humidity)
+{
+  fake_sensor_t *sensor = (fake_sensor_t *)context;
+  uint8_t idx;
+
+  sensor->read_calls++;
+  if (!sensor->converting) {
+    sensor->protocol_errors++;
+    return false;
+  }
+  sensor->converting = false;
+  if (sensor->read_calls == sensor->fail_read_call || sensor->reading_count == 0) {
+    return false;
+  }
+
+  idx = sensor->next_reading;
+  if (sensor->next_reading + 1 < sensor->reading_count) {
+    sensor->next_reading++;
+  }
+  *temperature = sensor->temperature[idx];
+  *humidity = sensor->humidity[idx];
+  return true;
+}
@@ -0,0 +1,96 @@
+/***************************************************************************//**
+ * @file
+ * @brief fake_sensor_driver.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef FAKE_SENSOR_DRIVER_H
+#define FAKE_SENSOR_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sl_sidewalk_sensor_sampler.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+#define FAKE_SENSOR_MAX_READINGS          32
+
+/*******************************************************************************
+ * Host stand-in for the I2C sensor. Readings are returned in order, the last
+ * one is repeated once they are used up. A bus error can be injected on a
+ * given start or read call (1 based, 0 disables it).
+ ******************************************************************************/
+typedef struct {
+  int32_t temperature[FAKE_SENSOR_MAX_READINGS];
+  uint32_t humidity[FAKE_SENSOR_MAX_READINGS];
+  uint8_t reading_count;
+  uint8_t next_reading;
+  uint32_t fail_start_call;
+  uint32_t fail_read_call;
+  uint32_t start_calls;
+  uint32_t read_calls;
+  // A read must follow a start, reading an idle sensor is a bus error
+  bool converting;
+  uint32_t protocol_errors;
+} fake_sensor_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Reset the fake sensor and fill the driver the sampler is given
+ ******************************************************************************/
+void fake_sensor_init(fake_sensor_t *sensor, sl_sidewalk_sensor_driver_t *driver, uint32_t conversion_time_ms);
+
+/*******************************************************************************
+ * Queue a reading
+ ******************************************************************************/
+void fake_sensor_push(fake_sensor_t *sensor, int32_t temperature, uint32_t humidity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FAKE_SENSOR_DRIVER_H
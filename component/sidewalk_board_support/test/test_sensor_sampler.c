@@ -0,0 +1,254 @@
+/***************************************************************************//**
+ * @file
+ * @brief test_sensor_sampler.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sl_sidewalk_sensor_sampler.h"
+#include "fake_sensor_driver.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+#define CONVERSION_MS                     25
+#define PERIOD_MS                         1000
+
+#define CHECK(cond)                                                    \
+  do {                                                                 \
+    if (!(cond)) {                                                     \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+      failures++;                                                      \
+    }                                                                  \
+  } while (0)
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+
+static int failures;
+static fake_sensor_t sensor;
+static sl_sidewalk_sensor_driver_t driver;
+static sl_sidewalk_sensor_sampler_t sampler;
+static uint32_t result_count;
+static int32_t result_temperature;
+static uint32_t result_humidity;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+static void result_cb(int32_t temperature, uint32_t humidity)
+{
+  result_count++;
+  result_temperature = temperature;
+  result_humidity = humidity;
+}
+
+static void setup(uint8_t oversampling, uint8_t decimation)
+{
+  sl_sidewalk_sensor_sampler_config_t config = {
+    .sample_period_ms = PERIOD_MS,
+    .oversampling = oversampling,
+    .decimation = decimation,
+  };
+
+  fake_sensor_init(&sensor, &driver, CONVERSION_MS);
+  sl_sidewalk_sensor_sampler_init(&sampler, &driver, &config, result_cb);
+  result_count = 0;
+  result_temperature = 0;
+  result_humidity = 0;
+}
+
+static void test_single_conversion(void)
+{
+  setup(1, 1);
+  fake_sensor_push(&sensor, 21500, 40000);
+
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  CHECK(sensor.start_calls == 1 && sensor.read_calls == 0);
+  // The period is counted from the start of the burst
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS - CONVERSION_MS);
+  CHECK(result_count == 1);
+  CHECK(result_temperature == 21500 && result_humidity == 40000);
+  CHECK(sensor.protocol_errors == 0);
+}
+
+static void test_zero_config_is_one(void)
+{
+  setup(0, 0);
+  fake_sensor_push(&sensor, 1000, 2000);
+
+  (void)sl_sidewalk_sensor_sampler_run(&sampler);
+  (void)sl_sidewalk_sensor_sampler_run(&sampler);
+  CHECK(result_count == 1 && result_temperature == 1000);
+}
+
+static void test_oversampling(void)
+{
+  setup(4, 1);
+  fake_sensor_push(&sensor, 20000, 10000);
+  fake_sensor_push(&sensor, 20100, 10100);
+  fake_sensor_push(&sensor, 20200, 10200);
+  fake_sensor_push(&sensor, 20300, 10300);
+
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  for (int i = 0; i < 3; i++) {
+    // Back to back conversions of the burst
+    CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+    CHECK(result_count == 0);
+  }
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS - 4 * CONVERSION_MS);
+  CHECK(sensor.start_calls == 4 && sensor.read_calls == 4);
+  CHECK(result_count == 1);
+  CHECK(result_temperature == 20150 && result_humidity == 10150);
+  CHECK(sensor.protocol_errors == 0);
+}
+
+static void test_decimation(void)
+{
+  setup(1, 3);
+  fake_sensor_push(&sensor, -3000, 30000);
+  fake_sensor_push(&sensor, -2000, 20000);
+  fake_sensor_push(&sensor, -1000, 10000);
+
+  for (int i = 0; i < 3; i++) {
+    CHECK(result_count == 0);
+    CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+    CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS - CONVERSION_MS);
+  }
+  CHECK(result_count == 1);
+  CHECK(result_temperature == -2000 && result_humidity == 20000);
+
+  // The next result only averages the samples taken after the last one
+  for (int i = 0; i < 3; i++) {
+    (void)sl_sidewalk_sensor_sampler_run(&sampler);
+    (void)sl_sidewalk_sensor_sampler_run(&sampler);
+  }
+  CHECK(result_count == 2);
+  CHECK(result_temperature == -1000 && result_humidity == 10000);
+}
+
+static void test_start_error(void)
+{
+  setup(2, 1);
+  fake_sensor_push(&sensor, 25000, 50000);
+  sensor.fail_start_call = 1;
+
+  // Nothing was started, the whole period is left
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS);
+  CHECK(sampler.errors == 1);
+  CHECK(sensor.read_calls == 0);
+
+  // Failing the second start of a burst drops the first conversion
+  sensor.fail_start_call = 3;
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS - CONVERSION_MS);
+  CHECK(sampler.errors == 2);
+  CHECK(result_count == 0);
+
+  // And the sampler recovers on the next burst
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS - 2 * CONVERSION_MS);
+  CHECK(result_count == 1 && result_temperature == 25000);
+  CHECK(sensor.protocol_errors == 0);
+}
+
+static void test_read_error(void)
+{
+  setup(2, 1);
+  fake_sensor_push(&sensor, 18000, 60000);
+  sensor.fail_read_call = 2;
+
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  // The failed read ends the burst, the partial sum is dropped
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS - 2 * CONVERSION_MS);
+  CHECK(sampler.errors == 1);
+  CHECK(result_count == 0);
+
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == PERIOD_MS - 2 * CONVERSION_MS);
+  CHECK(result_count == 1 && result_temperature == 18000 && result_humidity == 60000);
+  CHECK(sensor.protocol_errors == 0);
+}
+
+static void test_burst_longer_than_period(void)
+{
+  sl_sidewalk_sensor_sampler_config_t config = {
+    .sample_period_ms = 2 * CONVERSION_MS,
+    .oversampling = 4,
+    .decimation = 1,
+  };
+
+  fake_sensor_init(&sensor, &driver, CONVERSION_MS);
+  fake_sensor_push(&sensor, 0, 0);
+  sl_sidewalk_sensor_sampler_init(&sampler, &driver, &config, result_cb);
+
+  for (int i = 0; i < 4; i++) {
+    CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == CONVERSION_MS);
+  }
+  // Never 0, the timer is re-armed with the returned delay
+  CHECK(sl_sidewalk_sensor_sampler_run(&sampler) == 1);
+}
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+
+int main(void)
+{
+  test_single_conversion();
+  test_zero_config_is_one();
+  test_oversampling();
+  test_decimation();
+  test_start_error();
+  test_read_error();
+  test_burst_longer_than_period();
+
+  if (failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("sensor sampler: all tests passed\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @file
+ * @brief Sidewalk command executor configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SIDEWALK_CMD_EXECUTOR_CONFIG_H
+#define SL_SIDEWALK_CMD_EXECUTOR_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h> Sidewalk command executor configuration
+
+// <o> SL_SIDEWALK_CMD_EXECUTOR_RX_BUFFER_SIZE <16-4096>
+// <i> Size in bytes of the buffer holding the received, not yet executed
+// <i> commands. Every stored command takes its own length plus the length
+// <i> header (sizeof(size_t)) of the message buffer.
+// <i> Default: 320
+// <d> 320
+#ifndef SL_SIDEWALK_CMD_EXECUTOR_RX_BUFFER_SIZE
+#define SL_SIDEWALK_CMD_EXECUTOR_RX_BUFFER_SIZE 320
+#endif
+
+// <q> SL_SIDEWALK_CMD_EXECUTOR_BINARY_ENABLE
+// <i> Accept binary commands next to the text ones. A binary command is
+// <i> the opcode marker byte followed by the command ID and the payload.
+// <i> Default: 1
+// <d> 1
+#ifndef SL_SIDEWALK_CMD_EXECUTOR_BINARY_ENABLE
+#define SL_SIDEWALK_CMD_EXECUTOR_BINARY_ENABLE 1
+#endif
+
+// <o> SL_SIDEWALK_CMD_EXECUTOR_BINARY_MARKER <0-255>
+// <i> First byte of a binary command. It must not be a printable character
+// <i> so that it can not collide with the text commands.
+// <i> Default: 0xFF
+// <d> 0xFF
+#ifndef SL_SIDEWALK_CMD_EXECUTOR_BINARY_MARKER
+#define SL_SIDEWALK_CMD_EXECUTOR_BINARY_MARKER 0xFF
+#endif
+
+// </h>
+
+// <<< end of configuration section >>>
+
+#endif // SL_SIDEWALK_CMD_EXECUTOR_CONFIG_H
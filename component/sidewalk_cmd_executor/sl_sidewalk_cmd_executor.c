@@ -45,23 +45,44 @@
 
 #include "app_log.h"
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "message_buffer.h"
 #include "sl_common.h"
 #include "sl_command_table.h"
 #include "sl_sidewalk_cmd_executor.h"
+#include "sl_sidewalk_cmd_executor_config.h"
 #include "sl_sidewalk_utils.h"
 #include "sl_simple_led_instances.h"
-
-extern const sl_sidewalk_command_t SL_SIDEWALK_COMMANDS[];
+#include "task.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+// Binary command layout: marker byte, command ID byte, payload
+#define BINARY_COMMAND_HEADER_SIZE (2u)
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+/*******************************************************************************
+ * Finds the longest command that the message starts with.
+ *
+ * @param[in] message The received message
+ * @param[in] message_length Length of the received message
+ * @return The matching command ID or SIDEWALK_COMMAND_ID_END if none matched
+ ******************************************************************************/
+static sl_sidewalk_command_id_t match_text_command(const uint8_t *message, size_t message_length);
+
+/*******************************************************************************
+ * Calls the callback of the given command.
+ *
+ * @param[in] command_id The command to execute
+ * @param[in] payload Payload of the command
+ * @param[in] payload_size Size of the payload
+ ******************************************************************************/
+static void execute_command(sl_sidewalk_command_id_t command_id, uint8_t *payload, size_t payload_size);
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -70,7 +91,7 @@ extern const sl_sidewalk_command_t SL_SIDEWALK_COMMANDS[];
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
-static QueueHandle_t recieve_queue = NULL;
+static MessageBufferHandle_t recieve_buffer = NULL;
 
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
@@ -83,51 +104,123 @@ SL_WEAK void sl_sidewalk_cmd_executor_common_cb(sl_sidewalk_command_id_t command
 
 void sl_sidewalk_cmd_executor_init(void)
 {
-  recieve_queue = xQueueCreate(
-    SL_SIDEWALK_UTILS_MAX_STORED_COMMANDS_NUM,
-    SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR);
+  recieve_buffer = xMessageBufferCreate(SL_SIDEWALK_CMD_EXECUTOR_RX_BUFFER_SIZE);
 }
 
 void sl_sidewalk_cmd_executor_execute(void)
 {
-  char command_buffer[SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR];
-  memset(command_buffer, 0, sizeof(command_buffer));
-
-  if (xQueueReceive(recieve_queue, &command_buffer, 0) == pdTRUE) {
-    for (sl_sidewalk_command_id_t actuator_ix = (sl_sidewalk_command_id_t) 0;
-         actuator_ix < SIDEWALK_COMMAND_ID_END;
-         actuator_ix++) {
-      char *command_in_buffer = strstr(command_buffer, SL_SIDEWALK_COMMANDS[actuator_ix].command);
-
-      if (NULL != command_in_buffer) {
-        if (SL_SIDEWALK_COMMANDS[actuator_ix].callback != NULL) {
-          char *payload_start = command_in_buffer + strlen(SL_SIDEWALK_COMMANDS[actuator_ix].command);
-          size_t payload_size = strlen(payload_start);
-
-          SL_SIDEWALK_COMMANDS[actuator_ix].callback(payload_start, payload_size);
-        }
-
-        sl_sidewalk_cmd_executor_common_cb(actuator_ix);
-        break;
-      }
+  // The last byte is left free for the terminator added after the message,
+  // so text payloads can be parsed as C strings
+  uint8_t command_buffer[SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR];
+
+  size_t command_length = xMessageBufferReceive(recieve_buffer,
+                                                command_buffer,
+                                                sizeof(command_buffer) - 1,
+                                                0);
+  if (command_length > 0) {
+    command_buffer[command_length] = '\0';
+    (void)sl_sidewalk_cmd_executor_dispatch(command_buffer, command_length);
+  }
+}
+
+bool sl_sidewalk_cmd_executor_dispatch(uint8_t *message, size_t message_length)
+{
+  sl_sidewalk_command_id_t command_id = SIDEWALK_COMMAND_ID_END;
+  size_t header_length = 0;
+
+  if (message == NULL || message_length == 0) {
+    return false;
+  }
+
+#if SL_SIDEWALK_CMD_EXECUTOR_BINARY_ENABLE
+  if (message[0] == SL_SIDEWALK_CMD_EXECUTOR_BINARY_MARKER) {
+    if (message_length >= BINARY_COMMAND_HEADER_SIZE
+        && message[1] < (uint8_t)SIDEWALK_COMMAND_ID_END) {
+      command_id = (sl_sidewalk_command_id_t)message[1];
+      header_length = BINARY_COMMAND_HEADER_SIZE;
     }
+  } else
+#endif
+  {
+    command_id = match_text_command(message, message_length);
+    if (command_id != SIDEWALK_COMMAND_ID_END) {
+      header_length = SL_SIDEWALK_COMMANDS[command_id].command_length;
+    }
+  }
+
+  if (command_id == SIDEWALK_COMMAND_ID_END) {
+    return false;
   }
+
+  execute_command(command_id, message + header_length, message_length - header_length);
+  return true;
 }
 
 bool sl_sidewalk_cmd_executor_recieve(char *message, size_t message_length)
 {
-  char command_buffer[SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR];
-  memset(command_buffer, 0, sizeof(command_buffer));
-
   // Copy as many message bytes to the buffer as possible
-  uint8_t max_copy_length = message_length <= (SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR - 1)
-                            ? message_length : (SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR - 1);
-  memcpy(command_buffer, message, max_copy_length);
+  size_t max_copy_length = message_length <= (SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR - 1)
+                           ? message_length : (SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR - 1);
 
-  bool result = (pdTRUE == xQueueSend(recieve_queue, (void *)command_buffer, (TickType_t)0)) ? true : false;
+  if (max_copy_length == 0) {
+    return false;
+  }
+
+  // A message buffer takes a single writer, commands may be received from
+  // several tasks. Without a block time the send is allowed in a critical section.
+  taskENTER_CRITICAL();
+  bool result = (xMessageBufferSend(recieve_buffer, (void *)message, max_copy_length, (TickType_t)0) == max_copy_length) ? true : false;
+  taskEXIT_CRITICAL();
   return result;
 }
 
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
+
+static sl_sidewalk_command_id_t match_text_command(const uint8_t *message, size_t message_length)
+{
+  // [low, high) is the range of commands in SL_SIDEWALK_COMMANDS_BY_NAME
+  // sharing the first depth characters of the message, i.e. the current trie
+  // node. A command ending at depth sorts first in its range.
+  size_t low = 0;
+  size_t high = (size_t)SIDEWALK_COMMAND_ID_END;
+  sl_sidewalk_command_id_t match = SIDEWALK_COMMAND_ID_END;
+
+  for (size_t depth = 0; low < high; depth++) {
+    const sl_sidewalk_command_t *command = &SL_SIDEWALK_COMMANDS[SL_SIDEWALK_COMMANDS_BY_NAME[low]];
+
+    if (command->command_length == depth) {
+      match = SL_SIDEWALK_COMMANDS_BY_NAME[low];
+      low++;
+    }
+
+    if (depth == message_length) {
+      break;
+    }
+
+    char next_char = (char)message[depth];
+    while (low < high
+           && SL_SIDEWALK_COMMANDS[SL_SIDEWALK_COMMANDS_BY_NAME[low]].command[depth] < next_char) {
+      low++;
+    }
+
+    size_t child_high = low;
+    while (child_high < high
+           && SL_SIDEWALK_COMMANDS[SL_SIDEWALK_COMMANDS_BY_NAME[child_high]].command[depth] == next_char) {
+      child_high++;
+    }
+    high = child_high;
+  }
+
+  return match;
+}
+
+static void execute_command(sl_sidewalk_command_id_t command_id, uint8_t *payload, size_t payload_size)
+{
+  if (SL_SIDEWALK_COMMANDS[command_id].callback != NULL) {
+    SL_SIDEWALK_COMMANDS[command_id].callback(payload, payload_size);
+  }
+
+  sl_sidewalk_cmd_executor_common_cb(command_id);
+}
@@ -44,6 +44,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "sid_error.h"
 
@@ -59,6 +60,18 @@
 //                          Public Function Declarations
 // -----------------------------------------------------------------------------
 
+/**************************************************************************//**
+ * Stores a received command for a later sl_sidewalk_cmd_executor_execute()
+ * call.
+ *
+ * Only the received bytes are stored (up to
+ * SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR - 1), not a full command slot.
+ * Can be called from several tasks, but not from an interrupt.
+ *
+ * @param message The received command (text or binary)
+ * @param message_length Length of the received command in bytes
+ * @return true if the command was stored, false if there was no room for it
+ *****************************************************************************/
 bool sl_sidewalk_cmd_executor_recieve(char* message, size_t message_length);
 
 /**************************************************************************//**
@@ -69,6 +82,21 @@ bool sl_sidewalk_cmd_executor_recieve(char* message, size_t message_length);
  * (i.e., configured) then calls the correspondig callbacks.
  *****************************************************************************/
 void sl_sidewalk_cmd_executor_execute(void);
+
+/**************************************************************************//**
+ * Looks up and executes a command in place, without queueing it.
+ *
+ * Text commands must start with the command string, the rest of the message
+ * is the payload. Binary commands start with
+ * SL_SIDEWALK_CMD_EXECUTOR_BINARY_MARKER followed by the command ID byte and
+ * the payload. The payload is handed over to the command callback as a
+ * pointer into the message, it is not copied.
+ *
+ * @param message The command to execute
+ * @param message_length Length of the command in bytes
+ * @return true if a command matched, false otherwise
+ *****************************************************************************/
+bool sl_sidewalk_cmd_executor_dispatch(uint8_t *message, size_t message_length);
 void sl_sidewalk_cmd_executor_init(void);
 
 #endif // SL_SIDEWALK_CMD_EXECUTOR_H
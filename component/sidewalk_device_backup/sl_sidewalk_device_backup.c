@@ -57,6 +57,7 @@
 #endif // EFR32XG24
 
 #include "nvm3.h"
+#include "nvm3_manager.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -493,12 +494,9 @@ static void perform_restore(void)
     key = WRAPPED_KEY_NVM3_KEY_START + i;
     obj_len = WRAPPED_KEY_LEN;
     read_user_data(offset, read_buffer, obj_len);
-    st = nvm3_writeData(nvm3_defaultHandle, key, read_buffer, obj_len);
+    // Repack is scheduled by the nvm3 manager
+    st = sli_sid_nvm3_write(key, read_buffer, obj_len);
     app_assert(st == ECODE_NVM3_OK, "default object cannot be written");
-    if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-      st = nvm3_repack(nvm3_defaultHandle);
-      app_assert(st == ECODE_NVM3_OK, "default nvm3 instance repack failed");
-    }
     offset += obj_len / sizeof(uint32_t);
   }
 #endif // SV_ENABLED
@@ -47,15 +47,24 @@
 #include "em_gpio.h"
 #include "FreeRTOS.h"
 #include "glib.h"
-#include "queue.h"
+#include "message_buffer.h"
+#include "sl_memlcd.h"
 #include "sl_sidewalk_display.h"
 #include "sl_sidewalk_display_config.h"
 #include "sli_sidewalk_qr_code.h"
+#include "task.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+// Row size of a monochrome memory LCD, the size the shadow copy is kept for
+#define DISPLAY_ROW_BYTES          (SL_SIDEWALK_DISPLAY_W_PX / 8)
+// Type byte followed by the text without its terminating zero
+#define DISPLAY_MSG_LEN_MAX        (1 + SL_SIDEWALK_DISPLAY_MAX_STR_LENGTH - 1)
+// The message buffer stores the length of every message next to it
+#define DISPLAY_MSG_BUFFER_SIZE    (SL_SIDEWALK_DISPLAY_STRING_PENDING_NUM_MAX * (DISPLAY_MSG_LEN_MAX + sizeof(size_t)))
+
 typedef enum {
   DISPLAY_MSG_TYPE_NORMAL = 0,
   DISPLAY_MSG_TYPE_QR,
@@ -63,19 +72,39 @@ typedef enum {
 } display_msg_type_t;
 
 typedef struct {
-  QueueHandle_t queue;
-  char buffer[SL_SIDEWALK_DISPLAY_CHAR_H_PX][SL_SIDEWALK_DISPLAY_CHAR_W_PX];
+  MessageBufferHandle_t msg_buffer;
+  // Text lines to be shown and text lines currently in the frame buffer
+  char buffer[SL_SIDEWALK_DISPLAY_CHAR_H_PX][SL_SIDEWALK_DISPLAY_CHAR_W_PX + 1];
+  char shown[SL_SIDEWALK_DISPLAY_CHAR_H_PX][SL_SIDEWALK_DISPLAY_CHAR_W_PX + 1];
+  char qr_text[SL_SIDEWALK_DISPLAY_MAX_STR_LENGTH];
+  bool qr_shown;
+  // Latest status, consecutive updates overwrite each other until rendered.
+  // A STATUS message marks where in the message order it is rendered.
+  sl_sidewalk_display_statistics_t stats;
+  bool stats_pending;
   GLIB_Context_t glibContext;
+  // Frame buffer GLIB draws into and a copy of what the LCD currently shows.
+  // The copy is only used when the LCD rows have the size it is kept for.
+  uint8_t *frame_buffer;
+  uint16_t row_bytes;
+  bool diff_flush;
+  uint8_t white_byte;
+  uint8_t shadow[SL_SIDEWALK_DISPLAY_H_PX][DISPLAY_ROW_BYTES];
 } display_t;
 
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
-static void draw_qr(display_t *display_handler, sli_sidewalk_qr_code_qr_t *qr_buffer);
-static void handle_status_msg(display_t *display_handler, sl_sidewalk_display_msg_t *message);
-static void handle_qr_msg(display_t *display_handler, sl_sidewalk_display_msg_t *message);
-static void handle_normal_msg(display_t *display_handler, sl_sidewalk_display_msg_t *message);
+static void queue_msg(display_msg_type_t type, const char *payload);
+static void blit_qr(display_t *display_handler, const sli_sidewalk_qr_code_bitmap_t *qr);
+static void draw_qr(display_t *display_handler, const sli_sidewalk_qr_code_bitmap_t *qr);
+static void draw_text(display_t *display_handler);
+static void clear_line(display_t *display_handler, uint8_t line);
+static void flush_dirty_rows(display_t *display_handler);
+static bool handle_status_msg(display_t *display_handler);
+static void handle_qr_msg(display_t *display_handler);
+static void handle_normal_msg(display_t *display_handler, const char *text, size_t text_len);
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
@@ -93,168 +122,333 @@ static display_t display_handler;
 
 void sl_sidewalk_display_init(void)
 {
-  display_handler.queue = xQueueCreate(
-    SL_SIDEWALK_DISPLAY_STRING_PENDING_NUM_MAX,
-    sizeof(sl_sidewalk_display_msg_t));
+  const sl_memlcd_t *device;
+
+  display_handler.msg_buffer = xMessageBufferCreate(DISPLAY_MSG_BUFFER_SIZE);
   memset(display_handler.buffer, 0, sizeof(display_handler.buffer));
+  memset(display_handler.shown, 0, sizeof(display_handler.shown));
+  display_handler.qr_shown = false;
+  display_handler.stats_pending = false;
 
   GPIO_PinModeSet(SL_BOARD_ENABLE_DISPLAY_PORT, SL_BOARD_ENABLE_DISPLAY_PIN, gpioModePushPull, 0);
   GPIO_PinOutSet(SL_BOARD_ENABLE_DISPLAY_PORT, SL_BOARD_ENABLE_DISPLAY_PIN);
 
   DMD_init(0);
 
+  // The frame buffer has the row layout sl_memlcd_draw expects, rows are only
+  // diffed and sent one by one when they have the size the shadow is kept for,
+  // otherwise every update is a full DMD refresh
+  device = sl_memlcd_get();
+  display_handler.row_bytes = (uint16_t)((device->width * device->bpp) / 8);
+  display_handler.diff_flush = (display_handler.row_bytes == DISPLAY_ROW_BYTES
+                                && device->height == SL_SIDEWALK_DISPLAY_H_PX);
+
+  // Draw into a frame buffer we own so that consecutive frames can be diffed.
+  // Without one GLIB keeps drawing into the DMD frame buffer and every update
+  // is a full refresh.
+  if (DMD_allocateFramebuffer((void **)&display_handler.frame_buffer) == DMD_OK) {
+    DMD_selectFramebuffer(display_handler.frame_buffer);
+  } else {
+    display_handler.frame_buffer = NULL;
+    display_handler.diff_flush = false;
+  }
+
   GLIB_contextInit(&display_handler.glibContext);
   GLIB_setFont(&display_handler.glibContext, (GLIB_Font_t *)&GLIB_FontNormal8x8);
   display_handler.glibContext.backgroundColor = White;
   display_handler.glibContext.foregroundColor = Black;
+
+  // Start from a known blank screen, later on only changed rows are flushed
+  GLIB_clear(&display_handler.glibContext);
+  DMD_updateDisplay();
+  if (display_handler.diff_flush) {
+    display_handler.white_byte = display_handler.frame_buffer[0];
+    memcpy(display_handler.shadow, display_handler.frame_buffer, sizeof(display_handler.shadow));
+  }
 }
 
 void sl_sidewalk_display_update(void)
 {
-  sl_sidewalk_display_msg_t message;
-
-  if (pdTRUE == xQueueReceive(display_handler.queue, &message, (TickType_t)0)) {
-    GLIB_clear(&display_handler.glibContext);
-
-    // Call the display handler which suits the message type
-    switch (message.type) {
+  uint8_t message[DISPLAY_MSG_LEN_MAX];
+  bool text_pending = false;
+  bool qr_pending = false;
+  size_t message_len;
+
+  // Apply every queued message to the screen content in order, then render
+  // it once. As with single messages, the last QR, text or status message
+  // received decides whether the QR code or the text lines are shown.
+  while ((message_len = xMessageBufferReceive(display_handler.msg_buffer,
+                                              message,
+                                              sizeof(message),
+                                              (TickType_t)0)) > 0) {
+    switch (message[0]) {
       case DISPLAY_MSG_TYPE_NORMAL:
-        handle_normal_msg(&display_handler, &message);
+        handle_normal_msg(&display_handler, (const char *)&message[1], message_len - 1);
+        text_pending = true;
+        qr_pending = false;
         break;
 
       case DISPLAY_MSG_TYPE_QR:
-        handle_qr_msg(&display_handler, &message);
+        memcpy(display_handler.qr_text, &message[1], message_len - 1);
+        display_handler.qr_text[message_len - 1] = '\0';
+        qr_pending = true;
         break;
 
       case DISPLAY_MSG_TYPE_STATUS:
-        handle_status_msg(&display_handler, &message);
+        if (handle_status_msg(&display_handler)) {
+          text_pending = true;
+          qr_pending = false;
+        }
         break;
 
       default:
         break;
     }
+  }
 
-    // Write textual (non-qr) message characters on display lines
-    if (message.type != DISPLAY_MSG_TYPE_QR) {
-      for (uint8_t line = 0; line < SL_SIDEWALK_DISPLAY_CHAR_H_PX; line++) {
-        GLIB_drawStringOnLine(&display_handler.glibContext,
-                              &display_handler.buffer[line][0],
-                              line,
-                              GLIB_ALIGN_LEFT,
-                              0,
-                              0,
-                              false);
-      }
+  // The STATUS message is lost when the message buffer was full
+  if (handle_status_msg(&display_handler)) {
+    text_pending = true;
+    qr_pending = false;
+  }
 
-      DMD_updateDisplay();
-    }
+  if (qr_pending) {
+    handle_qr_msg(&display_handler);
+  } else if (text_pending) {
+    draw_text(&display_handler);
+  } else {
+    return;
   }
+
+  flush_dirty_rows(&display_handler);
 }
 
 void sl_sidewalk_display_stats(sl_sidewalk_display_statistics_t *statistics)
 {
-  sl_sidewalk_display_msg_t message;
-  memset(&message, 0, sizeof(sl_sidewalk_display_msg_t));
+  bool was_pending;
 
-  message.type = DISPLAY_MSG_TYPE_STATUS;
-  memcpy(&message.stats, statistics, sizeof(sl_sidewalk_display_statistics_t));
+  taskENTER_CRITICAL();
+  display_handler.stats = *statistics;
+  was_pending = display_handler.stats_pending;
+  display_handler.stats_pending = true;
+  taskEXIT_CRITICAL();
 
-  xQueueSend(display_handler.queue, (void*) &message, (TickType_t)0);
+  // Updates not rendered yet are already marked in the message order
+  if (!was_pending) {
+    queue_msg(DISPLAY_MSG_TYPE_STATUS, "");
+  }
 }
 
 void sl_sidewalk_display_message(char *payload)
 {
-  sl_sidewalk_display_msg_t message;
-  memset(&message, 0, sizeof(sl_sidewalk_display_msg_t));
-
-  message.type = DISPLAY_MSG_TYPE_NORMAL;
-  memcpy(&message.text, payload, strlen(payload));
-
-  xQueueSend(display_handler.queue, (void*) &message, (TickType_t)0);
+  queue_msg(DISPLAY_MSG_TYPE_NORMAL, payload);
 }
 
 void sl_sidewalk_display_qr(char *payload)
 {
-  sl_sidewalk_display_msg_t message;
-  memset(&message, 0, sizeof(sl_sidewalk_display_msg_t));
-
-  message.type = DISPLAY_MSG_TYPE_QR;
-  memcpy(&message.text, payload, strlen(payload));
-
-  xQueueSend(display_handler.queue, (void*) &message, (TickType_t)0);
+  queue_msg(DISPLAY_MSG_TYPE_QR, payload);
 }
 
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
-static void draw_qr(display_t *display_handler, sli_sidewalk_qr_code_qr_t *qr_buffer)
+static void queue_msg(display_msg_type_t type, const char *payload)
 {
-  uint8_t scale = SL_SIDEWALK_DISPLAY_W_PX / qr_buffer->width;
-  GLIB_Rectangle_t rect = {
-    .xMin = 0,
-    .xMax = 0,
-    .yMin = 0,
-    .yMax = 0,
-  };
+  uint8_t message[DISPLAY_MSG_LEN_MAX];
+  size_t payload_len = strnlen(payload, DISPLAY_MSG_LEN_MAX - 1);
+
+  // Only the used part of the message is copied into the message buffer
+  message[0] = (uint8_t)type;
+  memcpy(&message[1], payload, payload_len);
+
+  xMessageBufferSend(display_handler.msg_buffer, message, 1 + payload_len, (TickType_t)0);
+}
+
+static void blit_qr(display_t *display_handler, const sli_sidewalk_qr_code_bitmap_t *qr)
+{
+  uint8_t pixel_row[DISPLAY_ROW_BYTES];
+  uint8_t scale = SL_SIDEWALK_DISPLAY_W_PX / qr->width;
+  uint16_t y_px = SL_SIDEWALK_DISPLAY_BORDER_PX;
+
+  memset(display_handler->frame_buffer, display_handler->white_byte, sizeof(display_handler->shadow));
+
+  // Each module row is expanded to display pixels once, then copied to all
+  // pixel rows the module covers. Dark pixels are the inverse of white ones.
+  for (uint8_t y = 0; y < qr->width && y_px < SL_SIDEWALK_DISPLAY_H_PX; y++) {
+    const uint8_t *module_row = &qr->bitmap[y * qr->row_bytes];
+
+    memset(pixel_row, display_handler->white_byte, sizeof(pixel_row));
+    for (uint8_t x = 0; x < qr->width; x++) {
+      if (module_row[x / 8] & (1U << (x % 8))) {
+        uint16_t x_px = SL_SIDEWALK_DISPLAY_BORDER_PX + x * scale;
+        for (uint8_t i = 0; i < scale && x_px < SL_SIDEWALK_DISPLAY_W_PX; i++, x_px++) {
+          pixel_row[x_px / 8] ^= (uint8_t)(1U << (x_px % 8));
+        }
+      }
+    }
+
+    for (uint8_t i = 0; i < scale && y_px < SL_SIDEWALK_DISPLAY_H_PX; i++, y_px++) {
+      memcpy(&display_handler->frame_buffer[y_px * DISPLAY_ROW_BYTES], pixel_row, DISPLAY_ROW_BYTES);
+    }
+  }
+
+  // The text lines have to be redrawn from scratch once the QR is replaced
+  memset(display_handler->shown, 0, sizeof(display_handler->shown));
+  display_handler->qr_shown = true;
+}
 
-  GLIB_clear(&display_handler->glibContext);
+static void draw_qr(display_t *display_handler, const sli_sidewalk_qr_code_bitmap_t *qr)
+{
+  GLIB_Context_t *glib = &display_handler->glibContext;
+  uint8_t scale = SL_SIDEWALK_DISPLAY_W_PX / qr->width;
+  GLIB_Rectangle_t rect;
 
-  for (uint8_t x = 0; x < qr_buffer->width; x++) {
-    for (uint8_t y = 0; y < qr_buffer->width; y++) {
-      rect.xMin =  x * scale + SL_SIDEWALK_DISPLAY_BORDER_PX;
-      rect.xMax = (x * scale) + scale + SL_SIDEWALK_DISPLAY_BORDER_PX;
+  GLIB_clear(glib);
 
-      rect.yMin =  y * scale + SL_SIDEWALK_DISPLAY_BORDER_PX;
-      rect.yMax = (y * scale) + scale + SL_SIDEWALK_DISPLAY_BORDER_PX;
+  // Horizontal runs of dark modules are filled as one rectangle
+  for (uint8_t y = 0; y < qr->width; y++) {
+    const uint8_t *module_row = &qr->bitmap[y * qr->row_bytes];
 
-      if (sli_sidewalk_qr_code_is_module_pixel_dark(qr_buffer, x, y)) {
-        GLIB_drawRectFilled(&display_handler->glibContext, &rect);
+    rect.yMin = SL_SIDEWALK_DISPLAY_BORDER_PX + y * scale;
+    rect.yMax = rect.yMin + scale - 1;
+    for (uint8_t x = 0; x < qr->width; x++) {
+      if (!(module_row[x / 8] & (1U << (x % 8)))) {
+        continue;
       }
+      rect.xMin = SL_SIDEWALK_DISPLAY_BORDER_PX + x * scale;
+      while (x + 1 < qr->width && (module_row[(x + 1) / 8] & (1U << ((x + 1) % 8)))) {
+        x++;
+      }
+      rect.xMax = SL_SIDEWALK_DISPLAY_BORDER_PX + (x + 1) * scale - 1;
+      GLIB_drawRectFilled(glib, &rect);
     }
   }
 
-  DMD_updateDisplay();
+  // The text lines have to be redrawn from scratch once the QR is replaced
+  memset(display_handler->shown, 0, sizeof(display_handler->shown));
+  display_handler->qr_shown = true;
 }
 
-static void handle_status_msg(display_t *display_handler, sl_sidewalk_display_msg_t *message)
+static void draw_text(display_t *display_handler)
 {
-  char status_str_buffer[24];
-  memset(status_str_buffer, 0, sizeof(status_str_buffer));
+  if (display_handler->qr_shown) {
+    GLIB_clear(&display_handler->glibContext);
+    display_handler->qr_shown = false;
+  }
 
-  sprintf(status_str_buffer, "registration: %d", message->stats.is_registered);
-  memset(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE][0], 0, SL_SIDEWALK_DISPLAY_CHAR_W_PX);
-  memcpy(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE][0], status_str_buffer, strlen(status_str_buffer));
+  // Only lines whose content changed are redrawn into the frame buffer
+  for (uint8_t line = 0; line < SL_SIDEWALK_DISPLAY_CHAR_H_PX; line++) {
+    if (strcmp(display_handler->buffer[line], display_handler->shown[line]) != 0) {
+      clear_line(display_handler, line);
+      GLIB_drawStringOnLine(&display_handler->glibContext,
+                            &display_handler->buffer[line][0],
+                            line,
+                            GLIB_ALIGN_LEFT,
+                            0,
+                            0,
+                            false);
+      strcpy(display_handler->shown[line], display_handler->buffer[line]);
+    }
+  }
+}
 
-  sprintf(status_str_buffer, "time sync: %d", message->stats.is_time_synced);
-  memset(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE + 1][0], 0, SL_SIDEWALK_DISPLAY_CHAR_W_PX);
-  memcpy(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE + 1][0], status_str_buffer, strlen(status_str_buffer));
+static void clear_line(display_t *display_handler, uint8_t line)
+{
+  GLIB_Context_t *glib = &display_handler->glibContext;
+  uint16_t line_height = glib->font.fontHeight + glib->font.lineSpacing;
+  uint32_t foreground = glib->foregroundColor;
+  GLIB_Rectangle_t rect = {
+    .xMin = 0,
+    .xMax = SL_SIDEWALK_DISPLAY_W_PX - 1,
+    .yMin = line * line_height,
+    .yMax = (line + 1) * line_height - 1,
+  };
 
-  sprintf(status_str_buffer, "link type: %d", message->stats.link);
-  memset(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE + 2][0], 0, SL_SIDEWALK_DISPLAY_CHAR_W_PX);
-  memcpy(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE + 2][0], status_str_buffer, strlen(status_str_buffer));
+  glib->foregroundColor = glib->backgroundColor;
+  GLIB_drawRectFilled(glib, &rect);
+  glib->foregroundColor = foreground;
+}
 
-  sprintf(status_str_buffer, "last tx msg id: %d", message->stats.last_successful_tx_seq_num);
-  memset(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE + 3][0], 0, SL_SIDEWALK_DISPLAY_CHAR_W_PX);
-  memcpy(&display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE + 3][0], status_str_buffer, strlen(status_str_buffer));
+static void flush_dirty_rows(display_t *display_handler)
+{
+  const sl_memlcd_t *device = sl_memlcd_get();
+  uint16_t row_bytes = display_handler->row_bytes;
+  uint16_t row = 0;
+
+  if (!display_handler->diff_flush) {
+    DMD_updateDisplay();
+    return;
+  }
+
+  // Send consecutive changed rows in one memory LCD update command, unchanged
+  // rows are not transferred at all
+  while (row < SL_SIDEWALK_DISPLAY_H_PX) {
+    uint8_t *row_data = &display_handler->frame_buffer[row * row_bytes];
+    uint16_t first_row = row;
+
+    while (row < SL_SIDEWALK_DISPLAY_H_PX
+           && memcmp(&display_handler->frame_buffer[row * row_bytes],
+                     display_handler->shadow[row],
+                     row_bytes) != 0) {
+      memcpy(display_handler->shadow[row],
+             &display_handler->frame_buffer[row * row_bytes],
+             row_bytes);
+      row++;
+    }
+
+    if (row > first_row) {
+      sl_memlcd_draw(device, row_data, first_row, row - first_row);
+    } else {
+      row++;
+    }
+  }
 }
 
-static void handle_normal_msg(display_t *display_handler, sl_sidewalk_display_msg_t *message)
+static bool handle_status_msg(display_t *display_handler)
+{
+  sl_sidewalk_display_statistics_t stats;
+  char *line = display_handler->buffer[SL_SIDEWALK_DISPLAY_STATUS_START_LINE];
+  size_t line_size = sizeof(display_handler->buffer[0]);
+  bool stats_pending;
+
+  // Only the latest status is rendered, intermediate ones were overwritten
+  taskENTER_CRITICAL();
+  stats_pending = display_handler->stats_pending;
+  stats = display_handler->stats;
+  display_handler->stats_pending = false;
+  taskEXIT_CRITICAL();
+
+  if (!stats_pending) {
+    return false;
+  }
+
+  snprintf(line, line_size, "registration: %d", stats.is_registered);
+  line += line_size;
+  snprintf(line, line_size, "time sync: %d", stats.is_time_synced);
+  line += line_size;
+  snprintf(line, line_size, "link type: %d", stats.link);
+  line += line_size;
+  snprintf(line, line_size, "tx id: %d", stats.last_successful_tx_seq_num);
+  return true;
+}
+
+static void handle_normal_msg(display_t *display_handler, const char *text, size_t text_len)
 {
   uint16_t msg_ix = 0;
-  int16_t msg_len = strlen(message->text);
+  int16_t msg_len = text_len;
   int16_t current_line = SL_SIDEWALK_DISPLAY_MESSAGE_START_LINE;
 
   // Clear the display handler buffer first
   for (uint8_t start_line = SL_SIDEWALK_DISPLAY_MESSAGE_START_LINE; start_line < SL_SIDEWALK_DISPLAY_STATUS_START_LINE; start_line++) {
-    memset(&display_handler->buffer[start_line][0], 0, SL_SIDEWALK_DISPLAY_CHAR_W_PX);
+    memset(&display_handler->buffer[start_line][0], 0, sizeof(display_handler->buffer[0]));
   }
 
   // Put the meassage into the display buffer line by line, until the whole message is buffered or all lines are full
   while (msg_len > 0) {
     uint16_t chunk_to_copy = (msg_len >= SL_SIDEWALK_DISPLAY_CHAR_W_PX) ? SL_SIDEWALK_DISPLAY_CHAR_W_PX : msg_len;
 
-    memcpy(&display_handler->buffer[current_line][0], &message->text[msg_ix], chunk_to_copy);
+    memcpy(&display_handler->buffer[current_line][0], &text[msg_ix], chunk_to_copy);
     msg_ix += chunk_to_copy;
     msg_len -= chunk_to_copy;
 
@@ -265,12 +459,19 @@ static void handle_normal_msg(display_t *display_handler, sl_sidewalk_display_ms
   }
 }
 
-static void handle_qr_msg(display_t *display_handler, sl_sidewalk_display_msg_t *message)
+static void handle_qr_msg(display_t *display_handler)
 {
-  // Too big for stack, we place it to heap.
-  static sli_sidewalk_qr_code_qr_t qr;
-  memset(&qr, 0, sizeof(sli_sidewalk_qr_code_qr_t));
+  const sli_sidewalk_qr_code_bitmap_t *qr = sli_sidewalk_qr_code_get_bitmap(display_handler->qr_text);
 
-  sli_sidewalk_qr_code_create_qr_from_str(&qr, message->text);
-  draw_qr(display_handler, &qr);
+  if (qr == NULL || qr->width > SL_SIDEWALK_DISPLAY_W_PX) {
+    return;
+  }
+
+  // The cached bitmap is copied straight into frame buffers with the 1 bpp
+  // row layout the shadow is kept for, other layouts are drawn through GLIB
+  if (display_handler->diff_flush) {
+    blit_qr(display_handler, qr);
+  } else {
+    draw_qr(display_handler, qr);
+  }
 }
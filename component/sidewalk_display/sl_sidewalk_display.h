@@ -69,16 +69,21 @@
 void sl_sidewalk_display_init(void);
 
 /**************************************************************************//**
- * Getting the next received and queued message and displaying it.
+ * Getting the queued messages and the latest statistics and displaying them.
  *
- * This function is a dispatcher which calls further display handlers based on
- * the message type and also GLIB and DMD functions.
+ * All pending messages are applied before the screen is rendered once. Only
+ * the changed text lines are redrawn and only the changed pixel rows are sent
+ * to the memory LCD.
  *****************************************************************************/
 void sl_sidewalk_display_update(void);
 
 /**************************************************************************//**
- * This function puts the incoming statistic data to a message with a matching
- * type and queues the message for future display.
+ * This function stores the incoming statistic data for future display.
+ *
+ * Consecutive calls before the next update overwrite each other, only the
+ * latest statistics are displayed.
+ * They take the place of the first call in the message order, so a QR code
+ * queued after it stays on screen while one queued before it is replaced.
  *
  * @param statistics Statistic data (registration, time sync, etc.) to be
  *                   displayed
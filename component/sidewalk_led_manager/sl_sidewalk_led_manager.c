@@ -31,27 +31,121 @@
 // -----------------------------------------------------------------------------
 //                                   Includes
 // -----------------------------------------------------------------------------
+#include <stddef.h>
 #include "sl_sidewalk_led_manager.h"
 #include "sl_common.h"
 #include "app_log.h"
 #include "sl_simple_led_instances.h"
+#include "sl_sleeptimer.h"
+#include "em_core.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+typedef struct {
+  const sl_sidewalk_led_pattern_t *pattern;
+  sl_sleeptimer_timer_handle_t timer;
+  uint8_t step;
+  uint8_t iteration;
+  // storage of the pattern built by sl_sidewalk_led_manager_blink
+  sl_sidewalk_led_step_t blink_steps[2];
+  sl_sidewalk_led_pattern_t blink_pattern;
+#if defined(SL_CATALOG_PWM_PRESENT)
+  sl_pwm_instance_t *pwm;
+  bool pwm_running;
+#endif
+} led_pattern_ctx_t;
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+/*******************************************************************************
+ * Set the brightness of a led, through its pwm if one is bound
+ *
+ * @param led_id Led ID
+ * @param level Brightness in percent
+ ******************************************************************************/
+static void led_apply_level(uint8_t led_id, uint8_t level);
+
+/*******************************************************************************
+ * Apply the current step of a led pattern and arm the timer for its end
+ *
+ * @param led_id Led ID
+ ******************************************************************************/
+static void led_run_step(uint8_t led_id);
+
+/*******************************************************************************
+ * Sleeptimer callback moving a led pattern to its next step
+ *
+ * @param handle Timer handle
+ * @param data Led ID
+ ******************************************************************************/
+static void led_pattern_timer_cb(sl_sleeptimer_timer_handle_t *handle, void *data);
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
 
+static const sl_sidewalk_led_step_t heartbeat_steps[] = {
+  { .duration_ms = 100, .level = SL_SIDEWALK_LED_LEVEL_ON },
+  { .duration_ms = 150, .level = SL_SIDEWALK_LED_LEVEL_OFF },
+  { .duration_ms = 100, .level = SL_SIDEWALK_LED_LEVEL_ON },
+  { .duration_ms = 1650, .level = SL_SIDEWALK_LED_LEVEL_OFF },
+};
+
+static const sl_sidewalk_led_step_t blink_slow_steps[] = {
+  { .duration_ms = 1000, .level = SL_SIDEWALK_LED_LEVEL_ON },
+  { .duration_ms = 1000, .level = SL_SIDEWALK_LED_LEVEL_OFF },
+};
+
+static const sl_sidewalk_led_step_t blink_fast_steps[] = {
+  { .duration_ms = 200, .level = SL_SIDEWALK_LED_LEVEL_ON },
+  { .duration_ms = 200, .level = SL_SIDEWALK_LED_LEVEL_OFF },
+};
+
+static const sl_sidewalk_led_step_t breathe_steps[] = {
+  { .duration_ms = 150, .level = 10 },
+  { .duration_ms = 150, .level = 30 },
+  { .duration_ms = 150, .level = 60 },
+  { .duration_ms = 300, .level = SL_SIDEWALK_LED_LEVEL_ON },
+  { .duration_ms = 150, .level = 60 },
+  { .duration_ms = 150, .level = 30 },
+  { .duration_ms = 150, .level = 10 },
+  { .duration_ms = 600, .level = SL_SIDEWALK_LED_LEVEL_OFF },
+};
+
+const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_heartbeat = {
+  .steps = heartbeat_steps,
+  .step_count = sizeof(heartbeat_steps) / sizeof(heartbeat_steps[0]),
+  .repeat = SL_SIDEWALK_LED_REPEAT_FOREVER,
+};
+
+const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_blink_slow = {
+  .steps = blink_slow_steps,
+  .step_count = sizeof(blink_slow_steps) / sizeof(blink_slow_steps[0]),
+  .repeat = SL_SIDEWALK_LED_REPEAT_FOREVER,
+};
+
+const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_blink_fast = {
+  .steps = blink_fast_steps,
+  .step_count = sizeof(blink_fast_steps) / sizeof(blink_fast_steps[0]),
+  .repeat = SL_SIDEWALK_LED_REPEAT_FOREVER,
+};
+
+const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_breathe = {
+  .steps = breathe_steps,
+  .step_count = sizeof(breathe_steps) / sizeof(breathe_steps[0]),
+  .repeat = SL_SIDEWALK_LED_REPEAT_FOREVER,
+};
+
 // -----------------------------------------------------------------------------
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
+static led_pattern_ctx_t led_ctx[SL_SIMPLE_LED_COUNT];
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -84,6 +178,90 @@ void sl_sidewalk_led_manager_toggle_led(uint8_t led_id)
   sl_sidewalk_led_manager_led_state_changed(led_id, new_led_state);
 }
 
+sl_status_t sl_sidewalk_led_manager_play(uint8_t led_id, const sl_sidewalk_led_pattern_t *pattern)
+{
+  if (led_id > SL_SIMPLE_LED_COUNT - 1) {
+    app_log_error("app: led %d does not exist", led_id);
+    return SL_STATUS_INVALID_INDEX;
+  }
+
+  if (pattern == NULL || pattern->steps == NULL || pattern->step_count == 0) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  led_pattern_ctx_t *ctx = &led_ctx[led_id];
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  (void)sl_sleeptimer_stop_timer(&ctx->timer);
+  ctx->pattern = pattern;
+  ctx->step = 0;
+  ctx->iteration = 0;
+  led_run_step(led_id);
+  CORE_EXIT_ATOMIC();
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_sidewalk_led_manager_blink(uint8_t led_id, uint8_t count, uint16_t on_ms, uint16_t off_ms)
+{
+  if (led_id > SL_SIMPLE_LED_COUNT - 1) {
+    app_log_error("app: led %d does not exist", led_id);
+    return SL_STATUS_INVALID_INDEX;
+  }
+
+  if (on_ms == 0 || off_ms == 0) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  led_pattern_ctx_t *ctx = &led_ctx[led_id];
+
+  // The blink storage may be in use by the pattern playing, stop it first
+  sl_sidewalk_led_manager_stop(led_id);
+
+  ctx->blink_steps[0].duration_ms = on_ms;
+  ctx->blink_steps[0].level = SL_SIDEWALK_LED_LEVEL_ON;
+  ctx->blink_steps[1].duration_ms = off_ms;
+  ctx->blink_steps[1].level = SL_SIDEWALK_LED_LEVEL_OFF;
+  ctx->blink_pattern.steps = ctx->blink_steps;
+  ctx->blink_pattern.step_count = 2;
+  ctx->blink_pattern.repeat = count;
+
+  return sl_sidewalk_led_manager_play(led_id, &ctx->blink_pattern);
+}
+
+void sl_sidewalk_led_manager_stop(uint8_t led_id)
+{
+  if (led_id > SL_SIMPLE_LED_COUNT - 1) {
+    app_log_error("app: led %d does not exist", led_id);
+    return;
+  }
+
+  led_pattern_ctx_t *ctx = &led_ctx[led_id];
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  (void)sl_sleeptimer_stop_timer(&ctx->timer);
+  ctx->pattern = NULL;
+  led_apply_level(led_id, SL_SIDEWALK_LED_LEVEL_OFF);
+  CORE_EXIT_ATOMIC();
+}
+
+#if defined(SL_CATALOG_PWM_PRESENT)
+sl_status_t sl_sidewalk_led_manager_set_pwm(uint8_t led_id, sl_pwm_instance_t *pwm)
+{
+  if (led_id > SL_SIMPLE_LED_COUNT - 1) {
+    app_log_error("app: led %d does not exist", led_id);
+    return SL_STATUS_INVALID_INDEX;
+  }
+
+  sl_sidewalk_led_manager_stop(led_id);
+  led_ctx[led_id].pwm = pwm;
+
+  return SL_STATUS_OK;
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // Weak implementation of Callbacks                                           //
 ////////////////////////////////////////////////////////////////////////////////
@@ -92,3 +270,86 @@ SL_WEAK void sl_sidewalk_led_manager_led_state_changed(uint8_t led_id, sl_led_st
   (void)led_id;
   (void)new_led_state;
 }
+
+SL_WEAK void sl_sidewalk_led_manager_pattern_done(uint8_t led_id)
+{
+  (void)led_id;
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+static void led_apply_level(uint8_t led_id, uint8_t level)
+{
+  const sl_led_t *l = SL_SIMPLE_LED_INSTANCE(led_id);
+
+#if defined(SL_CATALOG_PWM_PRESENT)
+  led_pattern_ctx_t *ctx = &led_ctx[led_id];
+
+  if (ctx->pwm != NULL) {
+    if (level > SL_SIDEWALK_LED_LEVEL_OFF && level < SL_SIDEWALK_LED_LEVEL_ON) {
+      sl_pwm_set_duty_cycle(ctx->pwm, level);
+      if (!ctx->pwm_running) {
+        sl_pwm_start(ctx->pwm);
+        ctx->pwm_running = true;
+      }
+      return;
+    }
+    // Full on and off need no pwm, stop it to allow EM2
+    if (ctx->pwm_running) {
+      sl_pwm_stop(ctx->pwm);
+      ctx->pwm_running = false;
+    }
+  }
+#endif
+
+  if (level > SL_SIDEWALK_LED_LEVEL_OFF) {
+    sl_led_turn_on(l);
+  } else {
+    sl_led_turn_off(l);
+  }
+}
+
+static void led_run_step(uint8_t led_id)
+{
+  led_pattern_ctx_t *ctx = &led_ctx[led_id];
+  const sl_sidewalk_led_step_t *step = &ctx->pattern->steps[ctx->step];
+
+  led_apply_level(led_id, step->level);
+
+  if (step->duration_ms != SL_SIDEWALK_LED_HOLD) {
+    (void)sl_sleeptimer_start_timer_ms(&ctx->timer,
+                                       step->duration_ms,
+                                       led_pattern_timer_cb,
+                                       (void *)(uintptr_t)led_id,
+                                       0,
+                                       0);
+  }
+}
+
+static void led_pattern_timer_cb(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  (void)handle;
+  uint8_t led_id = (uint8_t)(uintptr_t)data;
+  led_pattern_ctx_t *ctx = &led_ctx[led_id];
+
+  if (ctx->pattern == NULL) {
+    return;
+  }
+
+  ctx->step++;
+  if (ctx->step >= ctx->pattern->step_count) {
+    ctx->step = 0;
+    ctx->iteration++;
+    if (ctx->pattern->repeat != SL_SIDEWALK_LED_REPEAT_FOREVER
+        && ctx->iteration >= ctx->pattern->repeat) {
+      ctx->pattern = NULL;
+      led_apply_level(led_id, SL_SIDEWALK_LED_LEVEL_OFF);
+      sl_sidewalk_led_manager_pattern_done(led_id);
+      return;
+    }
+  }
+
+  led_run_step(led_id);
+}
@@ -38,12 +38,50 @@ extern "C" {
 // -----------------------------------------------------------------------------
 //                                   Includes
 // -----------------------------------------------------------------------------
+#include <stdint.h>
+#include "sl_status.h"
 #include "sl_led.h"
+#include "sl_component_catalog.h"
+#if defined(SL_CATALOG_PWM_PRESENT)
+#include "sl_pwm.h"
+#endif
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+// Brightness of a pattern step in percent
+#define SL_SIDEWALK_LED_LEVEL_OFF     0
+#define SL_SIDEWALK_LED_LEVEL_ON      100
+
+// Step duration which holds the step level until the pattern is stopped
+#define SL_SIDEWALK_LED_HOLD          0
+
+// Pattern repeat count which repeats the pattern until it is stopped
+#define SL_SIDEWALK_LED_REPEAT_FOREVER 0
+
+/// One step of a led pattern
+typedef struct {
+  uint16_t duration_ms; ///< time the level is kept, SL_SIDEWALK_LED_HOLD to keep it
+  uint8_t level;        ///< brightness in percent, any non zero level is on without pwm
+} sl_sidewalk_led_step_t;
+
+/// Declarative led pattern, the steps are played in order repeat times
+typedef struct {
+  const sl_sidewalk_led_step_t *steps;
+  uint8_t step_count;
+  uint8_t repeat;       ///< SL_SIDEWALK_LED_REPEAT_FOREVER to loop until stopped
+} sl_sidewalk_led_pattern_t;
+
+/// Two short pulses followed by a pause, repeated until stopped
+extern const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_heartbeat;
+/// Slow on/off blinking, repeated until stopped
+extern const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_blink_slow;
+/// Fast on/off blinking, repeated until stopped
+extern const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_blink_fast;
+/// Ramps the brightness up and down, needs a pwm bound to the led
+extern const sl_sidewalk_led_pattern_t sl_sidewalk_led_pattern_breathe;
+
 // -----------------------------------------------------------------------------
 //                          Public Function Declarations
 // -----------------------------------------------------------------------------
@@ -63,6 +101,56 @@ void sl_sidewalk_led_manager_toggle_led(uint8_t led_id);
  *****************************************************************************/
 void sl_sidewalk_led_manager_led_state_changed(uint8_t led_id, sl_led_state_t new_led_state);
 
+/**************************************************************************//**
+ * Play a pattern on a led, replacing the pattern currently playing. Steps are
+ * timed by the sleeptimer and applied from its interrupt, so the pattern runs
+ * without waking any task and the device stays in EM2 between steps.
+ *
+ * @param led_id Led ID
+ * @param pattern Pattern to play, must stay valid while it is playing
+ * @return SL_STATUS_OK on success
+ *****************************************************************************/
+sl_status_t sl_sidewalk_led_manager_play(uint8_t led_id, const sl_sidewalk_led_pattern_t *pattern);
+
+/**************************************************************************//**
+ * Blink a led count times
+ *
+ * @param led_id Led ID
+ * @param count Number of blinks, SL_SIDEWALK_LED_REPEAT_FOREVER to blink until stopped
+ * @param on_ms On time of a blink
+ * @param off_ms Off time of a blink
+ * @return SL_STATUS_OK on success
+ *****************************************************************************/
+sl_status_t sl_sidewalk_led_manager_blink(uint8_t led_id, uint8_t count, uint16_t on_ms, uint16_t off_ms);
+
+/**************************************************************************//**
+ * Stop the pattern playing on a led and turn the led off
+ *
+ * @param led_id Led ID
+ *****************************************************************************/
+void sl_sidewalk_led_manager_stop(uint8_t led_id);
+
+#if defined(SL_CATALOG_PWM_PRESENT)
+/**************************************************************************//**
+ * Drive a led through a pwm instance so pattern levels dim it. The pwm
+ * timer keeps the device in EM1 while the led is dimmed, full on and off
+ * levels stop the pwm.
+ *
+ * @param led_id Led ID
+ * @param pwm Pwm instance driving the led pin, NULL to go back to on/off
+ * @return SL_STATUS_OK on success
+ *****************************************************************************/
+sl_status_t sl_sidewalk_led_manager_set_pwm(uint8_t led_id, sl_pwm_instance_t *pwm);
+#endif
+
+/**************************************************************************//**
+ * Callback called from interrupt context when a pattern with a finite repeat
+ * count has completed
+ *
+ * @param led_id Led ID
+ *****************************************************************************/
+void sl_sidewalk_led_manager_pattern_done(uint8_t led_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -83,7 +83,9 @@ void sl_sidewalk_nvm3_handler_init(void)
   // Open nvm3 part for read/write
   if (nvm3_open(nvm3_defaultHandle, nvm3_defaultInit) != ECODE_NVM3_OK) {
     app_log_warning("NVM3 init failed");
+    return;
   }
+  sli_sid_nvm3_init();
 }
 
 /*******************************************************************************
@@ -101,19 +103,12 @@ int32_t sl_sidewalk_nvm3_write(uint32_t value,
 {
   RETURN_ERR_IF_KEY_NOT_IN_RANGE(value);
 
-  Ecode_t status = nvm3_writeData(nvm3_defaultHandle, value, buffer, (size_t)length);
+  // Repacking is scheduled by the nvm3 manager
+  Ecode_t status = sli_sid_nvm3_write(value, buffer, (size_t)length);
   if (status != ECODE_NVM3_OK) {
     return SL_SIDEWALK_NVM3_DATA_WRITE_FAILED;
   }
 
-  // Do repacking if needed
-  if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-    status = nvm3_repack(nvm3_defaultHandle);
-    if (status != ECODE_NVM3_OK) {
-      return SL_SIDEWALK_NVM3_DATA_REPACK_FAILED;
-    }
-  }
-
   return 0;
 }
 
@@ -55,7 +55,7 @@ enum sl_sidewalk_nvm3_hdl_error_status {
   SL_SIDEWALK_NVM3_SUCCESS = 0,
   SL_SIDEWALK_NVM3_DATA_READ_FAILED = -1,
   SL_SIDEWALK_NVM3_DATA_WRITE_FAILED = -2,
-  SL_SIDEWALK_NVM3_DATA_REPACK_FAILED = -3,
+  // -3 is no longer used, repacks are run by the nvm3 manager
   SL_SIDEWALK_NVM3_GET_OBJECT_INFO_FAILED = -4,
   SL_SIDEWALK_NVM3_INVALID_KEY_SPACE_REGION = -5
 };
@@ -76,6 +76,10 @@ void sl_sidewalk_nvm3_handler_init(void);
 /*******************************************************************************
  * Write NVM3 object
  *
+ * Keys have to be in SLI_SID_NVM3_KEY_MIN_APP - SLI_SID_NVM3_KEY_MAX_APP
+ * (0xA0000 - 0xA1DFF), other keys are rejected with
+ * SL_SIDEWALK_NVM3_INVALID_KEY_SPACE_REGION.
+ *
  *  @param[in]  value   A 20-bit object identifier
  *  @param[in]  buffer  Buffer containing the value to be stored
  *  @param[in]  length  Length of the value in bytes
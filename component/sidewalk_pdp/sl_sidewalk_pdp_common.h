@@ -60,6 +60,8 @@ typedef enum {
   SL_SID_PDP_CMD_ON_DEV_CERT_GEN_WRITE_CERT_CHAIN = 5,
   SL_SID_PDP_CMD_ON_DEV_CERT_GEN_WRITE_APP_KEY = 6,
   SL_SID_PDP_CMD_ON_DEV_CERT_GEN_COMMIT = 7,
+  // Several of the above commands in one packet
+  SL_SID_PDP_CMD_BATCH = 8,
   // Unknown commands
   SL_SID_PDP_CMD_UNKNOWN
 } sl_sid_pdp_cmd_t;
@@ -75,8 +77,8 @@ typedef enum {
   // Silabs platform related status
   SL_SID_PDP_STATUS_ERR_NVM3_OPEN,
   SL_SID_PDP_STATUS_ERR_NVM3_WRITE,
-  SL_SID_PDP_STATUS_ERR_NVM3_REPACK,
-  SL_SID_PDP_STATUS_ERR_NVM3_CLOSE,
+  // The value after NVM3_WRITE reported repack errors, kept free for the host tools
+  SL_SID_PDP_STATUS_ERR_NVM3_CLOSE = SL_SID_PDP_STATUS_ERR_NVM3_WRITE + 2,
   SL_SID_PDP_STATUS_ERR_PSA_CRYPTO_INIT,
   SL_SID_PDP_STATUS_ERR_PSA_IMPORT_KEY,
   SL_SID_PDP_STATUS_ERR_PSA_SIGN_MESSAGE,
@@ -86,7 +88,11 @@ typedef enum {
   SL_SID_PDP_STATUS_ERR_ON_DEV_CERT_GEN_GEN_CSR,
   SL_SID_PDP_STATUS_ERR_ON_DEV_CERT_GEN_WRITE_CERT_CHAIN,
   SL_SID_PDP_STATUS_ERR_ON_DEV_CERT_GEN_WRITE_APP_KEY,
-  SL_SID_PDP_STATUS_ERR_ON_DEV_CERT_GEN_COMMIT
+  SL_SID_PDP_STATUS_ERR_ON_DEV_CERT_GEN_COMMIT,
+  // Batch status
+  SL_SID_PDP_STATUS_ERR_BATCH_MALFORMED,
+  SL_SID_PDP_STATUS_ERR_BATCH_NESTED,
+  SL_SID_PDP_STATUS_ERR_BATCH_RSP_TOO_BIG
 } sl_sid_pdp_status_t;
 
 #endif // SL_PDP_SIDEWALK_COMMON_H
@@ -75,3 +75,43 @@ sl_sid_pdp_status_t sl_sid_pdp_parse_req_packet(const uint8_t * const in, uint16
 
   return SL_SID_PDP_STATUS_SUCCESS;
 }
+
+sl_sid_pdp_status_t sl_sid_pdp_parse_batch_req(const uint8_t * const in, uint16_t in_len, uint16_t * const offset, const uint8_t **out, uint16_t * const out_len, uint8_t * const cmd)
+{
+  if (in == NULL || offset == NULL) {
+    return SL_SID_PDP_STATUS_ERR_IN_ARGS_NOT_VALID;
+  }
+
+  if (out == NULL || out_len == NULL || cmd == NULL) {
+    return SL_SID_PDP_STATUS_ERR_OUT_ARGS_NOT_VALID;
+  }
+
+  uint16_t idx = *offset;
+  uint16_t cmd_val;
+  uint16_t data_len;
+
+  // requests are not aligned inside the batch
+  if (idx > in_len || (in_len - idx) < SL_SID_PDP_MIN_REQ_PACKET_LEN) {
+    return SL_SID_PDP_STATUS_ERR_BATCH_MALFORMED;
+  }
+
+  memcpy(&cmd_val, &in[idx], sizeof(uint16_t));
+  idx += sizeof(uint16_t);
+  memcpy(&data_len, &in[idx], sizeof(uint16_t));
+  idx += sizeof(uint16_t);
+
+  if ((in_len - idx) < data_len) {
+    return SL_SID_PDP_STATUS_ERR_BATCH_MALFORMED;
+  }
+
+  if (cmd_val >= SL_SID_PDP_CMD_UNKNOWN) {
+    return SL_SID_PDP_STATUS_ERR_CMD_UNKNOWN;
+  }
+
+  *cmd = (uint8_t)cmd_val;
+  *out_len = data_len;
+  *out = &in[idx];
+  *offset = idx + data_len;
+
+  return SL_SID_PDP_STATUS_SUCCESS;
+}
@@ -51,6 +51,11 @@
 
 #define SL_SID_PDP_MIN_REQ_PACKET_LEN (4)
 
+// Batch response data: 2-byte length of the entries, then one entry per
+// processed request made of a 4-byte status, a 2-byte data length and the data
+#define SL_SID_PDP_BATCH_RSP_HDR_LEN (2)
+#define SL_SID_PDP_BATCH_RSP_ENTRY_HDR_LEN (6)
+
 typedef struct {
   uint16_t cmd;
   uint16_t data_len;
@@ -83,4 +88,27 @@ typedef struct {
  ******************************************************************************/
 sl_sid_pdp_status_t sl_sid_pdp_parse_req_packet(const uint8_t * const in, uint16_t in_len, const uint8_t **out, uint16_t * const out_len, uint8_t * const cmd);
 
+/***************************************************************************//**
+ * @brief Parses the next request of a batch.
+ *
+ * A batch request carries the same cmd, data_len and data fields as a single
+ * request, back to back. Unlike a single request, the data length is checked
+ * against the remaining length of the batch.
+ *
+ * @param[in] in Batch request data
+ * @param[in] in_len Length of the batch request data
+ * @param[in,out] offset Offset of the next request, advanced past it on success
+ * @param[out] out Request buffer
+ * @param[out] out_len Length of the request
+ * @param[out] cmd Command
+ *
+ * @return Status code
+ * @retval SL_SID_PDP_STATUS_ERR_IN_ARGS_NOT_VALID One or more input arguments are not valid
+ * @retval SL_SID_PDP_STATUS_ERR_OUT_ARGS_NOT_VALID One or more output arguments are not valid
+ * @retval SL_SID_PDP_STATUS_ERR_BATCH_MALFORMED Request does not fit in the batch
+ * @retval SL_SID_PDP_STATUS_ERR_CMD_UNKNOWN Command is not defined
+ * @retval SL_SID_PDP_STATUS_SUCCESS Success
+ ******************************************************************************/
+sl_sid_pdp_status_t sl_sid_pdp_parse_batch_req(const uint8_t * const in, uint16_t in_len, uint16_t * const offset, const uint8_t **out, uint16_t * const out_len, uint8_t * const cmd);
+
 #endif // SL_SIDEWALK_PDP_PARSER_H
@@ -45,6 +45,7 @@
 #include <string.h>
 #include "nvm3.h"
 #include "nvm3_hal_flash.h"
+#include "nvm3_manager.h"
 #include "sl_sidewalk_pdp_priv_key_prov.h"
 #include "psa/crypto.h"
 
@@ -71,19 +72,13 @@ sl_sid_pdp_status_t sl_sid_pdp_priv_key_prov_write_nvm3(const uint8_t * const in
   sl_sid_pdp_priv_key_prov_write_nvm3_req_t req = *(sl_sid_pdp_priv_key_prov_write_nvm3_req_t *)in;
   req.data = &in[(SL_SID_PDP_PRIV_KEY_PROV_MIN_WRITE_NVM3_REQ_LEN - 1)];
 
-  ret = nvm3_writeData(nvm3_defaultHandle, req.key, req.data, req.data_len);
+  // Repack is scheduled by the nvm3 manager
+  ret = sli_sid_nvm3_write(req.key, req.data, req.data_len);
 
   if (ret != ECODE_NVM3_OK) {
     return SL_SID_PDP_STATUS_ERR_NVM3_WRITE;
   }
 
-  if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-    ret = nvm3_repack(nvm3_defaultHandle);
-    if (ret != ECODE_NVM3_OK) {
-      return SL_SID_PDP_STATUS_ERR_NVM3_REPACK;
-    }
-  }
-
   return SL_SID_PDP_STATUS_SUCCESS;
 }
 
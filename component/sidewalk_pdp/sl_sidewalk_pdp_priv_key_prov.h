@@ -105,7 +105,6 @@ SL_PACK_END()
  * @retval SL_SID_PDP_STATUS_ERR_IN_ARGS_NOT_VALID One or more input arguments are not valid
  * @retval SL_SID_PDP_STATUS_ERR_NVM3_OPEN NVM3 open failed
  * @retval SL_SID_PDP_STATUS_ERR_NVM3_WRITE NVM3 write failed
- * @retval SL_SID_PDP_STATUS_ERR_NVM3_REPACK NVM3 repack failed
  * @retval SL_SID_PDP_STATUS_ERR_NVM3_CLOSE NVM3 close failed
  * @retval SL_SID_PDP_STATUS_SUCCESS Success
  ******************************************************************************/
@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ * @file
+ * @brief Sidewalk QR code component configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2022 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SIDEWALK_QR_CODE_CONFIG_H
+#define SL_SIDEWALK_QR_CODE_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h> Sidewalk QR code cache configuration
+
+// <o> SL_SIDEWALK_QR_CODE_CACHE_SIZE <1-8>
+// <i> Number of encoded QR codes kept in RAM
+// <i> Default: 1
+// <d> 1
+#ifndef SL_SIDEWALK_QR_CODE_CACHE_SIZE
+#define SL_SIDEWALK_QR_CODE_CACHE_SIZE 1
+#endif
+
+// <o> SL_SIDEWALK_QR_CODE_CACHE_TEXT_LEN_MAX <1-512>
+// <i> Longest string that can be cached, longer strings are not encoded
+// <i> Default: 128
+// <d> 128
+#ifndef SL_SIDEWALK_QR_CODE_CACHE_TEXT_LEN_MAX
+#define SL_SIDEWALK_QR_CODE_CACHE_TEXT_LEN_MAX 128
+#endif
+
+// <o> SL_SIDEWALK_QR_CODE_CACHE_VERSION_MAX <1-40>
+// <i> Highest QR version that can be cached, sets the bitmap and encoder buffer sizes
+// <i> Default: 10
+// <d> 10
+#ifndef SL_SIDEWALK_QR_CODE_CACHE_VERSION_MAX
+#define SL_SIDEWALK_QR_CODE_CACHE_VERSION_MAX 10
+#endif
+
+// <q> SL_SIDEWALK_QR_CODE_CACHE_NVM3_ENABLE
+// <i> Persist the cached QR codes in NVM3 so that they survive a reset
+// <i> Default: 0
+// <d> 0
+#ifndef SL_SIDEWALK_QR_CODE_CACHE_NVM3_ENABLE
+#define SL_SIDEWALK_QR_CODE_CACHE_NVM3_ENABLE 0
+#endif
+
+// NVM3 key of the first cache entry, entry N is stored at key + N. The keys
+// have to stay inside the QR code cache allocation of the PAL NVM3 range,
+// SLI_SID_NVM3_PAL_KEY_QR_CODE_CACHE in nvm3_manager.h (0xA1F00 - 0xA1FFF).
+#ifndef SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY
+#define SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY (SLI_SID_NVM3_KEY_BASE_PAL + SLI_SID_NVM3_PAL_KEY_QR_CODE_CACHE)
+#endif
+
+// </h>
+
+// <<< end of configuration section >>>
+
+#endif // SL_SIDEWALK_QR_CODE_CONFIG_H
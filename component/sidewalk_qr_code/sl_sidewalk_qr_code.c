@@ -39,17 +39,46 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 
+#include <string.h>
+
 #include "sli_sidewalk_qr_code.h"
+#include "sl_sidewalk_qr_code_config.h"
+
+#if SL_SIDEWALK_QR_CODE_CACHE_NVM3_ENABLE
+#include "nvm3_default.h"
+#include "nvm3_manager.h"
+
+// The cache has to stay inside the keys the PAL range allocates to it
+#define QR_CACHE_NVM3_KEY_MIN (SLI_SID_NVM3_KEY_BASE_PAL + SLI_SID_NVM3_PAL_KEY_QR_CODE_CACHE)
+#define QR_CACHE_NVM3_KEY_END (QR_CACHE_NVM3_KEY_MIN + SLI_SID_NVM3_PAL_KEY_QR_CODE_CACHE_COUNT)
+#if (SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY < QR_CACHE_NVM3_KEY_MIN) \
+  || (SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY + SL_SIDEWALK_QR_CODE_CACHE_SIZE > QR_CACHE_NVM3_KEY_END)
+#error "SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY is outside of the QR code cache NVM3 keys"
+#endif
+#endif
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+#define QR_CACHE_BUFFER_LEN qrcodegen_BUFFER_LEN_FOR_VERSION(SL_SIDEWALK_QR_CODE_CACHE_VERSION_MAX)
+
+// Stored as is in NVM3 when persistence is enabled
+typedef struct {
+  uint16_t text_len;
+  char text[SL_SIDEWALK_QR_CODE_CACHE_TEXT_LEN_MAX];
+  sli_sidewalk_qr_code_bitmap_t qr;
+} qr_cache_entry_t;
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
-static void generate_qr_code(uint8_t *qr_buffer, char *text_to_encode);
+static bool generate_qr_bitmap(sli_sidewalk_qr_code_bitmap_t *qr, const char *text_to_encode);
+static int8_t cache_lookup(const char *string, size_t string_len);
+static uint8_t cache_victim(void);
+static void cache_load(void);
+static void cache_store(uint8_t index);
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
@@ -59,44 +88,165 @@ static void generate_qr_code(uint8_t *qr_buffer, char *text_to_encode);
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
+static qr_cache_entry_t qr_cache[SL_SIDEWALK_QR_CODE_CACHE_SIZE];
+// Use order of the cache entries, 0 marks an empty entry
+static uint32_t qr_cache_last_use[SL_SIDEWALK_QR_CODE_CACHE_SIZE];
+static uint32_t qr_cache_use_counter;
+static bool qr_cache_loaded;
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
 
-void sli_sidewalk_qr_code_create_qr_from_str(sli_sidewalk_qr_code_qr_t *qr_buffer, char *string)
+const sli_sidewalk_qr_code_bitmap_t *sli_sidewalk_qr_code_get_bitmap(const char *string)
 {
-  if (qr_buffer != NULL && string != NULL) {
-    generate_qr_code(qr_buffer->buffer, string);
-    qr_buffer->width = qrcodegen_getSize(qr_buffer->buffer);
+  size_t string_len;
+  int8_t index;
+
+  if (string == NULL) {
+    return NULL;
   }
-}
 
-bool sli_sidewalk_qr_code_is_module_pixel_dark(sli_sidewalk_qr_code_qr_t *qr_buffer, uint8_t x, uint8_t y)
-{
-  if (qr_buffer != NULL) {
-    if (true == qrcodegen_getModule(qr_buffer->buffer, x, y)) {
-      return true;
+  string_len = strlen(string);
+  if (string_len > SL_SIDEWALK_QR_CODE_CACHE_TEXT_LEN_MAX) {
+    return NULL;
+  }
+
+  if (!qr_cache_loaded) {
+    cache_load();
+    qr_cache_loaded = true;
+  }
+
+  index = cache_lookup(string, string_len);
+  if (index < 0) {
+    // Only a miss runs the encoder and its mask selection, the victim is
+    // left intact when encoding fails since the bitmap is written on success only
+    index = cache_victim();
+    if (!generate_qr_bitmap(&qr_cache[index].qr, string)) {
+      return NULL;
     }
+    qr_cache[index].text_len = string_len;
+    memset(qr_cache[index].text, 0, sizeof(qr_cache[index].text));
+    memcpy(qr_cache[index].text, string, string_len);
+    cache_store(index);
   }
 
-  return false;
+  qr_cache_last_use[index] = ++qr_cache_use_counter;
+  return &qr_cache[index].qr;
+}
+
+void sli_sidewalk_qr_code_clear_cache(void)
+{
+  for (uint8_t index = 0; index < SL_SIDEWALK_QR_CODE_CACHE_SIZE; index++) {
+    qr_cache_last_use[index] = 0;
+#if SL_SIDEWALK_QR_CODE_CACHE_NVM3_ENABLE
+    (void)nvm3_deleteObject(nvm3_defaultHandle, SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY + index);
+#endif
+  }
+  qr_cache_loaded = true;
 }
 
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
-static void generate_qr_code(uint8_t *qr_buffer, char *text_to_encode)
+static bool generate_qr_bitmap(sli_sidewalk_qr_code_bitmap_t *qr, const char *text_to_encode)
 {
   /* Too big for the stack, that is why it is static*/
-  static uint8_t qr_code_tmp[qrcodegen_BUFFER_LEN_MAX];
-
-  qrcodegen_encodeText(text_to_encode,
-                       qr_code_tmp,
-                       qr_buffer,
-                       qrcodegen_Ecc_LOW,
-                       qrcodegen_VERSION_MIN,
-                       qrcodegen_VERSION_MAX,
-                       qrcodegen_Mask_AUTO,
-                       true);
+  static uint8_t qr_code_tmp[QR_CACHE_BUFFER_LEN];
+  static uint8_t qr_code[QR_CACHE_BUFFER_LEN];
+
+  if (!qrcodegen_encodeText(text_to_encode,
+                            qr_code_tmp,
+                            qr_code,
+                            qrcodegen_Ecc_LOW,
+                            qrcodegen_VERSION_MIN,
+                            SL_SIDEWALK_QR_CODE_CACHE_VERSION_MAX,
+                            qrcodegen_Mask_AUTO,
+                            true)) {
+    return false;
+  }
+
+  qr->width = qrcodegen_getSize(qr_code);
+  qr->row_bytes = (qr->width + 7) / 8;
+  memset(qr->bitmap, 0, sizeof(qr->bitmap));
+
+  for (uint8_t y = 0; y < qr->width; y++) {
+    uint8_t *row = &qr->bitmap[y * qr->row_bytes];
+    for (uint8_t x = 0; x < qr->width; x++) {
+      if (qrcodegen_getModule(qr_code, x, y)) {
+        row[x / 8] |= (uint8_t)(1U << (x % 8));
+      }
+    }
+  }
+
+  return true;
+}
+
+static int8_t cache_lookup(const char *string, size_t string_len)
+{
+  for (uint8_t index = 0; index < SL_SIDEWALK_QR_CODE_CACHE_SIZE; index++) {
+    if (qr_cache_last_use[index] != 0
+        && qr_cache[index].text_len == string_len
+        && memcmp(qr_cache[index].text, string, string_len) == 0) {
+      return (int8_t)index;
+    }
+  }
+
+  return -1;
+}
+
+static uint8_t cache_victim(void)
+{
+  uint8_t victim = 0;
+
+  // Empty entries have the lowest use order, so they are taken first
+  for (uint8_t index = 1; index < SL_SIDEWALK_QR_CODE_CACHE_SIZE; index++) {
+    if (qr_cache_last_use[index] < qr_cache_last_use[victim]) {
+      victim = index;
+    }
+  }
+
+  return victim;
+}
+
+static void cache_load(void)
+{
+#if SL_SIDEWALK_QR_CODE_CACHE_NVM3_ENABLE
+  for (uint8_t index = 0; index < SL_SIDEWALK_QR_CODE_CACHE_SIZE; index++) {
+    nvm3_ObjectKey_t key = SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY + index;
+    qr_cache_entry_t *entry = &qr_cache[index];
+    uint32_t type;
+    size_t size;
+
+    if (nvm3_getObjectInfo(nvm3_defaultHandle, key, &type, &size) != ECODE_NVM3_OK
+        || size != sizeof(qr_cache_entry_t)) {
+      continue;
+    }
+
+    if (nvm3_readData(nvm3_defaultHandle, key, entry, sizeof(qr_cache_entry_t)) != ECODE_NVM3_OK) {
+      continue;
+    }
+
+    // Entries written with a different configuration are ignored
+    if (entry->text_len > SL_SIDEWALK_QR_CODE_CACHE_TEXT_LEN_MAX
+        || entry->qr.width > SLI_SIDEWALK_QR_CODE_BITMAP_WIDTH_MAX
+        || entry->qr.row_bytes != (entry->qr.width + 7) / 8) {
+      continue;
+    }
+
+    qr_cache_last_use[index] = ++qr_cache_use_counter;
+  }
+#endif
+}
+
+static void cache_store(uint8_t index)
+{
+#if SL_SIDEWALK_QR_CODE_CACHE_NVM3_ENABLE
+  (void)sli_sid_nvm3_write(SL_SIDEWALK_QR_CODE_CACHE_NVM3_KEY + index,
+                           &qr_cache[index],
+                           sizeof(qr_cache_entry_t));
+#else
+  (void)index;
+#endif
 }
@@ -46,15 +46,22 @@
 #include <stdint.h>
 
 #include "qrcodegen.h"
+#include "sl_sidewalk_qr_code_config.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+#define SLI_SIDEWALK_QR_CODE_BITMAP_WIDTH_MAX     (SL_SIDEWALK_QR_CODE_CACHE_VERSION_MAX * 4 + 17)
+#define SLI_SIDEWALK_QR_CODE_BITMAP_ROW_BYTES_MAX ((SLI_SIDEWALK_QR_CODE_BITMAP_WIDTH_MAX + 7) / 8)
+
+// Encoded QR code as 1-bpp module bitmap. Rows start on byte boundaries,
+// module x of a row is bit (x % 8) of byte (x / 8), a set bit is a dark module.
 typedef struct {
-  uint8_t buffer[qrcodegen_BUFFER_LEN_MAX];
   uint8_t width;
-} sli_sidewalk_qr_code_qr_t;
+  uint8_t row_bytes;
+  uint8_t bitmap[SLI_SIDEWALK_QR_CODE_BITMAP_WIDTH_MAX * SLI_SIDEWALK_QR_CODE_BITMAP_ROW_BYTES_MAX];
+} sli_sidewalk_qr_code_bitmap_t;
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
@@ -64,7 +71,23 @@ typedef struct {
 //                          Public Function Declarations
 // -----------------------------------------------------------------------------
 
-void sli_sidewalk_qr_code_create_qr_from_str(sli_sidewalk_qr_code_qr_t *qr_buffer, char *string);
-bool sli_sidewalk_qr_code_is_module_pixel_dark(sli_sidewalk_qr_code_qr_t *qr_buffer, uint8_t x, uint8_t y);
+/**************************************************************************//**
+ * Returns the module bitmap of the QR code encoding the given string.
+ *
+ * The string is only encoded on a cache miss, a cached bitmap is returned
+ * otherwise. With NVM3 persistence enabled a miss is first looked up in NVM3.
+ * The returned bitmap stays valid until the next call.
+ *
+ * @param string The string to be encoded
+ * @return The module bitmap, or NULL if the string is longer than
+ *         SL_SIDEWALK_QR_CODE_CACHE_TEXT_LEN_MAX or does not fit in
+ *         SL_SIDEWALK_QR_CODE_CACHE_VERSION_MAX
+ *****************************************************************************/
+const sli_sidewalk_qr_code_bitmap_t *sli_sidewalk_qr_code_get_bitmap(const char *string);
+
+/**************************************************************************//**
+ * Drops every cached QR code, including the ones persisted in NVM3.
+ *****************************************************************************/
+void sli_sidewalk_qr_code_clear_cache(void);
 
 #endif // SLI_SIDEWALK_QR_CODE_H
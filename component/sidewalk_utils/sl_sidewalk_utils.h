@@ -55,7 +55,6 @@
 // string character is added also.
 #define SL_SIDEWALK_UTILS_SMSN_STR_LENGTH ((SID_PAL_MFG_STORE_SMSN_SIZE * 2) + 1)
 #define SL_SIDEWALK_UTILS_CAPABILITIES_STR_MAX_LENGTH (255)
-#define SL_SIDEWALK_UTILS_MAX_STORED_COMMANDS_NUM 5
 #define SL_SIDEWALK_UTILS_MAX_COMMAND_LENGTH_CHAR 255
 #define SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM 5
 
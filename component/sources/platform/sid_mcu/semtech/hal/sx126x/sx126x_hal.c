@@ -8,12 +8,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <sid_pal_delay_ifc.h>
 #include <sid_pal_critical_region_ifc.h>
 
 #include <sx126x.h>
 #include <sx126x_radio.h>
+#include <sx126x_shadow.h>
 
 #ifdef MARS_SPI_BUS_WORKAROUND
 #include "board_hal.h"
@@ -25,6 +27,22 @@
 // Delay time when SX126x wakes up from sleep and goes to standby
 #define SEMTECH_SLEEP_STATE_DELAY_US       550
 
+// Queue of the write transactions issued between sx126x_hal_batch_begin()
+// and sx126x_hal_batch_commit(). An entry is the command length, the data
+// length and the bytes, a delay entry has a zero command length and the
+// delay in us as data.
+#ifndef SEMTECH_BATCH_BUFFER_SIZE
+#define SEMTECH_BATCH_BUFFER_SIZE          128
+#endif
+#define SEMTECH_BATCH_ENTRY_HDR_SIZE       2
+#define SEMTECH_BATCH_DELAY_SIZE           sizeof(uint16_t)
+
+static struct {
+    uint8_t  buf[SEMTECH_BATCH_BUFFER_SIZE];
+    uint16_t len;
+    uint8_t  depth;
+} batch;
+
 static int32_t set_gpio_power(const halo_drv_semtech_ctx_t *drv_ctx,
                               sid_pal_gpio_direction_t dir)
 {
@@ -102,6 +120,142 @@ static int32_t sx126x_hal_rdwr(const void* context, const uint8_t* command, cons
     return err;
 }
 
+static bool batch_queue(const uint8_t *command, uint16_t command_length,
+                        const uint8_t *data, uint16_t data_length)
+{
+    if (data == NULL) {
+        data_length = 0;
+    }
+
+    if (command_length > UINT8_MAX || data_length > UINT8_MAX
+        || ((size_t)batch.len + SEMTECH_BATCH_ENTRY_HDR_SIZE + command_length + data_length) > sizeof(batch.buf)) {
+        return false;
+    }
+
+    batch.buf[batch.len++] = (uint8_t)command_length;
+    batch.buf[batch.len++] = (uint8_t)data_length;
+    if (command_length) {
+        memcpy(&batch.buf[batch.len], command, command_length);
+        batch.len += command_length;
+    }
+    if (data_length) {
+        memcpy(&batch.buf[batch.len], data, data_length);
+        batch.len += data_length;
+    }
+    return true;
+}
+
+/* The shadow only knows what reached the radio, a queued write of the same
+ * command with other bytes makes it stale until the batch is committed */
+static bool batch_has_command(const uint8_t *command, uint16_t command_length)
+{
+    uint16_t pos = 0;
+
+    while (pos < batch.len) {
+        uint8_t cmd_len = batch.buf[pos];
+        uint8_t data_len = batch.buf[pos + 1];
+        const uint8_t *cmd = &batch.buf[pos + SEMTECH_BATCH_ENTRY_HDR_SIZE];
+
+        if (cmd_len != 0 && cmd_len == command_length && cmd[0] == command[0]
+            && (cmd[0] != SX126X_WRITE_REGISTER || memcmp(cmd, command, cmd_len) == 0)) {
+            return true;
+        }
+        pos += SEMTECH_BATCH_ENTRY_HDR_SIZE + cmd_len + data_len;
+    }
+    return false;
+}
+
+static int32_t batch_execute(const halo_drv_semtech_ctx_t *drv_ctx)
+{
+    int32_t err = RADIO_ERROR_NONE;
+    uint16_t pos = 0;
+
+    if (batch.len == 0) {
+        goto ret;
+    }
+
+    // A single wakeup check for the whole sequence
+    if ((err = sx126x_wait_for_device_ready(drv_ctx)) != RADIO_ERROR_NONE) {
+        sx126x_shadow_invalidate();
+        goto ret;
+    }
+
+    // After wake up Semtech is in STDBY_RC mode, a read or a further batch
+    // sent before the caller sets the final state must not wake it again
+    if (drv_ctx->radio_state == SID_PAL_RADIO_SLEEP || drv_ctx->radio_state == SID_PAL_RADIO_RX_DC) {
+        ((halo_drv_semtech_ctx_t *)drv_ctx)->radio_state = SID_PAL_RADIO_STANDBY;
+    }
+
+    while (pos < batch.len) {
+        uint8_t cmd_len = batch.buf[pos];
+        uint8_t data_len = batch.buf[pos + 1];
+        const uint8_t *cmd = &batch.buf[pos + SEMTECH_BATCH_ENTRY_HDR_SIZE];
+        const uint8_t *data = data_len ? &cmd[cmd_len] : NULL;
+
+        pos += SEMTECH_BATCH_ENTRY_HDR_SIZE + cmd_len + data_len;
+
+        if (cmd_len == 0) {
+            uint16_t delay_us;
+            memcpy(&delay_us, data, sizeof(delay_us));
+            sid_pal_delay_us(delay_us);
+            continue;
+        }
+
+        err = sx126x_hal_rdwr(drv_ctx, cmd, cmd_len, (uint8_t *)data, data_len, false);
+        sx126x_shadow_update(cmd, cmd_len, data, data_len, err == RADIO_ERROR_NONE);
+        if (err != RADIO_ERROR_NONE) {
+            break;
+        }
+    }
+
+ret:
+    batch.len = 0;
+    return err;
+}
+
+void sx126x_hal_batch_begin(void)
+{
+    batch.depth++;
+}
+
+int32_t sx126x_hal_batch_commit(const halo_drv_semtech_ctx_t *drv_ctx)
+{
+    if (batch.depth == 0) {
+        return RADIO_ERROR_NONE;
+    }
+
+    if (--batch.depth > 0) {
+        // Committed with the outermost batch
+        return RADIO_ERROR_NONE;
+    }
+
+    return batch_execute(drv_ctx);
+}
+
+void sx126x_hal_batch_abort(void)
+{
+    if (batch.depth == 0) {
+        return;
+    }
+
+    // Nothing of the queue reached the radio, the shadow is still valid. An
+    // inner batch leaves the queue to the outermost one, which gets the error.
+    if (--batch.depth == 0) {
+        batch.len = 0;
+    }
+}
+
+void sx126x_hal_delay_us(uint16_t delay_us)
+{
+    if (batch.depth > 0 && batch.len > 0) {
+        uint8_t dummy = 0;
+        if (batch_queue(&dummy, 0, (const uint8_t *)&delay_us, sizeof(delay_us))) {
+            return;
+        }
+    }
+    sid_pal_delay_us(delay_us);
+}
+
 void set_gpio_cfg_awake(const halo_drv_semtech_ctx_t *drv_ctx)
 {
     /*TODO: Is this needed ? */
@@ -131,6 +285,8 @@ sx126x_hal_status_t sx126x_hal_reset(const void *ctx)
 
         drv_ctx = (halo_drv_semtech_ctx_t *)ctx;
 
+        sx126x_shadow_invalidate();
+
         sid_pal_delay_us(10*1000);
         err = RADIO_ERROR_HARDWARE_ERROR;
         if (sid_pal_gpio_set_direction(drv_ctx->config->gpio_power,
@@ -161,6 +317,11 @@ sx126x_hal_status_t sx126x_hal_wakeup(const void *context)
 {
     const halo_drv_semtech_ctx_t *drv_ctx = (halo_drv_semtech_ctx_t *)context;
 
+    sx126x_hal_status_t status = SX126X_HAL_STATUS_ERROR;
+
+    // Configuration retention in sleep is not relied upon
+    sx126x_shadow_invalidate();
+
     sid_pal_enter_critical_region();
 
     /* wake up the gpio driver */
@@ -168,6 +329,7 @@ sx126x_hal_status_t sx126x_hal_wakeup(const void *context)
 
     if (sid_pal_gpio_set_direction(drv_ctx->config->bus_selector.client_selector,
         SID_PAL_GPIO_DIRECTION_OUTPUT) != SID_ERROR_NONE) {
+        sid_pal_exit_critical_region();
         return SX126X_HAL_STATUS_ERROR;
     }
 
@@ -177,12 +339,16 @@ sx126x_hal_status_t sx126x_hal_wakeup(const void *context)
     if (sid_pal_gpio_write(drv_ctx->config->bus_selector.client_selector, BOARD_HAL_SPI_IAE_NSS_POLARITY)
 #endif
         != SID_ERROR_NONE) {
+        sid_pal_exit_critical_region();
         return SX126X_HAL_STATUS_ERROR;
     }
 
-    /* Wait for chip to be ready */
-    if (sx126x_wait_on_busy() != RADIO_ERROR_NONE) {
-        return SX126X_HAL_STATUS_ERROR;
+    sid_pal_exit_critical_region();
+
+    /* Wait for chip to be ready, outside of the critical region as the
+     * wakeup takes several hundred us and the wait sleeps on the BUSY edge */
+    if (sx126x_wait_on_busy() == RADIO_ERROR_NONE) {
+        status = SX126X_HAL_STATUS_OK;
     }
 
     /* pull up NSS pin again to allow transactions */
@@ -192,12 +358,10 @@ sx126x_hal_status_t sx126x_hal_wakeup(const void *context)
     if (sid_pal_gpio_write(drv_ctx->config->bus_selector.client_selector, !BOARD_HAL_SPI_IAE_NSS_POLARITY)
 #endif
         != SID_ERROR_NONE) {
-        return SX126X_HAL_STATUS_ERROR;
+        status = SX126X_HAL_STATUS_ERROR;
     }
 
-    sid_pal_exit_critical_region();
-
-    return SX126X_HAL_STATUS_OK;
+    return status;
 }
 
 sx126x_hal_status_t sx126x_hal_read(const void* context, const uint8_t* command, const uint16_t command_length,
@@ -209,8 +373,14 @@ sx126x_hal_status_t sx126x_hal_read(const void* context, const uint8_t* command,
         if (context == NULL || command == NULL || data == NULL || command_length == 0 || data_length == 0) {
             break;
         }
-        // If device is in sleep or rx dc state wake up
         const halo_drv_semtech_ctx_t *drv_ctx = (halo_drv_semtech_ctx_t *)context;
+
+        // Queued writes have to reach the radio before anything is read back
+        if (batch.len > 0 && batch_execute(drv_ctx) != RADIO_ERROR_NONE) {
+            break;
+        }
+
+        // If device is in sleep or rx dc state wake up
         if (sx126x_wait_for_device_ready(drv_ctx) != RADIO_ERROR_NONE) {
             break;
         }
@@ -234,15 +404,39 @@ sx126x_hal_status_t sx126x_hal_write(const void* context, const uint8_t* command
             break;
         }
 
-        // If device is in sleep or rx dc state wake up
+        // Skip configuration the radio already holds, a sleeping or duty
+        // cycling radio is still woken up by the write
         const halo_drv_semtech_ctx_t *drv_ctx = (halo_drv_semtech_ctx_t *)context;
+        if (drv_ctx->radio_state != SID_PAL_RADIO_SLEEP && drv_ctx->radio_state != SID_PAL_RADIO_RX_DC
+            && !(batch.depth > 0 && batch_has_command(command, command_length))
+            && sx126x_shadow_is_redundant(command, command_length, data, data_length)) {
+            status = SX126X_STATUS_OK;
+            break;
+        }
+
+        if (batch.depth > 0) {
+            // Full queue, send what is queued and start over
+            if (!batch_queue(command, command_length, data, data_length)) {
+                if (batch_execute(drv_ctx) != RADIO_ERROR_NONE
+                    || !batch_queue(command, command_length, data, data_length)) {
+                    break;
+                }
+            }
+            status = SX126X_STATUS_OK;
+            break;
+        }
+
+        // If device is in sleep or rx dc state wake up
         if (sx126x_wait_for_device_ready(drv_ctx) != RADIO_ERROR_NONE) {
+            sx126x_shadow_update(command, command_length, data, data_length, false);
             break;
         }
 
         if (sx126x_hal_rdwr(context, command, command_length, (uint8_t *)data, data_length, false) != RADIO_ERROR_NONE) {
+            sx126x_shadow_update(command, command_length, data, data_length, false);
             break;
         }
+        sx126x_shadow_update(command, command_length, data, data_length, true);
         status = SX126X_STATUS_OK;
     } while(0);
 
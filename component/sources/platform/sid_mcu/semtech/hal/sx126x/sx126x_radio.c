@@ -10,6 +10,8 @@
 
 #include <sid_clock_ifc.h>
 #include <sid_pal_delay_ifc.h>
+#include <sid_pal_critical_region_ifc.h>
+#include <sid_pal_temperature_ifc.h>
 #include <sid_time_ops.h>
 #include <sid_time_types.h>
 
@@ -17,6 +19,18 @@
 #include "board_hal.h"
 #endif
 
+#include "em_core.h"
+#include "em_device.h"
+#include "sl_sleeptimer.h"
+#include "sl_component_catalog.h"
+#include "gpio.h"
+#include "temperature.h"
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#endif
+
 #define SX126X_DEFAULT_LORA_IRQ_MASK       (RADIO_IRQ_ALL & ~(RADIO_IRQ_PREAMBLE_DETECT | \
                                             RADIO_IRQ_VALID_SYNC_WORD))
 
@@ -27,6 +41,13 @@
 #define SX1262_DEFAULT_OCP_VAL             0x38
 
 #define SX126X_DEFAULT_TRIM_CAP_VAL        0x1212
+#define SX126X_XTAL_TRIM_MAX               0x2F
+
+// The crystal trim offset is re-evaluated when the temperature moved by this
+// much (milli degree Celsius) since the last evaluation
+#ifndef SEMTECH_XTAL_TEMP_COMP_DELTA
+#define SEMTECH_XTAL_TEMP_COMP_DELTA       2000
+#endif
 
 #define SX126X_RX_CONTINUOUS_VAL           0xFFFFFF
 #define SX126X_MIN_CHANNEL_FREE_DELAY_US   1
@@ -36,6 +57,18 @@
 // Delay time to allow for any external PA/FEM turn ON/OFF
 #define SEMTECH_STDBY_STATE_DELAY_US       10
 #define SEMTECH_MAX_WAIT_ON_BUSY_CNT_US    2000
+#define SEMTECH_MAX_WAIT_ON_BUSY_US        (SEMTECH_MAX_WAIT_ON_BUSY_CNT_US * SEMTECH_STDBY_STATE_DELAY_US)
+
+// BUSY is polled for SEMTECH_BUSY_SPIN_US first, most commands release it
+// within a few us. Longer waits (wakeup, calibration, tcxo start) sleep the
+// calling task, or the core with WFI, until the BUSY falling edge interrupt.
+#ifndef SEMTECH_BUSY_WAIT_IRQ_ENABLE
+#define SEMTECH_BUSY_WAIT_IRQ_ENABLE       1
+#endif
+#ifndef SEMTECH_BUSY_SPIN_US
+#define SEMTECH_BUSY_SPIN_US               40
+#endif
+#define SEMTECH_BUSY_POLL_US               2
 
 #define SX126X_TCXO_VDD_TIMEOUT_DURATION   1
 
@@ -51,6 +84,39 @@
 
 static halo_drv_semtech_ctx_t              drv_ctx = {0};
 
+static sx126x_busy_wait_stats_t            busy_wait_stats = {0};
+static volatile int8_t                     trim_temp_offset = 0;
+static bool                                trim_temp_comp_registered = false;
+#if SEMTECH_BUSY_WAIT_IRQ_ENABLE
+static bool                                busy_irq_ready = false;
+static volatile bool                       busy_released = false;
+static sl_sleeptimer_timer_handle_t        busy_timeout_timer;
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+static SemaphoreHandle_t                   busy_sem = NULL;
+#endif
+
+static void radio_busy_irq(uint32_t pin, void * callback_arg);
+#endif
+
+static void radio_temperature_cb(int32_t temperature, void * context)
+{
+    (void)context;
+
+    trim_temp_offset = sx126x_xtal_trim_temperature_offset(temperature);
+}
+
+static uint8_t trim_apply_temp_offset(uint8_t trim)
+{
+    int32_t value = (int32_t)trim + trim_temp_offset;
+
+    if (value < 0) {
+        value = 0;
+    } else if (value > SX126X_XTAL_TRIM_MAX) {
+        value = SX126X_XTAL_TRIM_MAX;
+    }
+    return (uint8_t)value;
+}
+
 static int32_t radio_sx126x_platform_init(void)
 {
     int32_t err = RADIO_ERROR_INVALID_PARAMS;
@@ -71,6 +137,21 @@ static int32_t radio_sx126x_platform_init(void)
             SID_PAL_GPIO_DIRECTION_INPUT) != SID_ERROR_NONE) {
             goto ret;
         }
+
+#if SEMTECH_BUSY_WAIT_IRQ_ENABLE
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+        if (busy_sem == NULL) {
+            busy_sem = xSemaphoreCreateBinary();
+        }
+#endif
+        // The interrupt is only enabled while sx126x_wait_on_busy() waits,
+        // without it BUSY is polled as before
+        if (sid_pal_gpio_set_irq(drv_ctx.config->gpio_radio_busy,
+            SID_PAL_GPIO_IRQ_TRIGGER_FALLING, radio_busy_irq, NULL) == SID_ERROR_NONE) {
+            sid_pal_gpio_irq_disable(drv_ctx.config->gpio_radio_busy);
+            busy_irq_ready = true;
+        }
+#endif
     }
 
     if (drv_ctx.config->gpio_tx_bypass != HALO_GPIO_NOT_CONNECTED) {
@@ -104,6 +185,15 @@ static int32_t radio_sx126x_platform_init(void)
         drv_ctx.trim = SX126X_DEFAULT_TRIM_CAP_VAL;
     }
 
+    // A tcxo does not need the crystal trim compensation
+    if (drv_ctx.config->tcxo.ctrl == SX126X_TCXO_CTRL_NONE && !trim_temp_comp_registered) {
+        (void)sid_pal_temperature_init();
+        if (sli_sid_temperature_register_cb(SEMTECH_XTAL_TEMP_COMP_DELTA, radio_temperature_cb, NULL)
+            == SID_ERROR_NONE) {
+            trim_temp_comp_registered = true;
+        }
+    }
+
     if (drv_ctx.config->bus_factory->create(&drv_ctx.bus_iface, drv_ctx.config->bus_factory->config) != SID_ERROR_NONE) {
         err = RADIO_ERROR_IO_ERROR;
         goto ret;
@@ -122,12 +212,63 @@ static void radio_irq(uint32_t pin, void * callback_arg)
     uint8_t pinState;
     if (sid_pal_gpio_read(pin, &pinState) == SID_ERROR_NONE) {
         if (pinState) {
+            struct sid_timespec latency;
             sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &drv_ctx.radio_rx_packet->rcv_tm, NULL);
+            if (sli_sid_gpio_get_irq_latency(pin, &latency) == SID_ERROR_NONE) {
+                // report the DIO edge, not the time the callback got to run
+                sid_time_sub(&drv_ctx.radio_rx_packet->rcv_tm, &latency);
+            }
             drv_ctx.irq_handler();
         }
     }
 }
 
+#if SEMTECH_BUSY_WAIT_IRQ_ENABLE
+static void radio_busy_irq(uint32_t pin, void * callback_arg)
+{
+    (void)pin;
+    (void)callback_arg;
+
+    busy_released = true;
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+    if (busy_sem != NULL) {
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(busy_sem, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+#endif
+}
+
+static void busy_timeout_cb(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+    (void)handle;
+    (void)data;
+    // Only there to wake up the core from WFI
+}
+#endif
+
+static void busy_wait_record(uint32_t elapsed_us, bool timeout)
+{
+    uint8_t bucket = 0;
+
+    if (elapsed_us > 0) {
+        // bucket n > 0 counts waits below 4^(n+1) us
+        bucket = 1;
+        while (bucket < (SX126X_BUSY_WAIT_HIST_BUCKETS - 1)
+               && elapsed_us >= (1UL << (2 * (bucket + 1)))) {
+            bucket++;
+        }
+    }
+
+    busy_wait_stats.histogram[bucket]++;
+    if (elapsed_us > busy_wait_stats.max_us) {
+        busy_wait_stats.max_us = elapsed_us;
+    }
+    if (timeout) {
+        busy_wait_stats.timeouts++;
+    }
+}
+
 static int32_t radio_set_irq_mask(uint16_t irq_mask)
 {
     if (sx126x_set_dio_irq_params(&drv_ctx, irq_mask, irq_mask,
@@ -217,9 +358,10 @@ static int32_t set_trim_cap_val_to_radio(uint8_t xta, uint8_t xtb)
         goto ret;
     }
 
-    sid_pal_delay_us(SEMTECH_STDBY_STATE_DELAY_US);
+    sx126x_hal_delay_us(SEMTECH_STDBY_STATE_DELAY_US);
 
-    if (sx126x_set_xtal_trim(&drv_ctx, xta, xtb) != SX126X_STATUS_OK) {
+    if (sx126x_set_xtal_trim(&drv_ctx, trim_apply_temp_offset(xta), trim_apply_temp_offset(xtb))
+        != SX126X_STATUS_OK) {
         err = RADIO_ERROR_IO_ERROR;
         goto ret;
     }
@@ -241,23 +383,148 @@ const halo_drv_semtech_ctx_t* sx126x_get_drv_ctx(void)
     return &drv_ctx;
 }
 
-int32_t sx126x_wait_on_busy(void)
+#if SEMTECH_BUSY_WAIT_IRQ_ENABLE
+/*
+ * Waits for the BUSY falling edge for at most timeout_us. The calling task
+ * blocks on a semaphore given by the edge interrupt. From interrupt context,
+ * in a critical region or without scheduler the core sleeps in EM1 instead,
+ * a pending interrupt wakes it up even when interrupts are masked, the
+ * sleeptimer bounds the wait. EM2 is never entered here: the power manager
+ * would not restore the clocks on wake up and BUSY on a port other than A/B
+ * cannot wake the core from EM2 on series 2.
+ */
+static int32_t sx126x_wait_on_busy_irq(uint32_t timeout_us)
 {
-    uint16_t cnt = 0;
+    int32_t err = RADIO_ERROR_HARDWARE_ERROR;
+    struct sid_timespec t_start, t_cur, t_timeout;
+    bool timer_running = false;
 
-    while(cnt++ < SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
-        if (sx126x_check_status() == RADIO_ERROR_NONE) {
+    sid_us_to_timespec(timeout_us, &t_timeout);
+    if (sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_start, NULL) != SID_ERROR_NONE) {
+        goto ret;
+    }
+
+    busy_released = false;
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+    bool block_task = busy_sem != NULL && !CORE_IrqIsDisabled() && !xPortIsInsideInterrupt()
+                      && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+    if (block_task) {
+        // Drop a give left over from an earlier wait
+        xSemaphoreTake(busy_sem, 0);
+    }
+#endif
+    sid_pal_gpio_irq_enable(drv_ctx.config->gpio_radio_busy);
+
+    for (;;) {
+        // The edge may have happened before the interrupt was enabled
+        err = sx126x_check_status();
+        if (err != RADIO_ERROR_BUSY) {
             break;
         }
 
+        if (sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_cur, NULL) != SID_ERROR_NONE) {
+            err = RADIO_ERROR_HARDWARE_ERROR;
+            break;
+        }
+        sid_time_sub(&t_cur, &t_start);
+        if (!sid_time_gt(&t_timeout, &t_cur)) {
+            err = RADIO_ERROR_HARDWARE_ERROR;
+            break;
+        }
+
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+        if (block_task) {
+            uint32_t left_ms = (timeout_us - sid_timespec_to_us(&t_cur) + US_IN_MSEC - 1) / US_IN_MSEC;
+            TickType_t ticks = pdMS_TO_TICKS(left_ms);
+            xSemaphoreTake(busy_sem, ticks ? ticks : 1);
+            continue;
+        }
+#endif
+        if (!timer_running) {
+            timer_running = sl_sleeptimer_start_timer_ms(&busy_timeout_timer,
+                                                         (timeout_us + US_IN_MSEC - 1) / US_IN_MSEC,
+                                                         busy_timeout_cb, NULL, 0, 0) == SL_STATUS_OK;
+        }
+        if (!busy_released && timer_running) {
+            // SLEEPDEEP may still be set from the last EM2 entry
+            uint32_t scr = SCB->SCR;
+            SCB->SCR = scr & ~SCB_SCR_SLEEPDEEP_Msk;
+            __DSB();
+            __WFI();
+            SCB->SCR = scr;
+        }
+    }
+
+    sid_pal_gpio_irq_disable(drv_ctx.config->gpio_radio_busy);
+    if (timer_running) {
+        sl_sleeptimer_stop_timer(&busy_timeout_timer);
+    }
+
+ret:
+    return err;
+}
+#endif
+
+int32_t sx126x_wait_on_busy(void)
+{
+    int32_t err = RADIO_ERROR_NONE;
+    uint32_t elapsed_us = 0;
+
+    if (sx126x_check_status() == RADIO_ERROR_NONE) {
+        goto ret;
+    }
+
+#if SEMTECH_BUSY_WAIT_IRQ_ENABLE
+    if (busy_irq_ready) {
+        struct sid_timespec t_start, t_end;
+
+        sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_start, NULL);
+        while (elapsed_us < SEMTECH_BUSY_SPIN_US) {
+            sid_pal_delay_us(SEMTECH_BUSY_POLL_US);
+            elapsed_us += SEMTECH_BUSY_POLL_US;
+            if (sx126x_check_status() == RADIO_ERROR_NONE) {
+                goto ret;
+            }
+        }
+
+        busy_wait_stats.irq_waits++;
+        err = sx126x_wait_on_busy_irq(SEMTECH_MAX_WAIT_ON_BUSY_US - SEMTECH_BUSY_SPIN_US);
+        sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_end, NULL);
+        sid_time_sub(&t_end, &t_start);
+        elapsed_us = sid_timespec_to_us(&t_end);
+        goto ret;
+    }
+#endif
+
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    while (elapsed_us < SEMTECH_MAX_WAIT_ON_BUSY_US) {
         sid_pal_delay_us(SEMTECH_STDBY_STATE_DELAY_US);
+        elapsed_us += SEMTECH_STDBY_STATE_DELAY_US;
+        if (sx126x_check_status() == RADIO_ERROR_NONE) {
+            err = RADIO_ERROR_NONE;
+            break;
+        }
     }
 
-    if (cnt >= SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
-        return RADIO_ERROR_HARDWARE_ERROR;
+ret:
+    busy_wait_record(elapsed_us, err != RADIO_ERROR_NONE);
+    return err;
+}
+
+void sx126x_get_busy_wait_stats(sx126x_busy_wait_stats_t *stats)
+{
+    if (stats != NULL) {
+        sid_pal_enter_critical_region();
+        *stats = busy_wait_stats;
+        sid_pal_exit_critical_region();
     }
+}
 
-    return RADIO_ERROR_NONE;
+void sx126x_reset_busy_wait_stats(void)
+{
+    sid_pal_enter_critical_region();
+    memset(&busy_wait_stats, 0, sizeof(busy_wait_stats));
+    sid_pal_exit_critical_region();
 }
 
 void set_lora_exit_mode(sid_pal_radio_cad_param_exit_mode_t cad_exit_mode)
@@ -496,6 +763,12 @@ int32_t sid_pal_radio_irq_process(void)
     return err;
 }
 
+__WEAK int8_t sx126x_xtal_trim_temperature_offset(int32_t temperature)
+{
+    (void)temperature;
+    return 0;
+}
+
 int32_t set_radio_sx126x_trim_cap_val(uint16_t trim)
 {
     int32_t err = RADIO_ERROR_NONE;
@@ -808,6 +1081,8 @@ int32_t sid_pal_radio_start_tx(uint32_t timeout)
 {
     int32_t err;
 
+    sx126x_hal_batch_begin();
+
     do {
         if ((err = set_trim_cap_val_to_radio(drv_ctx.trim >> 8, drv_ctx.trim & 0xFF))
                    != RADIO_ERROR_NONE) {
@@ -826,9 +1101,13 @@ int32_t sid_pal_radio_start_tx(uint32_t timeout)
             err = RADIO_ERROR_HARDWARE_ERROR;
             break;
         }
+     } while(0);
 
+    if (err != RADIO_ERROR_NONE) {
+        sx126x_hal_batch_abort();
+    } else if ((err = sx126x_hal_batch_commit(&drv_ctx)) == RADIO_ERROR_NONE) {
         drv_ctx.radio_state = SID_PAL_RADIO_TX;
-     } while(0);
+    }
 
     return err;
 }
@@ -873,6 +1152,8 @@ int32_t sid_pal_radio_start_rx(uint32_t timeout)
 {
     int32_t err;
 
+    sx126x_hal_batch_begin();
+
     do {
 
         bool pbl_det_timer = false;
@@ -902,9 +1183,14 @@ int32_t sid_pal_radio_start_rx(uint32_t timeout)
             err = RADIO_ERROR_HARDWARE_ERROR;
             break;
         }
-        drv_ctx.radio_state = SID_PAL_RADIO_RX;
      } while(0);
 
+    if (err != RADIO_ERROR_NONE) {
+        sx126x_hal_batch_abort();
+    } else if ((err = sx126x_hal_batch_commit(&drv_ctx)) == RADIO_ERROR_NONE) {
+        drv_ctx.radio_state = SID_PAL_RADIO_RX;
+    }
+
     return err;
 }
 
@@ -912,6 +1198,8 @@ int32_t sid_pal_radio_start_carrier_sense(uint32_t timeout, sid_pal_radio_cad_pa
 {
     int32_t err;
 
+    sx126x_hal_batch_begin();
+
     do {
 
         if (drv_ctx.modem != SID_PAL_RADIO_MODEM_MODE_FSK) {
@@ -947,9 +1235,14 @@ int32_t sid_pal_radio_start_carrier_sense(uint32_t timeout, sid_pal_radio_cad_pa
             err = RADIO_ERROR_HARDWARE_ERROR;
             break;
         }
+     } while(0);
+
+    if (err != RADIO_ERROR_NONE) {
+        sx126x_hal_batch_abort();
+    } else if ((err = sx126x_hal_batch_commit(&drv_ctx)) == RADIO_ERROR_NONE) {
         drv_ctx.radio_state = SID_PAL_RADIO_RX;
         drv_ctx.cad_exit_mode = exit_mode;
-     } while(0);
+    }
 
     return err;
 }
@@ -958,6 +1251,8 @@ int32_t sid_pal_radio_start_continuous_rx(void)
 {
     int32_t err;
 
+    sx126x_hal_batch_begin();
+
     do {
 
         bool pbl_det_timer = false;
@@ -987,9 +1282,14 @@ int32_t sid_pal_radio_start_continuous_rx(void)
             err = RADIO_ERROR_HARDWARE_ERROR;
             break;
         }
-        drv_ctx.radio_state = SID_PAL_RADIO_RX;
     } while (0);
 
+    if (err != RADIO_ERROR_NONE) {
+        sx126x_hal_batch_abort();
+    } else if ((err = sx126x_hal_batch_commit(&drv_ctx)) == RADIO_ERROR_NONE) {
+        drv_ctx.radio_state = SID_PAL_RADIO_RX;
+    }
+
     return err;
 }
 
@@ -997,6 +1297,8 @@ int32_t sid_pal_radio_set_rx_duty_cycle(uint32_t rx_time, uint32_t sleep_time)
 {
     int32_t err;
 
+    sx126x_hal_batch_begin();
+
     do {
         if (rx_time == 0 || sleep_time == 0) {
             err = RADIO_ERROR_INVALID_PARAMS;
@@ -1020,9 +1322,13 @@ int32_t sid_pal_radio_set_rx_duty_cycle(uint32_t rx_time, uint32_t sleep_time)
             err = RADIO_ERROR_HARDWARE_ERROR;
             break;
         }
+     } while(0);
 
+    if (err != RADIO_ERROR_NONE) {
+        sx126x_hal_batch_abort();
+    } else if ((err = sx126x_hal_batch_commit(&drv_ctx)) == RADIO_ERROR_NONE) {
         drv_ctx.radio_state = SID_PAL_RADIO_RX_DC;
-     } while(0);
+    }
 
     return err;
 }
@@ -1031,6 +1337,8 @@ int32_t sid_pal_radio_lora_start_cad(void)
 {
     int32_t err;
 
+    sx126x_hal_batch_begin();
+
     do {
         if ((err = set_trim_cap_val_to_radio(drv_ctx.trim >> 8, drv_ctx.trim & 0xFF))
                    != RADIO_ERROR_NONE) {
@@ -1049,9 +1357,14 @@ int32_t sid_pal_radio_lora_start_cad(void)
             err = RADIO_ERROR_HARDWARE_ERROR;
             break;
         }
-        drv_ctx.radio_state = SID_PAL_RADIO_CAD;
      } while(0);
 
+    if (err != RADIO_ERROR_NONE) {
+        sx126x_hal_batch_abort();
+    } else if ((err = sx126x_hal_batch_commit(&drv_ctx)) == RADIO_ERROR_NONE) {
+        drv_ctx.radio_state = SID_PAL_RADIO_CAD;
+    }
+
     return err;
 }
 
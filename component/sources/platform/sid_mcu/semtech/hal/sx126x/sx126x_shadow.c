@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * @file
+ * @brief sx126x_shadow.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <string.h>
+
+#include <sx126x.h>
+#include <sx126x_regs.h>
+#include "sx126x_shadow.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+// Largest shadowed transaction, SetPacketParams in GFSK
+#define SX126X_SHADOW_MAX_LEN               SX126X_SIZE_SET_PACKETPARAMS_GFSK
+#define SX126X_SHADOW_REG_ADDR(cmd)         (((uint16_t)(cmd)[1] << 8) | (cmd)[2])
+
+typedef enum {
+  SX126X_SHADOW_PACKET_TYPE,
+  SX126X_SHADOW_MOD_PARAMS,
+  SX126X_SHADOW_PKT_PARAMS,
+  SX126X_SHADOW_CAD_PARAMS,
+  SX126X_SHADOW_LORA_SYMB_TIMEOUT,
+  SX126X_SHADOW_RF_FREQUENCY,
+  SX126X_SHADOW_DIO_IRQ_PARAMS,
+  SX126X_SHADOW_STOP_TIMER_ON_PBL,
+  SX126X_SHADOW_BUFFER_BASE_ADDR,
+  SX126X_SHADOW_TX_PARAMS,
+  SX126X_SHADOW_PA_CONFIG,
+  SX126X_SHADOW_REGULATOR_MODE,
+  SX126X_SHADOW_DIO2_RF_SWITCH,
+  SX126X_SHADOW_RX_TX_FALLBACK,
+  SX126X_SHADOW_XTA_TRIM,
+  SX126X_SHADOW_SLOT_COUNT,
+  SX126X_SHADOW_NOT_CACHED = SX126X_SHADOW_SLOT_COUNT
+} sx126x_shadow_slot_t;
+
+typedef struct {
+  uint8_t len;    // 0 when the radio content is unknown
+  uint8_t bytes[SX126X_SHADOW_MAX_LEN];
+} sx126x_shadow_entry_t;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+static sx126x_shadow_slot_t get_slot(const uint8_t *command, uint16_t command_length);
+static bool build_entry(sx126x_shadow_entry_t *entry,
+                        const uint8_t *command, uint16_t command_length,
+                        const uint8_t *data, uint16_t data_length);
+static bool matches_shadow(sx126x_shadow_slot_t slot,
+                           const uint8_t *command, uint16_t command_length,
+                           const uint8_t *data, uint16_t data_length);
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static sx126x_shadow_entry_t shadow[SX126X_SHADOW_SLOT_COUNT];
+static sx126x_shadow_stats_t shadow_stats;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+bool sx126x_shadow_is_redundant(const uint8_t *command, uint16_t command_length,
+                                const uint8_t *data, uint16_t data_length)
+{
+#if SX126X_SHADOW_ENABLE
+  if (!matches_shadow(get_slot(command, command_length), command, command_length, data, data_length)) {
+    return false;
+  }
+
+  shadow_stats.saved++;
+  return true;
+#else
+  (void)command;
+  (void)command_length;
+  (void)data;
+  (void)data_length;
+  return false;
+#endif
+}
+
+void sx126x_shadow_update(const uint8_t *command, uint16_t command_length,
+                          const uint8_t *data, uint16_t data_length, bool success)
+{
+  if (!success) {
+    sx126x_shadow_invalidate();
+    return;
+  }
+
+  shadow_stats.writes++;
+
+  if (command == NULL || command_length == 0) {
+    return;
+  }
+
+  switch (command[0]) {
+    case SX126X_SET_SLEEP:
+      sx126x_shadow_invalidate();
+      return;
+    case SX126X_SET_PACKETTYPE:
+      // Modulation, packet and cad parameters are specific to the packet type
+      if (!matches_shadow(SX126X_SHADOW_PACKET_TYPE, command, command_length, data, data_length)) {
+        shadow[SX126X_SHADOW_MOD_PARAMS].len = 0;
+        shadow[SX126X_SHADOW_PKT_PARAMS].len = 0;
+        shadow[SX126X_SHADOW_CAD_PARAMS].len = 0;
+        shadow[SX126X_SHADOW_LORA_SYMB_TIMEOUT].len = 0;
+      }
+      break;
+    case SX126X_SET_DIO3ASTCXOCTRL:
+      // The radio overwrites the XTA trim when the tcxo is enabled
+      shadow[SX126X_SHADOW_XTA_TRIM].len = 0;
+      break;
+    default:
+      break;
+  }
+
+  sx126x_shadow_slot_t slot = get_slot(command, command_length);
+  if (slot != SX126X_SHADOW_NOT_CACHED) {
+    if (!build_entry(&shadow[slot], command, command_length, data, data_length)) {
+      shadow[slot].len = 0;
+    }
+  }
+}
+
+void sx126x_shadow_invalidate(void)
+{
+  memset(shadow, 0, sizeof(shadow));
+  shadow_stats.invalidations++;
+}
+
+void sx126x_shadow_get_stats(sx126x_shadow_stats_t *stats)
+{
+  if (stats != NULL) {
+    *stats = shadow_stats;
+  }
+}
+
+void sx126x_shadow_reset_stats(void)
+{
+  memset(&shadow_stats, 0, sizeof(shadow_stats));
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static sx126x_shadow_slot_t get_slot(const uint8_t *command, uint16_t command_length)
+{
+  if (command == NULL || command_length == 0) {
+    return SX126X_SHADOW_NOT_CACHED;
+  }
+
+  switch (command[0]) {
+    case SX126X_SET_PACKETTYPE:
+      return SX126X_SHADOW_PACKET_TYPE;
+    case SX126X_SET_MODULATIONPARAMS:
+      return SX126X_SHADOW_MOD_PARAMS;
+    case SX126X_SET_PACKETPARAMS:
+      return SX126X_SHADOW_PKT_PARAMS;
+    case SX126X_SET_CADPARAMS:
+      return SX126X_SHADOW_CAD_PARAMS;
+    case SX126X_SET_LORASYMBNUMTIMEOUT:
+      return SX126X_SHADOW_LORA_SYMB_TIMEOUT;
+    case SX126X_SET_RFFREQUENCY:
+      return SX126X_SHADOW_RF_FREQUENCY;
+    case SX126X_SET_DIOIRQPARAMS:
+      return SX126X_SHADOW_DIO_IRQ_PARAMS;
+    case SX126X_SET_STOPTIMERONPREAMBLE:
+      return SX126X_SHADOW_STOP_TIMER_ON_PBL;
+    case SX126X_SET_BUFFERBASEADDRESS:
+      return SX126X_SHADOW_BUFFER_BASE_ADDR;
+    case SX126X_SET_TXPARAMS:
+      return SX126X_SHADOW_TX_PARAMS;
+    case SX126X_SET_PACONFIG:
+      return SX126X_SHADOW_PA_CONFIG;
+    case SX126X_SET_REGULATORMODE:
+      return SX126X_SHADOW_REGULATOR_MODE;
+    case SX126X_SET_DIO2ASRFSWITCHCTRL:
+      return SX126X_SHADOW_DIO2_RF_SWITCH;
+    case SX126X_SET_RXTXFALLBACKMODE:
+      return SX126X_SHADOW_RX_TX_FALLBACK;
+    case SX126X_WRITE_REGISTER:
+      // Other registers are also written by the radio itself (OCP on
+      // SetPaConfig, ...), only the crystal trim is shadowed
+      if (command_length == SX126X_SIZE_WRITE_REGISTER
+          && SX126X_SHADOW_REG_ADDR(command) == SX126X_REG_XTATRIM) {
+        return SX126X_SHADOW_XTA_TRIM;
+      }
+      return SX126X_SHADOW_NOT_CACHED;
+    default:
+      return SX126X_SHADOW_NOT_CACHED;
+  }
+}
+
+static bool build_entry(sx126x_shadow_entry_t *entry,
+                        const uint8_t *command, uint16_t command_length,
+                        const uint8_t *data, uint16_t data_length)
+{
+  if (data == NULL) {
+    data_length = 0;
+  }
+
+  if ((uint32_t)command_length + data_length > SX126X_SHADOW_MAX_LEN) {
+    return false;
+  }
+
+  memcpy(entry->bytes, command, command_length);
+  if (data_length) {
+    memcpy(&entry->bytes[command_length], data, data_length);
+  }
+  entry->len = (uint8_t)(command_length + data_length);
+
+  return true;
+}
+
+static bool matches_shadow(sx126x_shadow_slot_t slot,
+                           const uint8_t *command, uint16_t command_length,
+                           const uint8_t *data, uint16_t data_length)
+{
+  sx126x_shadow_entry_t entry;
+
+  if (slot == SX126X_SHADOW_NOT_CACHED || shadow[slot].len == 0) {
+    return false;
+  }
+
+  if (!build_entry(&entry, command, command_length, data, data_length)) {
+    return false;
+  }
+
+  return entry.len == shadow[slot].len && memcmp(entry.bytes, shadow[slot].bytes, entry.len) == 0;
+}
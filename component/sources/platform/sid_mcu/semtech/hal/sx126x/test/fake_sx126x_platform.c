@@ -0,0 +1,160 @@
+/***************************************************************************//**
+ * @file
+ * @brief fake_sx126x_platform.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <sid_pal_critical_region_ifc.h>
+#include <sid_pal_delay_ifc.h>
+#include <sid_pal_gpio_ifc.h>
+#include <sx126x.h>
+#include <sx126x_radio.h>
+#include "fake_sx126x_platform.h"
+
+// -----------------------------------------------------------------------------
+//                                Global Variables
+// -----------------------------------------------------------------------------
+
+fake_sx126x_platform_t fake_sx126x_platform;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+
+void fake_sx126x_platform_init(void)
+{
+  memset(&fake_sx126x_platform, 0, sizeof(fake_sx126x_platform));
+}
+
+int32_t sx126x_radio_bus_xfer(const uint8_t *cmd_buffer, const uint16_t cmd_buffer_size, uint8_t *buffer,
+                              const uint16_t size, uint8_t read_offset)
+{
+  fake_sx126x_platform_t *bus = &fake_sx126x_platform;
+  uint16_t len = 0;
+
+  (void)read_offset;
+
+  bus->xfer_calls++;
+  if (bus->xfer_calls == bus->fail_xfer_call) {
+    return RADIO_ERROR_IO_ERROR;
+  }
+
+  if (cmd_buffer_size <= FAKE_SX126X_MAX_XFER_LEN) {
+    memcpy(bus->last_xfer, cmd_buffer, cmd_buffer_size);
+    len = cmd_buffer_size;
+  }
+  if (buffer != NULL && len + size <= FAKE_SX126X_MAX_XFER_LEN) {
+    memcpy(&bus->last_xfer[len], buffer, size);
+    len += size;
+  }
+  bus->last_xfer_len = len;
+  return RADIO_ERROR_NONE;
+}
+
+int32_t sx126x_wait_on_busy(void)
+{
+  return RADIO_ERROR_NONE;
+}
+
+int32_t radio_sx126x_set_radio_mode(bool rf_en, bool tx_en)
+{
+  (void)rf_en;
+  (void)tx_en;
+  return RADIO_ERROR_NONE;
+}
+
+// The Semtech driver wakes the radio up through the HAL
+sx126x_status_t sx126x_wakeup(const void *context)
+{
+  fake_sx126x_platform.wakeup_calls++;
+  return (sx126x_status_t)sx126x_hal_wakeup(context);
+}
+
+void sid_pal_delay_us(uint32_t delay)
+{
+  (void)delay;
+}
+
+void sid_pal_enter_critical_region()
+{
+}
+
+void sid_pal_exit_critical_region()
+{
+}
+
+sid_error_t sid_pal_gpio_set_direction(uint32_t gpio_number, sid_pal_gpio_direction_t direction)
+{
+  (void)gpio_number;
+  (void)direction;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_write(uint32_t gpio_number, uint8_t value)
+{
+  (void)gpio_number;
+  (void)value;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_input_mode(uint32_t gpio_number, sid_pal_gpio_input_t mode)
+{
+  (void)gpio_number;
+  (void)mode;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_pull_mode(uint32_t gpio_number, sid_pal_gpio_pull_t pull)
+{
+  (void)gpio_number;
+  (void)pull;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_irq_enable(uint32_t gpio_number)
+{
+  (void)gpio_number;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_irq_disable(uint32_t gpio_number)
+{
+  (void)gpio_number;
+  return SID_ERROR_NONE;
+}
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * @file
+ * @brief fake_sx126x_platform.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef FAKE_SX126X_PLATFORM_H
+#define FAKE_SX126X_PLATFORM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+#define FAKE_SX126X_MAX_XFER_LEN          32
+
+/*******************************************************************************
+ * Host stand-in for the SPI bus and the board functions sx126x_hal.c calls.
+ * Every transfer reaching the bus is counted and the last one is kept. A bus
+ * error can be injected on a given transfer (1 based, 0 disables it).
+ ******************************************************************************/
+typedef struct {
+  uint32_t xfer_calls;
+  uint32_t fail_xfer_call;
+  uint32_t wakeup_calls;
+  uint8_t last_xfer[FAKE_SX126X_MAX_XFER_LEN];
+  uint16_t last_xfer_len;
+} fake_sx126x_platform_t;
+
+extern fake_sx126x_platform_t fake_sx126x_platform;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Reset the counters and the injected errors
+ ******************************************************************************/
+void fake_sx126x_platform_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FAKE_SX126X_PLATFORM_H
@@ -0,0 +1,311 @@
+/***************************************************************************//**
+ * @file
+ * @brief test_sx126x_shadow.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sx126x.h>
+#include <sx126x_hal.h>
+#include <sx126x_radio.h>
+#include <sx126x_regs.h>
+#include "sx126x_shadow.h"
+#include "fake_sx126x_platform.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+#define CHECK(cond)                                                    \
+  do {                                                                 \
+    if (!(cond)) {                                                     \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+      failures++;                                                      \
+    }                                                                  \
+  } while (0)
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+
+static int failures;
+static radio_sx126x_device_config_t config;
+static halo_drv_semtech_ctx_t ctx;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+static void setup(void)
+{
+  fake_sx126x_platform_init();
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.config = &config;
+  ctx.radio_state = SID_PAL_RADIO_STANDBY;
+  sx126x_shadow_invalidate();
+  sx126x_shadow_reset_stats();
+}
+
+static sx126x_hal_status_t write_cmd(const uint8_t *command, uint16_t command_length)
+{
+  return sx126x_hal_write(&ctx, command, command_length, NULL, 0);
+}
+
+static sx126x_hal_status_t set_rf_freq(uint32_t freq)
+{
+  const uint8_t command[SX126X_SIZE_SET_RFFREQUENCY] = {
+    SX126X_SET_RFFREQUENCY,
+    (uint8_t)(freq >> 24), (uint8_t)(freq >> 16), (uint8_t)(freq >> 8), (uint8_t)freq
+  };
+
+  return write_cmd(command, sizeof(command));
+}
+
+static sx126x_hal_status_t set_pkt_type(uint8_t pkt_type)
+{
+  const uint8_t command[SX126X_SIZE_SET_PACKETTYPE] = { SX126X_SET_PACKETTYPE, pkt_type };
+
+  return write_cmd(command, sizeof(command));
+}
+
+static sx126x_hal_status_t set_mod_params_lora(uint8_t sf)
+{
+  const uint8_t command[SX126X_SIZE_SET_MODULATIONPARAMS_LORA] = {
+    SX126X_SET_MODULATIONPARAMS, sf, 0x04, 0x01, 0x00
+  };
+
+  return write_cmd(command, sizeof(command));
+}
+
+static sx126x_hal_status_t write_xta_trim(uint8_t trim)
+{
+  const uint8_t command[SX126X_SIZE_WRITE_REGISTER] = {
+    SX126X_WRITE_REGISTER, (uint8_t)(SX126X_REG_XTATRIM >> 8), (uint8_t)SX126X_REG_XTATRIM
+  };
+
+  return sx126x_hal_write(&ctx, command, sizeof(command), &trim, 1);
+}
+
+static void test_redundant_write_skipped(void)
+{
+  sx126x_shadow_stats_t stats;
+
+  setup();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 1);
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 1);
+
+  sx126x_shadow_get_stats(&stats);
+  CHECK(stats.writes == 1);
+  CHECK(stats.saved == 1);
+}
+
+static void test_changed_write_sent(void)
+{
+  setup();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(set_rf_freq(915000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 2);
+  CHECK(fake_sx126x_platform.last_xfer_len == SX126X_SIZE_SET_RFFREQUENCY);
+  CHECK(fake_sx126x_platform.last_xfer[4] == (uint8_t)915000000);
+
+  // Going back is a change as well
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 3);
+}
+
+static void test_uncached_command_always_sent(void)
+{
+  const uint8_t command[SX126X_SIZE_SET_STANDBY] = { SX126X_SET_STANDBY, SX126X_STANDBY_CFG_RC };
+
+  setup();
+  CHECK(write_cmd(command, sizeof(command)) == SX126X_HAL_STATUS_OK);
+  CHECK(write_cmd(command, sizeof(command)) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 2);
+}
+
+static void test_sleeping_radio_woken_up(void)
+{
+  setup();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+
+  // A write to a sleeping radio wakes it up, which drops the shadow
+  ctx.radio_state = SID_PAL_RADIO_SLEEP;
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.wakeup_calls == 1);
+  CHECK(fake_sx126x_platform.xfer_calls == 2);
+}
+
+static void test_bus_error_drops_shadow(void)
+{
+  setup();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  fake_sx126x_platform.fail_xfer_call = 2;
+  CHECK(set_rf_freq(915000000) != SX126X_HAL_STATUS_OK);
+
+  // The radio may hold either frequency, nothing is skipped any more
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 3);
+}
+
+static void test_sleep_and_reset_drop_shadow(void)
+{
+  const uint8_t sleep[SX126X_SIZE_SET_SLEEP] = { SX126X_SET_SLEEP, SX126X_SLEEP_CFG_WARM_START };
+
+  setup();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(write_cmd(sleep, sizeof(sleep)) == SX126X_HAL_STATUS_OK);
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 3);
+
+  CHECK(sx126x_hal_reset(&ctx) == SX126X_HAL_STATUS_OK);
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 4);
+}
+
+static void test_packet_type_change_drops_modulation(void)
+{
+  setup();
+  CHECK(set_pkt_type(SX126X_PKT_TYPE_LORA) == SX126X_HAL_STATUS_OK);
+  CHECK(set_mod_params_lora(SX126X_LORA_SF7) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 2);
+
+  // Same packet type, the modulation parameters are kept
+  CHECK(set_pkt_type(SX126X_PKT_TYPE_LORA) == SX126X_HAL_STATUS_OK);
+  CHECK(set_mod_params_lora(SX126X_LORA_SF7) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 2);
+
+  // The radio resets them on a packet type change
+  CHECK(set_pkt_type(SX126X_PKT_TYPE_GFSK) == SX126X_HAL_STATUS_OK);
+  CHECK(set_pkt_type(SX126X_PKT_TYPE_LORA) == SX126X_HAL_STATUS_OK);
+  CHECK(set_mod_params_lora(SX126X_LORA_SF7) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 5);
+}
+
+static void test_tcxo_drops_xta_trim(void)
+{
+  const uint8_t tcxo[SX126X_SIZE_SET_DIO3ASTCXOCTRL] = { SX126X_SET_DIO3ASTCXOCTRL, SX126X_TCXO_CTRL_1_8V, 0, 0, 0x40 };
+
+  setup();
+  CHECK(write_xta_trim(0x12) == SX126X_HAL_STATUS_OK);
+  CHECK(write_xta_trim(0x12) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 1);
+
+  CHECK(write_cmd(tcxo, sizeof(tcxo)) == SX126X_HAL_STATUS_OK);
+  CHECK(write_xta_trim(0x12) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 3);
+}
+
+static void test_nested_batch_abort_keeps_outer_queue(void)
+{
+  setup();
+  sx126x_hal_batch_begin();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+
+  // Cleanup of an inner sequence leaves the queue to the outermost batch
+  sx126x_hal_batch_begin();
+  CHECK(set_pkt_type(SX126X_PKT_TYPE_LORA) == SX126X_HAL_STATUS_OK);
+  sx126x_hal_batch_abort();
+  CHECK(fake_sx126x_platform.xfer_calls == 0);
+
+  CHECK(sx126x_hal_batch_commit(&ctx) == RADIO_ERROR_NONE);
+  CHECK(fake_sx126x_platform.xfer_calls == 2);
+}
+
+static void test_batch_abort_drops_queue(void)
+{
+  setup();
+  sx126x_hal_batch_begin();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  sx126x_hal_batch_abort();
+  CHECK(sx126x_hal_batch_commit(&ctx) == RADIO_ERROR_NONE);
+  CHECK(fake_sx126x_platform.xfer_calls == 0);
+
+  // Nothing reached the radio, its shadow still holds
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.xfer_calls == 1);
+}
+
+static void test_read_in_batch_wakes_up_once(void)
+{
+  const uint8_t get_status[] = { SX126X_GET_STATUS };
+  uint8_t status;
+
+  setup();
+  ctx.radio_state = SID_PAL_RADIO_SLEEP;
+  sx126x_hal_batch_begin();
+  CHECK(set_rf_freq(868000000) == SX126X_HAL_STATUS_OK);
+
+  // The read sends the queue, which wakes the radio up and leaves it in standby
+  CHECK(sx126x_hal_read(&ctx, get_status, sizeof(get_status), &status, 1) == SX126X_HAL_STATUS_OK);
+  CHECK(fake_sx126x_platform.wakeup_calls == 1);
+  CHECK(fake_sx126x_platform.xfer_calls == 2);
+  CHECK(ctx.radio_state == SID_PAL_RADIO_STANDBY);
+
+  CHECK(sx126x_hal_batch_commit(&ctx) == RADIO_ERROR_NONE);
+  CHECK(fake_sx126x_platform.wakeup_calls == 1);
+}
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+
+int main(void)
+{
+  test_redundant_write_skipped();
+  test_changed_write_sent();
+  test_uncached_command_always_sent();
+  test_sleeping_radio_woken_up();
+  test_bus_error_drops_shadow();
+  test_sleep_and_reset_drop_shadow();
+  test_packet_type_change_drops_modulation();
+  test_tcxo_drops_xta_trim();
+  test_nested_batch_abort_keeps_outer_queue();
+  test_batch_abort_drops_queue();
+  test_read_in_batch_wakes_up_once();
+
+  if (failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("sx126x shadow: all tests passed\n");
+  return EXIT_SUCCESS;
+}
@@ -35,10 +35,6 @@
  *
  ******************************************************************************/
 
-//========================================================
-//===== BLE adapter only supports legacy advertising =====
-//========================================================
-
 // -----------------------------------------------------------------------------
 //                                   Includes
 // -----------------------------------------------------------------------------
@@ -50,10 +46,13 @@
 #include <sid_pal_ble_adapter_ifc.h>
 #include <sid_ble_config_ifc.h>
 #include <sid_pal_log_ifc.h>
+#include <sid_pal_critical_region_ifc.h>
+#include <sid_pal_timer_ifc.h>
+#include <sid_pal_uptime_ifc.h>
+#include <sid_time_ops.h>
 #include "ble_adapter.h"
 #include "sl_bt_api.h"
 #include "sl_bluetooth_config.h"
-#include "sl_malloc.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -92,6 +91,85 @@
 #define SL_BT_GATTS_TRAN_TYPE_WRITE                     ((uint32_t) 0x02)
 #define SL_BT_GATTS_TRAN_TYPE_PREP_WRITE                ((uint32_t) 0x03)
 
+// Upper bounds of the BLE configuration, the profile handles and the attribute
+// dispatch table are allocated statically based on these
+#ifndef BLE_ADAPTER_MAX_PROFILES
+#define BLE_ADAPTER_MAX_PROFILES                        (3)
+#endif
+#ifndef BLE_ADAPTER_MAX_ATTRIBUTES
+#define BLE_ADAPTER_MAX_ATTRIBUTES                      (8)                 // Characteristics and descriptors of all profiles
+#endif
+#ifndef BLE_ADAPTER_ATTR_TABLE_SIZE
+#define BLE_ADAPTER_ATTR_TABLE_SIZE                     (32)                // Handle range covered by the dispatch table
+#endif
+#define BLE_ADAPTER_SERVICE_ID_COUNT                    (LOGGING_SERVICE + 1)
+
+// Notification TX queue
+#ifndef BLE_ADAPTER_TX_QUEUE_DEPTH
+#define BLE_ADAPTER_TX_QUEUE_DEPTH                      (8)
+#endif
+#ifndef BLE_ADAPTER_TX_FRAME_SIZE_MAX
+#define BLE_ADAPTER_TX_FRAME_SIZE_MAX                   (247)
+#endif
+#ifndef BLE_ADAPTER_TX_RETRY_MS
+#define BLE_ADAPTER_TX_RETRY_MS                         (5)                 // Retry period while the stack has no TX buffer
+#endif
+#ifndef BLE_ADAPTER_TX_EXTERNAL_SIGNAL
+#define BLE_ADAPTER_TX_EXTERNAL_SIGNAL                  (0x80000000UL)      // sl_bt_external_signal() bit used to wake the TX queue
+#endif
+
+// Throughput profile: 2M PHY, data length extension and a short connection
+// interval while notifications are being sent, the configured connection
+// parameters once the TX queue has been idle for a while
+#ifndef BLE_ADAPTER_THROUGHPUT_PROFILE_ENABLE
+#define BLE_ADAPTER_THROUGHPUT_PROFILE_ENABLE           (1)
+#endif
+#ifndef BLE_ADAPTER_DLE_TX_OCTETS
+#define BLE_ADAPTER_DLE_TX_OCTETS                       (251)
+#endif
+#ifndef BLE_ADAPTER_DLE_TX_TIME_US
+#define BLE_ADAPTER_DLE_TX_TIME_US                      (2120)              // 251 octets on 1M PHY
+#endif
+// 15 ms is the shortest interval iOS centrals accept, requests below it are
+// rejected. Apple also accepts a minimum equal to the maximum at 15 ms.
+#ifndef BLE_ADAPTER_BULK_MIN_CONN_INTERVAL
+#define BLE_ADAPTER_BULK_MIN_CONN_INTERVAL              (12)                // In units of 1.25 ms
+#endif
+#ifndef BLE_ADAPTER_BULK_MAX_CONN_INTERVAL
+#define BLE_ADAPTER_BULK_MAX_CONN_INTERVAL              (12)                // In units of 1.25 ms
+#endif
+#ifndef BLE_ADAPTER_IDLE_TIMEOUT_MS
+#define BLE_ADAPTER_IDLE_TIMEOUT_MS                     (1000)              // TX inactivity before relaxing the connection
+#endif
+#ifndef BLE_ADAPTER_IDLE_EXTERNAL_SIGNAL
+#define BLE_ADAPTER_IDLE_EXTERNAL_SIGNAL                (0x40000000UL)      // sl_bt_external_signal() bit used by the idle timer
+#endif
+#define SL_BT_CONN_CE_LENGTH_MIN                        (0)
+#define SL_BT_CONN_CE_LENGTH_MAX                        (0xFFFF)
+
+// Extended advertising backend: a larger advertisement and optionally LE Coded
+// PHY for range. Needs bluetooth_feature_extended_advertiser in the project and
+// a scanner that supports extended advertising.
+#ifndef BLE_ADAPTER_EXTENDED_ADV_ENABLE
+#define BLE_ADAPTER_EXTENDED_ADV_ENABLE                 (0)
+#endif
+#ifndef BLE_ADAPTER_EXTENDED_ADV_CODED_PHY_ENABLE
+#define BLE_ADAPTER_EXTENDED_ADV_CODED_PHY_ENABLE       (0)
+#endif
+#define SL_BT_MAX_EXTENDED_CONN_ADV_DATA_LEN            (191)               // Connectable extended advertisement
+#if BLE_ADAPTER_EXTENDED_ADV_ENABLE
+#define BLE_ADAPTER_ADV_DATA_LEN_MAX                    SL_BT_MAX_EXTENDED_CONN_ADV_DATA_LEN
+#if BLE_ADAPTER_EXTENDED_ADV_CODED_PHY_ENABLE
+#define BLE_ADAPTER_EXTENDED_ADV_PRIMARY_PHY            sl_bt_gap_phy_coded
+#define BLE_ADAPTER_EXTENDED_ADV_SECONDARY_PHY          sl_bt_gap_phy_coded
+#else
+#define BLE_ADAPTER_EXTENDED_ADV_PRIMARY_PHY            sl_bt_gap_phy_1m
+#define BLE_ADAPTER_EXTENDED_ADV_SECONDARY_PHY          sl_bt_gap_phy_2m
+#endif
+#else
+#define BLE_ADAPTER_ADV_DATA_LEN_MAX                    SL_BT_MAX_LEGACY_ADV_DATA_LEN
+#endif
+
 // Macro to set a uint16_t data item to advertisement data
 #define SL_BT_PRV_SET_ADV_DATA_UINT16(ptr, value) \
   do {                                            \
@@ -115,6 +193,23 @@ typedef struct {
   uint16_t *current_descriptor_handle;      // The descriptor attribute handle
 } sid_pal_ble_profile_config_t;
 
+typedef enum {
+  BLE_ATTR_ROLE_NONE = 0,
+  BLE_ATTR_ROLE_CHARACTERISTIC,             // Data written by the remote
+  BLE_ATTR_ROLE_DESCRIPTOR,                 // Notification enable/disable
+} sid_pal_ble_attr_role_t;
+
+typedef struct {
+  uint8_t service_id;                       // sid_ble_cfg_service_identifier_t of the owning profile
+  uint8_t role;                             // sid_pal_ble_attr_role_t
+} sid_pal_ble_attr_entry_t;
+
+typedef struct {
+  uint16_t handle;                          // Notification characteristic handle
+  uint16_t length;
+  uint8_t data[BLE_ADAPTER_TX_FRAME_SIZE_MAX];
+} sid_pal_ble_tx_frame_t;
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
@@ -150,11 +245,26 @@ static void sl_ble_adapter_on_gatt_server_characteristic_status_id(sl_bt_evt_gat
 static void sl_ble_adapter_on_gatt_server_indication_timeout_id(sl_bt_evt_gatt_server_indication_timeout_t *event);
 static void sl_ble_adapter_on_gatt_server_user_write_request_id(sl_bt_evt_gatt_server_user_write_request_t *event);
 static void sl_ble_adapter_on_gatt_mtu_exchanged_id(sl_bt_evt_gatt_mtu_exchanged_t *event);
+static void sl_ble_adapter_on_connection_parameters(sl_bt_evt_connection_parameters_t *event);
+static void sl_ble_adapter_on_connection_phy_status(sl_bt_evt_connection_phy_status_t *event);
+static void sl_ble_adapter_on_connection_data_length(sl_bt_evt_connection_data_length_t *event);
 // Helper functions
 static void sl_ble_init_failed(const char *msg);
 static void sl_ble_free_resources();
 static void sl_ble_abort_session(const char *msg, uint16_t session);
 static uint16_t sl_ble_evaluate_permissions(uint16_t xPermissions);
+static bool sl_ble_build_attr_table(void);
+static const sid_pal_ble_attr_entry_t *sl_ble_lookup_attr(uint16_t attr_handle);
+static bool sl_ble_build_adv_payload(void);
+static bool sl_ble_convert_adv_address_type(uint8_t *address_type);
+static sid_error_t sl_ble_configure_adv_address(void);
+static sid_error_t sl_ble_configure_adv_set(void);
+static void sl_ble_tx_queue_drain(void);
+static void sl_ble_tx_queue_flush(void);
+static void sl_ble_tx_retry_timer_cb(void *arg, sid_pal_timer_t *originator);
+static void sl_ble_conn_on_tx_activity(void);
+static void sl_ble_conn_on_idle_check(void);
+static void sl_ble_conn_idle_timer_cb(void *arg, sid_pal_timer_t *originator);
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
@@ -178,10 +288,48 @@ static struct sid_pal_ble_adapter_interface ble_ifc =
 
 // Current adapter context
 static sid_pal_ble_adapter_ctx_t ctx;
-// BLE profile
+// BLE profile, points to ble_profile_storage once initialized
 static sid_pal_ble_profile_config_t *ble_profile = NULL;
+static sid_pal_ble_profile_config_t ble_profile_storage[BLE_ADAPTER_MAX_PROFILES];
+// Characteristic and descriptor handles of all profiles
+static uint16_t ble_attr_handle_storage[BLE_ADAPTER_MAX_ATTRIBUTES];
+// Attribute dispatch table, indexed by attribute handle - ble_attr_table_base
+static sid_pal_ble_attr_entry_t ble_attr_table[BLE_ADAPTER_ATTR_TABLE_SIZE];
+static uint16_t ble_attr_table_base = 0;
+static uint16_t ble_attr_table_count = 0;
+// Notification characteristic handle per service identifier, 0 if none
+static uint16_t ble_notify_handle[BLE_ADAPTER_SERVICE_ID_COUNT];
+
+// Notification TX queue, filled by ble_adapter_send_data() and drained from
+// the Bluetooth event context while the stack accepts more notifications
+static sid_pal_ble_tx_frame_t ble_tx_queue[BLE_ADAPTER_TX_QUEUE_DEPTH];
+static uint8_t ble_tx_queue_head = 0;
+static uint8_t ble_tx_queue_tail = 0;
+static uint8_t ble_tx_queue_count = 0;
+static sid_pal_timer_t ble_tx_retry_timer;
+static bool is_ble_tx_retry_timer_initialized = false;
+// TX statistics of the current connection
+static sl_ble_adapter_tx_stats_t ble_tx_stats;
+
+// Connection parameters in effect on the current connection
+static sl_ble_adapter_conn_stats_t ble_conn_stats;
+static sid_pal_timer_t ble_conn_idle_timer;
+static bool is_ble_conn_idle_timer_initialized = false;
+static uint32_t ble_conn_last_tx_ms = 0;
 // Advertising parameters
 static sid_ble_cfg_adv_param_t adv_timing_params;
+// Advertisement built at init, only the manufacturer data is patched afterwards
+static uint8_t adv_payload[BLE_ADAPTER_ADV_DATA_LEN_MAX];
+static uint8_t adv_payload_manuf_data_idx = BLE_ADAPTER_ADV_DATA_LEN_MAX;
+static uint8_t scan_rsp_payload[SL_BT_MAX_LEGACY_ADV_DATA_LEN];
+static uint8_t scan_rsp_payload_len = 0;
+static uint8_t adv_address_type = sl_bt_gap_public_address;
+static bool is_adv_payload_valid = false;
+// Advertiser set state already pushed to the stack
+static bool is_adv_set_configured = false;
+static bool is_adv_timing_applied = false;
+static uint32_t adv_applied_interval = 0;
+static uint32_t adv_applied_timeout = 0;
 
 // Indicate whether BLE stack is started
 static bool is_bluetooth_started = false;
@@ -255,6 +403,27 @@ void sl_ble_adapter_on_event(sl_bt_msg_t *evt)
       sl_ble_adapter_on_gatt_mtu_exchanged_id(&evt->data.evt_gatt_mtu_exchanged);
       break;
 
+    case sl_bt_evt_connection_parameters_id:
+      sl_ble_adapter_on_connection_parameters(&evt->data.evt_connection_parameters);
+      break;
+
+    case sl_bt_evt_connection_phy_status_id:
+      sl_ble_adapter_on_connection_phy_status(&evt->data.evt_connection_phy_status);
+      break;
+
+    case sl_bt_evt_connection_data_length_id:
+      sl_ble_adapter_on_connection_data_length(&evt->data.evt_connection_data_length);
+      break;
+
+    case sl_bt_evt_system_external_signal_id:
+      if (evt->data.evt_system_external_signal.extsignals & BLE_ADAPTER_TX_EXTERNAL_SIGNAL) {
+        sl_ble_tx_queue_drain();
+      }
+      if (evt->data.evt_system_external_signal.extsignals & BLE_ADAPTER_IDLE_EXTERNAL_SIGNAL) {
+        sl_ble_conn_on_idle_check();
+      }
+      break;
+
     default:
       // Other events are ignored
       break;
@@ -278,6 +447,32 @@ sid_error_t sid_pal_ble_adapter_create(sid_pal_ble_adapter_interface_t *handle)
   return SID_ERROR_NONE;
 }
 
+void sl_ble_adapter_get_tx_stats(sl_ble_adapter_tx_stats_t *stats)
+{
+  if (stats != NULL) {
+    sid_pal_enter_critical_region();
+    *stats = ble_tx_stats;
+    stats->queue_depth = ble_tx_queue_count;
+    sid_pal_exit_critical_region();
+  }
+}
+
+void sl_ble_adapter_reset_tx_stats(void)
+{
+  sid_pal_enter_critical_region();
+  memset(&ble_tx_stats, 0, sizeof(ble_tx_stats));
+  sid_pal_exit_critical_region();
+}
+
+void sl_ble_adapter_get_conn_stats(sl_ble_adapter_conn_stats_t *stats)
+{
+  if (stats != NULL) {
+    sid_pal_enter_critical_region();
+    *stats = ble_conn_stats;
+    sid_pal_exit_critical_region();
+  }
+}
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
@@ -309,65 +504,59 @@ static void ble_request_write_cb_fnc(uint16_t conn_id,
   (void)is_prep;
 
   if (data != NULL) {
-    sid_ble_cfg_service_identifier_t id;
-    for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
-      id = ctx.cfg->profile[i].service.type;
-      for (uint8_t j = 0; j < ctx.cfg->profile[i].char_count; j++) {
-        if (attr_handle == ble_profile[i].current_characteristic_handle[j]) {
-          ctx.callback->data_callback(id, data, length);
-        }
+    const sid_pal_ble_attr_entry_t *attr = sl_ble_lookup_attr(attr_handle);
+
+    if (attr != NULL) {
+      sid_ble_cfg_service_identifier_t id = (sid_ble_cfg_service_identifier_t)attr->service_id;
+
+      if (attr->role == BLE_ATTR_ROLE_CHARACTERISTIC) {
+        ctx.callback->data_callback(id, data, length);
+      } else if (length == BLE_NOTIFY_LENGTH) {
+        uint16_t notif_data;
+        memcpy(&notif_data, data, sizeof(notif_data));
+        ctx.callback->notify_callback(id, (notif_data == BLE_NOTIFICATION_ENABLED));
       }
-      for (uint8_t j = 0; j < ctx.cfg->profile[i].desc_count; j++) {
-        if (attr_handle == ble_profile[i].current_descriptor_handle[j]) {
-          if (length == BLE_NOTIFY_LENGTH) {
-            uint16_t notif_data;
-            memcpy(&notif_data, data, sizeof(notif_data));
-            ctx.callback->notify_callback(id, (notif_data == BLE_NOTIFICATION_ENABLED));
-          }
+    }
+
+    if (need_resp && conn_id) {
+      // Send a response to a read/write operation
+      switch (trans_id) {
+        case SL_BT_GATTS_TRAN_TYPE_WRITE:
+        {
+          // Send response to remote
+          (void)sl_bt_gatt_server_send_user_write_response(conn_id, attr_handle, 0);
+          break;
         }
-      }
 
-      if (need_resp && conn_id) {
-        // Send a response to a read/write operation
-        switch (trans_id) {
-          case SL_BT_GATTS_TRAN_TYPE_WRITE:
-          {
-            // Send response to remote
-            (void)sl_bt_gatt_server_send_user_write_response(conn_id, attr_handle, 0);
-            break;
-          }
+        case SL_BT_GATTS_TRAN_TYPE_PREP_WRITE:
+        {
+          // Send response to remote
+          sl_bt_gatt_server_send_user_prepare_write_response(conn_id, attr_handle, 0, offset, length, data);
+          break;
+        }
 
-          case SL_BT_GATTS_TRAN_TYPE_PREP_WRITE:
-          {
-            // Send response to remote
-            sl_bt_gatt_server_send_user_prepare_write_response(conn_id, attr_handle, 0, offset, length, data);
-            break;
-          }
+        case SL_BT_GATTS_TRAN_TYPE_READ:
+        {
+          uint16_t sent_len;
 
-          case SL_BT_GATTS_TRAN_TYPE_READ:
-          {
-            uint16_t sent_len;
-
-            // Check MTU size
-            uint16_t rsp_val_len;
-            if (sl_bt_gatt_server_get_mtu(conn_id, &rsp_val_len) != SL_STATUS_OK) {
-              break;
-            }
-            // Compare MTU and the length of the unsent Attribute value
-            if (rsp_val_len > length) {
-              rsp_val_len = length;
-            }
-            // Send response to remote
-            (void)sl_bt_gatt_server_send_user_read_response(conn_id, attr_handle, 0, rsp_val_len, data, &sent_len);
+          // Check MTU size
+          uint16_t rsp_val_len;
+          if (sl_bt_gatt_server_get_mtu(conn_id, &rsp_val_len) != SL_STATUS_OK) {
             break;
           }
-
-          default:
-            // Nothing to do
-            break;
+          // Compare MTU and the length of the unsent Attribute value
+          if (rsp_val_len > length) {
+            rsp_val_len = length;
+          }
+          // Send response to remote
+          (void)sl_bt_gatt_server_send_user_read_response(conn_id, attr_handle, 0, rsp_val_len, data, &sent_len);
+          break;
         }
+
+        default:
+          // Nothing to do
+          break;
       }
-      return;
     }
   }
 }
@@ -384,23 +573,13 @@ static void sl_ble_init_failed(const char *msg)
 
 static void sl_ble_free_resources()
 {
-  for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
-    if ((ble_profile != NULL) && (ble_profile[i].current_descriptor_handle != NULL)) {
-      sl_free(ble_profile[i].current_descriptor_handle);
-      ble_profile[i].current_descriptor_handle = NULL;
-    }
-    if ((ble_profile != NULL) && (ble_profile[i].current_characteristic_handle != NULL)) {
-      sl_free(ble_profile[i].current_characteristic_handle);
-      ble_profile[i].current_characteristic_handle = NULL;
-    }
-
-    ble_profile[i].current_service_handle = 0;
-  }
-
-  if (ble_profile != NULL) {
-    sl_free(ble_profile);
-    ble_profile = NULL;
-  }
+  memset(ble_profile_storage, 0, sizeof(ble_profile_storage));
+  memset(ble_attr_handle_storage, 0, sizeof(ble_attr_handle_storage));
+  memset(ble_attr_table, 0, sizeof(ble_attr_table));
+  memset(ble_notify_handle, 0, sizeof(ble_notify_handle));
+  ble_attr_table_base = 0;
+  ble_attr_table_count = 0;
+  ble_profile = NULL;
 }
 
 static void sl_ble_abort_session(const char *msg, uint16_t session)
@@ -417,17 +596,513 @@ static uint16_t sl_ble_evaluate_permissions(uint16_t xPermissions)
   if (xPermissions & SL_BT_PERM_READ_ENCRYPTED) {
     retVal |= SL_BT_GATTDB_ENCRYPTED_READ;
   }
-  if (xPermissions & SL_BT_PERM_READ_ENCRYPTED_MITM) {
-    retVal |= SL_BT_GATTDB_AUTHENTICATED_READ;
+  if (xPermissions & SL_BT_PERM_READ_ENCRYPTED_MITM) {
+    retVal |= SL_BT_GATTDB_AUTHENTICATED_READ;
+  }
+  if (xPermissions & SL_BT_PERM_WRITE_ENCRYPTED) {
+    retVal |= SL_BT_GATTDB_ENCRYPTED_WRITE;
+  }
+  if (xPermissions & SL_BT_PERM_WRITE_ENCRYPTED_MITM) {
+    retVal |= SL_BT_GATTDB_AUTHENTICATED_WRITE;
+  }
+
+  return retVal;
+}
+
+static bool sl_ble_build_attr_table(void)
+{
+  uint16_t handle_min = UINT16_MAX;
+  uint16_t handle_max = 0;
+
+  for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
+    for (uint8_t j = 0; j < ctx.cfg->profile[i].char_count; j++) {
+      uint16_t handle = ble_profile[i].current_characteristic_handle[j];
+      handle_min = (handle < handle_min) ? handle : handle_min;
+      handle_max = (handle > handle_max) ? handle : handle_max;
+    }
+    for (uint8_t j = 0; j < ctx.cfg->profile[i].desc_count; j++) {
+      uint16_t handle = ble_profile[i].current_descriptor_handle[j];
+      handle_min = (handle < handle_min) ? handle : handle_min;
+      handle_max = (handle > handle_max) ? handle : handle_max;
+    }
+  }
+
+  memset(ble_attr_table, 0, sizeof(ble_attr_table));
+  memset(ble_notify_handle, 0, sizeof(ble_notify_handle));
+  ble_attr_table_base = 0;
+  ble_attr_table_count = 0;
+
+  if (handle_min > handle_max) {
+    // No characteristics or descriptors at all
+    return true;
+  }
+
+  // The GATT database assigns the handles of the added services consecutively
+  if ((uint32_t)(handle_max - handle_min) + 1 > BLE_ADAPTER_ATTR_TABLE_SIZE) {
+    return false;
+  }
+
+  ble_attr_table_base = handle_min;
+  ble_attr_table_count = handle_max - handle_min + 1;
+
+  for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
+    const sid_ble_cfg_gatt_profile_t *profile = &ctx.cfg->profile[i];
+
+    for (uint8_t j = 0; j < profile->char_count; j++) {
+      uint16_t handle = ble_profile[i].current_characteristic_handle[j];
+      sid_pal_ble_attr_entry_t *entry = &ble_attr_table[handle - ble_attr_table_base];
+      entry->service_id = (uint8_t)profile->service.type;
+      entry->role = BLE_ATTR_ROLE_CHARACTERISTIC;
+
+      // The first notifying characteristic of a service is used for sending
+      if (profile->characteristic[j].properties.is_notify && (ble_notify_handle[profile->service.type] == 0)) {
+        ble_notify_handle[profile->service.type] = handle;
+      }
+    }
+    for (uint8_t j = 0; j < profile->desc_count; j++) {
+      uint16_t handle = ble_profile[i].current_descriptor_handle[j];
+      sid_pal_ble_attr_entry_t *entry = &ble_attr_table[handle - ble_attr_table_base];
+      entry->service_id = (uint8_t)profile->service.type;
+      entry->role = BLE_ATTR_ROLE_DESCRIPTOR;
+    }
+  }
+
+  return true;
+}
+
+static const sid_pal_ble_attr_entry_t *sl_ble_lookup_attr(uint16_t attr_handle)
+{
+  // Handles below the base wrap around and fail the range check as well
+  uint16_t index = (uint16_t)(attr_handle - ble_attr_table_base);
+
+  if ((index >= ble_attr_table_count) || (ble_attr_table[index].role == BLE_ATTR_ROLE_NONE)) {
+    return NULL;
+  }
+
+  return &ble_attr_table[index];
+}
+
+static void sl_ble_tx_queue_drain(void)
+{
+  uint16_t burst_frames = 0;
+
+  // Hand over as many queued notifications as the stack accepts, these go
+  // out together in the next connection event(s)
+  while (true) {
+    sid_pal_ble_tx_frame_t *frame;
+
+    sid_pal_enter_critical_region();
+    if (ble_tx_queue_count == 0) {
+      sid_pal_exit_critical_region();
+      break;
+    }
+    frame = &ble_tx_queue[ble_tx_queue_tail];
+    sid_pal_exit_critical_region();
+
+    if (!ctx.is_connected) {
+      sl_ble_tx_queue_flush();
+      break;
+    }
+
+    sl_status_t sl_status = sl_bt_gatt_server_send_notification(ctx.conn_id, frame->handle, frame->length, frame->data);
+    if (sl_status == SL_STATUS_NO_MORE_RESOURCE) {
+      // Controller buffers are full, keep the frame and retry a bit later
+      struct sid_timespec when;
+      ble_tx_stats.buffer_full++;
+      sid_pal_uptime_now(&when);
+      sid_add_ms_to_timespec(&when, BLE_ADAPTER_TX_RETRY_MS);
+      (void)sid_pal_timer_arm(&ble_tx_retry_timer, SID_PAL_TIMER_PRIO_CLASS_PRECISE, &when, NULL);
+      break;
+    }
+
+    uint16_t length = frame->length;
+
+    sid_pal_enter_critical_region();
+    ble_tx_queue_tail = (ble_tx_queue_tail + 1) % BLE_ADAPTER_TX_QUEUE_DEPTH;
+    ble_tx_queue_count--;
+    sid_pal_exit_critical_region();
+
+    if (sl_status == SL_STATUS_OK) {
+      ble_tx_stats.frames_sent++;
+      ble_tx_stats.bytes_sent += length;
+      burst_frames++;
+      // Call the application (success)
+      ctx.callback->ind_callback(true);
+    } else {
+      ble_tx_stats.frames_dropped++;
+      SID_PAL_LOG_ERROR("pal: send notif failed");
+      // Call the application (failure)
+      ctx.callback->ind_callback(false);
+    }
+  }
+
+  if (burst_frames > 0) {
+    sl_ble_conn_on_tx_activity();
+    ble_tx_stats.bursts++;
+    ble_tx_stats.burst_frames_last = burst_frames;
+    if (burst_frames > ble_tx_stats.burst_frames_max) {
+      ble_tx_stats.burst_frames_max = burst_frames;
+    }
+  }
+}
+
+static void sl_ble_tx_queue_flush(void)
+{
+  if (is_ble_tx_retry_timer_initialized) {
+    (void)sid_pal_timer_cancel(&ble_tx_retry_timer);
+  }
+
+  // Every queued frame is reported as failed to the application
+  while (true) {
+    sid_pal_enter_critical_region();
+    if (ble_tx_queue_count == 0) {
+      sid_pal_exit_critical_region();
+      break;
+    }
+    ble_tx_queue_tail = (ble_tx_queue_tail + 1) % BLE_ADAPTER_TX_QUEUE_DEPTH;
+    ble_tx_queue_count--;
+    sid_pal_exit_critical_region();
+
+    ble_tx_stats.frames_dropped++;
+    if (ctx.callback != NULL) {
+      ctx.callback->ind_callback(false);
+    }
+  }
+}
+
+static void sl_ble_tx_retry_timer_cb(void *arg, sid_pal_timer_t *originator)
+{
+  (void)arg;
+  (void)originator;
+
+  // Timer context, the queue is drained from the Bluetooth event context
+  sl_bt_external_signal(BLE_ADAPTER_TX_EXTERNAL_SIGNAL);
+}
+
+static void sl_ble_conn_on_tx_activity(void)
+{
+#if BLE_ADAPTER_THROUGHPUT_PROFILE_ENABLE
+  struct sid_timespec now;
+
+  sid_pal_uptime_now(&now);
+  ble_conn_last_tx_ms = sid_timespec_to_ms(&now);
+
+  if (!ble_conn_stats.is_bulk) {
+    // Bulk transfer started, switch to the short connection interval
+    if (sl_bt_connection_set_parameters(ctx.conn_id,
+                                        BLE_ADAPTER_BULK_MIN_CONN_INTERVAL,
+                                        BLE_ADAPTER_BULK_MAX_CONN_INTERVAL,
+                                        0,
+                                        ctx.cfg->conn_param.conn_sup_timeout,
+                                        SL_BT_CONN_CE_LENGTH_MIN,
+                                        SL_BT_CONN_CE_LENGTH_MAX) == SL_STATUS_OK) {
+      ble_conn_stats.is_bulk = true;
+      ble_conn_stats.bulk_requests++;
+    }
+  }
+
+  if (ble_conn_stats.is_bulk && !sid_pal_timer_is_armed(&ble_conn_idle_timer)) {
+    struct sid_timespec when = now;
+    sid_add_ms_to_timespec(&when, BLE_ADAPTER_IDLE_TIMEOUT_MS);
+    (void)sid_pal_timer_arm(&ble_conn_idle_timer, SID_PAL_TIMER_PRIO_CLASS_LOWPOWER, &when, NULL);
+  }
+#endif
+}
+
+static void sl_ble_conn_on_idle_check(void)
+{
+  struct sid_timespec now;
+  uint32_t idle_ms;
+
+  if (!ctx.is_connected || !ble_conn_stats.is_bulk) {
+    return;
+  }
+
+  sid_pal_uptime_now(&now);
+  idle_ms = sid_timespec_to_ms(&now) - ble_conn_last_tx_ms;
+
+  if (idle_ms < BLE_ADAPTER_IDLE_TIMEOUT_MS) {
+    // There was TX activity since the timer was armed, check again later
+    struct sid_timespec when = now;
+    sid_add_ms_to_timespec(&when, BLE_ADAPTER_IDLE_TIMEOUT_MS - idle_ms);
+    (void)sid_pal_timer_arm(&ble_conn_idle_timer, SID_PAL_TIMER_PRIO_CLASS_LOWPOWER, &when, NULL);
+    return;
+  }
+
+  // Idle, go back to the configured low power connection parameters
+  if (sl_bt_connection_set_parameters(ctx.conn_id,
+                                      ctx.cfg->conn_param.min_conn_interval,
+                                      ctx.cfg->conn_param.max_conn_interval,
+                                      ctx.cfg->conn_param.slave_latency,
+                                      ctx.cfg->conn_param.conn_sup_timeout,
+                                      SL_BT_CONN_CE_LENGTH_MIN,
+                                      SL_BT_CONN_CE_LENGTH_MAX) == SL_STATUS_OK) {
+    ble_conn_stats.is_bulk = false;
+    ble_conn_stats.idle_requests++;
+  }
+}
+
+static void sl_ble_conn_idle_timer_cb(void *arg, sid_pal_timer_t *originator)
+{
+  (void)arg;
+  (void)originator;
+
+  // Timer context, the connection is updated from the Bluetooth event context
+  sl_bt_external_signal(BLE_ADAPTER_IDLE_EXTERNAL_SIGNAL);
+}
+
+static bool sl_ble_build_adv_payload(void)
+{
+  bool found = false;
+
+  is_adv_payload_valid = false;
+
+  if (!ctx.cfg->is_adv_available
+      || !ctx.cfg->adv_param.fast_enabled
+      || !ctx.cfg->adv_param.slow_enabled) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
+    if (ctx.cfg->adv_param.type == ctx.cfg->profile[i].service.type) {
+      found = true;
+      break;
+    }
+  }
+
+  if (!found || !sl_ble_convert_adv_address_type(&adv_address_type)) {
+    return false;
+  }
+
+  // ********** Generate the advertisement data template **********
+
+  uint8_t adv_buf_idx = 0;
+  memset(adv_payload, 0, sizeof(adv_payload));
+
+  // ====== Advertisement flags ======
+  uint8_t flags = SL_BT_ADV_FLAG_GENERAL_DISCOVERABLE | SL_BT_ADV_FLAG_BR_EDR_NOT_SUPPORTED;
+  adv_payload[adv_buf_idx] = sizeof(flags) + 1; // + 1 byte for the type
+  adv_payload[adv_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_FLAGS;
+  adv_payload[adv_buf_idx + 2] = flags;
+  adv_buf_idx += sizeof(flags) + 1 + 1;
+
+  // ====== Service UUID ======
+  adv_payload[adv_buf_idx] = UUID_LEN_16BIT + 1;  // + 1 byte for the type
+  adv_payload[adv_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_COMPLETE_16BIT_UUIDS;
+  // Little endian conversion (16-bit UUID)
+  adv_payload[adv_buf_idx + 2] = ctx.cfg->profile[0].service.id.uu[1];
+  adv_payload[adv_buf_idx + 3] = ctx.cfg->profile[0].service.id.uu[0];
+  adv_buf_idx += UUID_LEN_16BIT + 1 + 1;
+
+#if BLE_ADAPTER_EXTENDED_ADV_ENABLE
+  // ====== Optionally append device name ======
+  // A connectable extended advertisement has no scan response, the name is
+  // carried in the advertisement itself ahead of the manufacturer data
+  if ((ctx.cfg->name != NULL) && (strlen(ctx.cfg->name) > 0)) {
+    size_t name_len = strlen(ctx.cfg->name);
+    // Keep at least a legacy advertisement worth of room for the manufacturer data
+    size_t name_len_max = BLE_ADAPTER_ADV_DATA_LEN_MAX - adv_buf_idx
+                          - (BLE_COMPANY_ID_BYTE_LENGTH + 1 + 1) - SL_BT_MAX_LEGACY_ADV_DATA_LEN - 1 - 1;
+    if (name_len > name_len_max) {
+      SID_PAL_LOG_WARNING("pal: adv data does not fit");
+      name_len = name_len_max;
+    }
+    adv_payload[adv_buf_idx] = name_len + 1; // + 1 byte for the type
+    adv_payload[adv_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_COMPLETE_LOCAL_NAME;
+    memcpy(&adv_payload[adv_buf_idx + 2], ctx.cfg->name, name_len);
+    adv_buf_idx += name_len + 1 + 1;
+  }
+#endif
+
+  // ====== Manufacturer data header, the data is patched in on every update ======
+  adv_payload[adv_buf_idx] = BLE_COMPANY_ID_BYTE_LENGTH + 1;  // + 1 byte for the type
+  adv_payload[adv_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_MANUFACTURER_DATA;
+  adv_payload[adv_buf_idx + 2] = (uint8_t)(BLE_COMPANY_ID & 0xFF);
+  adv_payload[adv_buf_idx + 3] = (uint8_t)(BLE_COMPANY_ID >> 0x08);
+  adv_buf_idx += BLE_COMPANY_ID_BYTE_LENGTH + 1 + 1;
+  adv_payload_manuf_data_idx = adv_buf_idx;
+
+  // ********** Generate the scan response data **********
+
+  memset(scan_rsp_payload, 0, sizeof(scan_rsp_payload));
+  scan_rsp_payload_len = 0;
+
+#if !BLE_ADAPTER_EXTENDED_ADV_ENABLE
+
+  // ====== Optionally append device name ======
+  if ((ctx.cfg->name != NULL) && (strlen(ctx.cfg->name) > 0)) {
+    size_t name_len = strlen(ctx.cfg->name);
+    // Make sure the data fits. We need one extra byte for type and another for length
+    if (name_len + 1 + 1 > sizeof(scan_rsp_payload)) {
+      SID_PAL_LOG_WARNING("pal: adv data does not fit");
+      name_len = sizeof(scan_rsp_payload) - 1 - 1;
+    }
+    // Set the length, type, and data
+    scan_rsp_payload[0] = name_len + 1; // + 1 byte for the type
+    scan_rsp_payload[1] = SL_BT_ADV_DATA_TYPE_COMPLETE_LOCAL_NAME;
+    memcpy(&scan_rsp_payload[2], ctx.cfg->name, name_len);
+    scan_rsp_payload_len = name_len + 1 + 1;
+  }
+#endif
+
+  is_adv_payload_valid = true;
+  return true;
+}
+
+static bool sl_ble_convert_adv_address_type(uint8_t *address_type)
+{
+  // Convert the address type
+  switch (ctx.cfg->mac_addr_type) {
+    case SID_BLE_CFG_MAC_ADDRESS_TYPE_PUBLIC:
+      *address_type = sl_bt_gap_public_address;
+      break;
+
+    case SID_BLE_CFG_MAC_ADDRESS_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE:
+      *address_type = sl_bt_gap_random_nonresolvable_address;
+      break;
+
+    case SID_BLE_CFG_MAC_ADDRESS_TYPE_STATIC_RANDOM:
+      *address_type = sl_bt_gap_static_address;
+      break;
+
+    case SID_BLE_CFG_MAC_ADDRESS_TYPE_RANDOM_PRIVATE_RESOLVABLE:
+      *address_type = sl_bt_gap_random_resolvable_address;
+      break;
+
+    default:
+      return false;
+      break;
+  }
+
+  return true;
+}
+
+static sid_error_t sl_ble_configure_adv_address(void)
+{
+  uint8_t address_type = adv_address_type;
+  sl_status_t sl_status = SL_STATUS_OK;
+
+  // Set the address type
+  if (address_type == sl_bt_gap_public_address) {
+    // Clear the random address in order to use the default advertiser address
+    // which is either the public device address programmed at production or the
+    // address written into persistent storage using @ref sl_bt_system_set_identity_address command.
+    if (sl_bt_advertiser_clear_random_address(advertising_set_handle) != SL_STATUS_OK) {
+      SID_PAL_LOG_ERROR("pal: clear random addr failed");
+      return SID_ERROR_GENERIC;
+    }
+  } else {
+    // Random address
+    bd_addr address = { 0 };
+    bd_addr addressOut = { 0 };
+
+    // The address is one of the random address types. See which one
+    if (address_type == sl_bt_gap_static_address) {
+      // Advertisers with static random address use the same shared address.
+      // Generate it now if we don't have it already.
+      if (!have_adv_static_random_addr) {
+        // Get random bytes to construct a random address
+        size_t data_len = 0;
+        sl_status = sl_bt_system_get_random_data(sizeof(adv_static_random_addr.addr),
+                                                 sizeof(adv_static_random_addr.addr),
+                                                 &data_len,
+                                                 adv_static_random_addr.addr);
+        if (sl_status != SL_STATUS_OK) {
+          SID_PAL_LOG_ERROR("pal: failed to get random data");
+          return SID_ERROR_GENERIC;
+        }
+
+        // Make sure we got all the bytes we requested
+        if (data_len < sizeof(adv_static_random_addr.addr)) {
+          SID_PAL_LOG_ERROR("pal: failed to get enough random data");
+          return SID_ERROR_GENERIC;
+        }
+
+        // Set the type bits to indicate the correct type
+        adv_static_random_addr.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] &= ~SL_BT_ADDR_TYPE_MASK;
+        adv_static_random_addr.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] |= SL_BT_ADDR_TYPE_STATIC_RANDOM;
+
+        have_adv_static_random_addr = true;
+      }
+      // Copy the shared address
+      memcpy(address.addr, adv_static_random_addr.addr, sizeof(address.addr));
+    } else if (address_type == sl_bt_gap_random_nonresolvable_address) {
+      // Advertisers that use a random non-resolvable address get a fresh random address
+      size_t data_len = 0;
+      sl_status = sl_bt_system_get_random_data(sizeof(address.addr),
+                                               sizeof(address.addr),
+                                               &data_len,
+                                               address.addr);
+      if (sl_status != SL_STATUS_OK) {
+        SID_PAL_LOG_ERROR("pal: failed to get random data");
+        return SID_ERROR_GENERIC;
+      }
+
+      // Make sure we got all the bytes we requested
+      if (data_len < sizeof(address.addr)) {
+        SID_PAL_LOG_ERROR("pal: failed to get enough random data");
+        return SID_ERROR_GENERIC;
+      }
+
+      // Set the type bits to indicate the correct type
+      address.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] &= ~SL_BT_ADDR_TYPE_MASK;
+      address.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] |= SL_BT_ADDR_TYPE_NON_RESOLVABLE_PRIVATE;
+    } else {
+      // The type is a private resolvable random address.
+      // The Bluetooth stack will generate the address internally and ignores the passed address.
+    }
+
+    // Set random address for this advertiser
+    if (sl_bt_advertiser_set_random_address(advertising_set_handle, address_type, address, &addressOut) != SL_STATUS_OK) {
+      SID_PAL_LOG_ERROR("pal: set random addr for adv failed");
+      return SID_ERROR_GENERIC;
+    }
+  }
+
+  return SID_ERROR_NONE;
+}
+
+static sid_error_t sl_ble_configure_adv_set(void)
+{
+  // Return status value
+  sl_status_t sl_status = SL_STATUS_OK;
+
+  // Set the channel map
+  sl_status = sl_bt_advertiser_set_channel_map(advertising_set_handle,
+                                               SL_BT_CHANNEL_MAP);
+  if (sl_status != SL_STATUS_OK) {
+    SID_PAL_LOG_ERROR("pal: set channel map failed");
+    return SID_ERROR_GENERIC;
+  }
+
+  // Set the power level
+  int16_t set_tx_power = 0;
+  sl_status = sl_bt_advertiser_set_tx_power(advertising_set_handle,
+                                            SL_BT_CONFIG_MAX_TX_POWER,
+                                            &set_tx_power);
+  if (sl_status != SL_STATUS_OK) {
+    SID_PAL_LOG_ERROR("pal: set the pwr lvl failed");
+    return SID_ERROR_GENERIC;
   }
-  if (xPermissions & SL_BT_PERM_WRITE_ENCRYPTED) {
-    retVal |= SL_BT_GATTDB_ENCRYPTED_WRITE;
+
+#if BLE_ADAPTER_EXTENDED_ADV_ENABLE
+  // Set the primary and secondary advertising PHYs
+  sl_status = sl_bt_extended_advertiser_set_phy(advertising_set_handle,
+                                                BLE_ADAPTER_EXTENDED_ADV_PRIMARY_PHY,
+                                                BLE_ADAPTER_EXTENDED_ADV_SECONDARY_PHY);
+  if (sl_status != SL_STATUS_OK) {
+    SID_PAL_LOG_ERROR("pal: set adv phy failed");
+    return SID_ERROR_GENERIC;
   }
-  if (xPermissions & SL_BT_PERM_WRITE_ENCRYPTED_MITM) {
-    retVal |= SL_BT_GATTDB_AUTHENTICATED_WRITE;
+#else
+  // Set the scan response, it does not change afterwards
+  if (sl_bt_legacy_advertiser_set_data(advertising_set_handle, sl_bt_advertiser_scan_response_packet, scan_rsp_payload_len, scan_rsp_payload) != SL_STATUS_OK) {
+    SID_PAL_LOG_ERROR("pal: set scan resp data failed");
+    return SID_ERROR_GENERIC;
   }
+#endif
 
-  return retVal;
+  return SID_ERROR_NONE;
 }
 
 static sid_error_t ble_adapter_init(const sid_ble_config_t *cfg)
@@ -444,39 +1119,58 @@ static sid_error_t ble_adapter_init(const sid_ble_config_t *cfg)
   ctx.cfg = cfg;
   ctx.mtu_size = cfg->mtu;
 
-  // Allocate memory dinamically for BLE profile
-  ble_profile = (sid_pal_ble_profile_config_t *)sl_malloc(ctx.cfg->num_profile * sizeof(sid_pal_ble_profile_config_t));
-  if (!ble_profile) {
-    SID_PAL_LOG_ERROR("pal: sid BLE profile mem alloc failed");
+  if (!is_ble_tx_retry_timer_initialized) {
+    if (sid_pal_timer_init(&ble_tx_retry_timer, sl_ble_tx_retry_timer_cb, NULL) != SID_ERROR_NONE) {
+      SID_PAL_LOG_ERROR("pal: sid BLE TX timer init failed");
+      return SID_ERROR_GENERIC;
+    }
+    is_ble_tx_retry_timer_initialized = true;
+  }
+
+  if (!is_ble_conn_idle_timer_initialized) {
+    if (sid_pal_timer_init(&ble_conn_idle_timer, sl_ble_conn_idle_timer_cb, NULL) != SID_ERROR_NONE) {
+      SID_PAL_LOG_ERROR("pal: sid BLE idle timer init failed");
+      return SID_ERROR_GENERIC;
+    }
+    is_ble_conn_idle_timer_initialized = true;
+  }
+
+  // Assign the statically allocated handle storage to the BLE profiles
+  if (ctx.cfg->num_profile > BLE_ADAPTER_MAX_PROFILES) {
+    SID_PAL_LOG_ERROR("pal: sid BLE profile count exceeds %d", BLE_ADAPTER_MAX_PROFILES);
     return SID_ERROR_GENERIC;
-  } else {
-    // Allocate memory dinamically for BLE characteristics and descriptors based on config file
-    for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
-      ble_profile[i].current_service_handle = 0;
-      ble_profile[i].current_characteristic_handle = (uint16_t *)sl_malloc(ctx.cfg->profile[i].char_count * sizeof(uint16_t));
-      if (!ble_profile[i].current_characteristic_handle) {
-        sl_free(ble_profile);
-        ble_profile = NULL;
-        SID_PAL_LOG_ERROR("pal: sid BLE characteristic mem alloc failed");
-        return SID_ERROR_GENERIC;
-      } else {
-        ble_profile[i].current_descriptor_handle = (uint16_t *)sl_malloc(ctx.cfg->profile[i].desc_count * sizeof(uint16_t));
-        if (!ble_profile[i].current_descriptor_handle) {
-          sl_free(ble_profile[i].current_characteristic_handle);
-          ble_profile[i].current_characteristic_handle = NULL;
-          sl_free(ble_profile);
-          ble_profile = NULL;
-          SID_PAL_LOG_ERROR("pal: sid BLE descriptor mem alloc failed");
-          return SID_ERROR_GENERIC;
-        }
-      }
+  }
+
+  sl_ble_free_resources();
+
+  uint16_t attr_count = 0;
+  for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
+    if (ctx.cfg->profile[i].service.type >= BLE_ADAPTER_SERVICE_ID_COUNT) {
+      SID_PAL_LOG_ERROR("pal: invalid sid BLE service type");
+      return SID_ERROR_GENERIC;
+    }
+
+    if (attr_count + ctx.cfg->profile[i].char_count + ctx.cfg->profile[i].desc_count > BLE_ADAPTER_MAX_ATTRIBUTES) {
+      SID_PAL_LOG_ERROR("pal: sid BLE attribute count exceeds %d", BLE_ADAPTER_MAX_ATTRIBUTES);
+      return SID_ERROR_GENERIC;
     }
+
+    ble_profile_storage[i].current_characteristic_handle = &ble_attr_handle_storage[attr_count];
+    attr_count += ctx.cfg->profile[i].char_count;
+    ble_profile_storage[i].current_descriptor_handle = &ble_attr_handle_storage[attr_count];
+    attr_count += ctx.cfg->profile[i].desc_count;
   }
+  ble_profile = ble_profile_storage;
 
   if (is_fast_adv_active) {
     memcpy(&adv_timing_params, &cfg->adv_param, sizeof(sid_ble_cfg_adv_param_t));
   }
 
+  // Build the static parts of the advertisement and scan response once
+  if (!sl_ble_build_adv_payload()) {
+    SID_PAL_LOG_WARNING("pal: sid BLE adv config invalid, advertising disabled");
+  }
+
   sl_status_t sl_status = SL_STATUS_FAIL;
 
   // Request the stack to start
@@ -555,7 +1249,7 @@ static sid_error_t ble_adapter_init(const sid_ble_config_t *cfg)
 
 static sid_error_t ble_adapter_start_service(void)
 {
-  if (!ctx.cfg->num_profile) {
+  if (!ctx.cfg->num_profile || (ble_profile == NULL)) {
     sl_ble_free_resources();
     return SID_ERROR_INVALID_ARGS;
   }
@@ -883,6 +1577,13 @@ static sid_error_t ble_adapter_start_service(void)
     }
   }
 
+  // *********** Build attribute dispatch table ***********
+  if (!sl_ble_build_attr_table()) {
+    sl_ble_free_resources();
+    SID_PAL_LOG_ERROR("pal: sid BLE attribute handles exceed the dispatch table");
+    return SID_ERROR_GENERIC;
+  }
+
   // *********** Start Service ***********
   for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
     // Start a new GATT database update session
@@ -915,24 +1616,13 @@ static sid_error_t ble_adapter_set_adv_data(uint8_t *data, uint8_t length)
   if (!data
       || !length
       || (length > ctx.mtu_size)
-      || !ctx.cfg->is_adv_available
-      || !ctx.cfg->adv_param.fast_enabled
-      || !ctx.cfg->adv_param.slow_enabled) {
+      || (length > (BLE_ADAPTER_ADV_DATA_LEN_MAX - adv_payload_manuf_data_idx))) {
     SID_PAL_LOG_ERROR("pal: invalid adv params");
     return SID_ERROR_INVALID_ARGS;
   }
 
-  bool found = false;
-
-  for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
-    if (ctx.cfg->adv_param.type == ctx.cfg->profile[i].service.type) {
-      found = true;
-      break;
-    }
-  }
-
-  if (!found) {
-    SID_PAL_LOG_ERROR("pal: invalid service type");
+  if (!is_adv_payload_valid) {
+    SID_PAL_LOG_ERROR("pal: invalid adv config");
     return SID_ERROR_INCOMPATIBLE_PARAMS;
   }
 
@@ -946,252 +1636,60 @@ static sid_error_t ble_adapter_set_adv_data(uint8_t *data, uint8_t length)
 
   // ********** Set the advertising parameters **********
 
-  // Convert the address type
-  uint8_t address_type;
-  switch (ctx.cfg->mac_addr_type) {
-    case SID_BLE_CFG_MAC_ADDRESS_TYPE_PUBLIC:
-      address_type = sl_bt_gap_public_address;
-      break;
-
-    case SID_BLE_CFG_MAC_ADDRESS_TYPE_RANDOM_PRIVATE_NON_RESOLVABLE:
-      address_type = sl_bt_gap_random_nonresolvable_address;
-      break;
-
-    case SID_BLE_CFG_MAC_ADDRESS_TYPE_STATIC_RANDOM:
-      address_type = sl_bt_gap_static_address;
-      break;
-
-    case SID_BLE_CFG_MAC_ADDRESS_TYPE_RANDOM_PRIVATE_RESOLVABLE:
-      address_type = sl_bt_gap_random_resolvable_address;
-      break;
-
-    default:
-      SID_PAL_LOG_ERROR("pal: invalid addr type");
-      return SID_ERROR_GENERIC;
-      break;
-  }
-
-  // Return status value
-  sl_status_t sl_status = SL_STATUS_OK;
-
-  // Set the address type
-  if (address_type == sl_bt_gap_public_address) {
-    // Clear the random address in order to use the default advertiser address
-    // which is either the public device address programmed at production or the
-    // address written into persistent storage using @ref sl_bt_system_set_identity_address command.
-    if (sl_bt_advertiser_clear_random_address(advertising_set_handle) != SL_STATUS_OK) {
-      SID_PAL_LOG_ERROR("pal: clear random addr failed");
-      return SID_ERROR_GENERIC;
+  // The address, channel map, power level and scan response only change when
+  // the advertiser set is (re)created. A non-resolvable private address is
+  // renewed on every update.
+  if (!is_adv_set_configured || (adv_address_type == sl_bt_gap_random_nonresolvable_address)) {
+    sid_error_t ret = sl_ble_configure_adv_address();
+    if (ret != SID_ERROR_NONE) {
+      return ret;
     }
-  } else {
-    // Random address
-    bd_addr address = { 0 };
-    bd_addr addressOut = { 0 };
-
-    // The address is one of the random address types. See which one
-    if (address_type == sl_bt_gap_static_address) {
-      // Advertisers with static random address use the same shared address.
-      // Generate it now if we don't have it already.
-      if (!have_adv_static_random_addr) {
-        // Get random bytes to construct a random address
-        size_t data_len = 0;
-        sl_status = sl_bt_system_get_random_data(sizeof(adv_static_random_addr.addr),
-                                                 sizeof(adv_static_random_addr.addr),
-                                                 &data_len,
-                                                 adv_static_random_addr.addr);
-        if (sl_status != SL_STATUS_OK) {
-          SID_PAL_LOG_ERROR("pal: failed to get random data");
-          return SID_ERROR_GENERIC;
-        }
-
-        // Make sure we got all the bytes we requested
-        if (data_len < sizeof(adv_static_random_addr.addr)) {
-          SID_PAL_LOG_ERROR("pal: failed to get enough random data");
-          return SID_ERROR_GENERIC;
-        }
-
-        // Set the type bits to indicate the correct type
-        adv_static_random_addr.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] &= ~SL_BT_ADDR_TYPE_MASK;
-        adv_static_random_addr.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] |= SL_BT_ADDR_TYPE_STATIC_RANDOM;
-
-        have_adv_static_random_addr = true;
-      }
-      // Copy the shared address
-      memcpy(address.addr, adv_static_random_addr.addr, sizeof(address.addr));
-    } else if (address_type == sl_bt_gap_random_nonresolvable_address) {
-      // Advertisers that use a random non-resolvable address get a fresh random address
-      size_t data_len = 0;
-      sl_status = sl_bt_system_get_random_data(sizeof(address.addr),
-                                               sizeof(address.addr),
-                                               &data_len,
-                                               address.addr);
-      if (sl_status != SL_STATUS_OK) {
-        SID_PAL_LOG_ERROR("pal: failed to get random data");
-        return SID_ERROR_GENERIC;
-      }
-
-      // Make sure we got all the bytes we requested
-      if (data_len < sizeof(address.addr)) {
-        SID_PAL_LOG_ERROR("pal: failed to get enough random data");
-        return SID_ERROR_GENERIC;
-      }
+  }
 
-      // Set the type bits to indicate the correct type
-      address.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] &= ~SL_BT_ADDR_TYPE_MASK;
-      address.addr[SL_BT_ADDR_TYPE_BYTE_INDEX] |= SL_BT_ADDR_TYPE_NON_RESOLVABLE_PRIVATE;
-    } else {
-      // The type is a private resolvable random address.
-      // The Bluetooth stack will generate the address internally and ignores the passed address.
+  if (!is_adv_set_configured) {
+    sid_error_t ret = sl_ble_configure_adv_set();
+    if (ret != SID_ERROR_NONE) {
+      return ret;
     }
+    is_adv_set_configured = true;
+  }
 
-    // Set random address for this advertiser
-    if (sl_bt_advertiser_set_random_address(advertising_set_handle, address_type, address, &addressOut) != SL_STATUS_OK) {
-      SID_PAL_LOG_ERROR("pal: set random addr for adv failed");
+  // Set timing parameters when switching between fast and slow advertisement
+  if (!is_adv_timing_applied
+      || (adv_applied_interval != adv_timing_params.fast_interval)
+      || (adv_applied_timeout != adv_timing_params.fast_timeout)) {
+    if (sl_bt_advertiser_set_timing(advertising_set_handle,
+                                    adv_timing_params.fast_interval,
+                                    adv_timing_params.fast_interval,
+                                    adv_timing_params.fast_timeout, 0) != SL_STATUS_OK) {
+      SID_PAL_LOG_ERROR("pal: set timing params failed");
       return SID_ERROR_GENERIC;
     }
+    adv_applied_interval = adv_timing_params.fast_interval;
+    adv_applied_timeout = adv_timing_params.fast_timeout;
+    is_adv_timing_applied = true;
   }
 
-  // Set timing parameters
-  sl_status = sl_bt_advertiser_set_timing(advertising_set_handle,
-                                          adv_timing_params.fast_interval,
-                                          adv_timing_params.fast_interval,
-                                          adv_timing_params.fast_timeout, 0);
-  if (sl_status != SL_STATUS_OK) {
-    SID_PAL_LOG_ERROR("pal: set timing params failed");
-    return SID_ERROR_GENERIC;
-  }
-
-  // Set the channel map
-  sl_status = sl_bt_advertiser_set_channel_map(advertising_set_handle,
-                                               SL_BT_CHANNEL_MAP);
-  if (sl_status != SL_STATUS_OK) {
-    SID_PAL_LOG_ERROR("pal: set channel map failed");
-    return SID_ERROR_GENERIC;
-  }
-
-  // Set the power level
-  int16_t set_tx_power = 0;
-  sl_status = sl_bt_advertiser_set_tx_power(advertising_set_handle,
-                                            SL_BT_CONFIG_MAX_TX_POWER,
-                                            &set_tx_power);
-  if (sl_status != SL_STATUS_OK) {
-    SID_PAL_LOG_ERROR("pal: set the pwr lvl failed");
-    return SID_ERROR_GENERIC;
-  }
-
-  // ********** Generate the advertisement data **********
-
-  // Legacy advertisement
-  uint8_t adv_buf[SL_BT_MAX_LEGACY_ADV_DATA_LEN];
-  memset(adv_buf, 0, sizeof(adv_buf));
-  size_t adv_data_len = 0;
-  uint32_t size_remaining = sizeof(adv_buf);
-  uint32_t entry_size = 0;
-  uint8_t adv_buf_idx = 0;
-
-  // ====== Optionally append advertisement flags ======
-  uint8_t flags = SL_BT_ADV_FLAG_GENERAL_DISCOVERABLE | SL_BT_ADV_FLAG_BR_EDR_NOT_SUPPORTED;
-  // Make sure the data fits. We need one extra byte for type and another for length
-  entry_size = sizeof(flags) + 1 + 1;
-  if (size_remaining < entry_size) {
-    SID_PAL_LOG_WARNING("pal: adv data does not fit");
-  }
-  // Set the length, type, and data
-  adv_buf[adv_buf_idx] = sizeof(flags) + 1; // + 1 byte for the type
-  adv_buf[adv_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_FLAGS;
-  if (sizeof(flags) > 0) {
-    memcpy(&adv_buf[adv_buf_idx + 2], &flags, sizeof(flags));
-  }
-  size_remaining -= entry_size;
-  adv_buf_idx += entry_size;
-
-  // ====== Optionally append service UUIDs ======
-  // Make sure the data fits. We need one extra byte for type and another for length
-  size_t uuid_len = UUID_LEN_16BIT;
-  entry_size = uuid_len + 1 + 1;
-  if (size_remaining < entry_size) {
-    SID_PAL_LOG_WARNING("pal: adv data does not fit");
-  }
-  // Set the length, type, and data
-  adv_buf[adv_buf_idx] = uuid_len + 1;  // + 1 byte for the type
-  adv_buf[adv_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_COMPLETE_16BIT_UUIDS;
-  // Little endian conversion (16-bit UUID)
-  uint8_t little_endian_uuid[2] = { 0, 0 };
-  little_endian_uuid[0] = ctx.cfg->profile[0].service.id.uu[1];
-  little_endian_uuid[1] = ctx.cfg->profile[0].service.id.uu[0];
-  if (uuid_len > 0) {
-    memcpy(&adv_buf[adv_buf_idx + 2], little_endian_uuid, uuid_len);
-  }
-  size_remaining -= entry_size;
-  adv_buf_idx += entry_size;
-
-  // ====== Optionally append manufacturer data ======
-  uint8_t manufacturer_len = length + BLE_COMPANY_ID_BYTE_LENGTH;
-  uint8_t manuf_data[manufacturer_len];
-  memset(manuf_data, 0, manufacturer_len);
-  manuf_data[0] = (uint8_t)(BLE_COMPANY_ID & 0xFF);
-  manuf_data[1] = (uint8_t)(BLE_COMPANY_ID >> 0x08);
-  memcpy(&manuf_data[2], data, length);
-
-  if (manufacturer_len > 0) {
-    // Make sure the data fits. We need one extra byte for type and another for length
-    entry_size = manufacturer_len + 1 + 1;
-    if (size_remaining < entry_size) {
-      SID_PAL_LOG_WARNING("pal: adv data does not fit");
-    }
-    // Set the length, type, and data
-    adv_buf[adv_buf_idx] = manufacturer_len + 1;  // + 1 byte for the type
-    adv_buf[adv_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_MANUFACTURER_DATA;
-
-    memcpy(&adv_buf[adv_buf_idx + 2], manuf_data, manufacturer_len);
-
-    size_remaining -= entry_size;
-    adv_buf_idx += entry_size;
-  }
+  // ********** Patch the manufacturer data into the prebuilt advertisement **********
 
-  // Set the final size
-  adv_data_len = sizeof(adv_buf) - size_remaining;
+  adv_payload[adv_payload_manuf_data_idx - BLE_COMPANY_ID_BYTE_LENGTH - 2] = length + BLE_COMPANY_ID_BYTE_LENGTH + 1; // + 1 byte for the type
+  memcpy(&adv_payload[adv_payload_manuf_data_idx], data, length);
 
   // Set the user data to the Bluetooth stack
-  if (sl_bt_legacy_advertiser_set_data(advertising_set_handle, sl_bt_advertiser_advertising_data_packet, adv_data_len, adv_buf) != SL_STATUS_OK) {
+#if BLE_ADAPTER_EXTENDED_ADV_ENABLE
+  if (sl_bt_extended_advertiser_set_data(advertising_set_handle,
+                                         adv_payload_manuf_data_idx + length,
+                                         adv_payload) != SL_STATUS_OK) {
+#else
+  if (sl_bt_legacy_advertiser_set_data(advertising_set_handle,
+                                       sl_bt_advertiser_advertising_data_packet,
+                                       adv_payload_manuf_data_idx + length,
+                                       adv_payload) != SL_STATUS_OK) {
+#endif
     SID_PAL_LOG_ERROR("pal: set adv data failed");
     return SID_ERROR_GENERIC;
   }
 
-  // ********** Generate the scan response data **********
-
-  uint8_t scan_rsp_buf[SL_BT_MAX_LEGACY_ADV_DATA_LEN];
-  memset(scan_rsp_buf, 0, sizeof(scan_rsp_buf));
-  size_t scan_rsp_data_len = 0;
-  uint32_t size_remaining_scan_rsp = sizeof(scan_rsp_buf);
-  uint32_t entry_size_scan_rsp = 0;
-  uint8_t scan_rsp_buf_idx = 0;
-
-  // ====== Optionally append device name ======
-  if ((ctx.cfg->name != NULL) && (strlen(ctx.cfg->name) > 0)) {
-    // Make sure the data fits. We need one extra byte for type and another for length
-    entry_size_scan_rsp = strlen(ctx.cfg->name) + 1 + 1;
-    if (size_remaining_scan_rsp < entry_size_scan_rsp) {
-      SID_PAL_LOG_WARNING("pal: adv data does not fit");
-    }
-    // Set the length, type, and data
-    scan_rsp_buf[scan_rsp_buf_idx] = strlen(ctx.cfg->name) + 1; // + 1 byte for the type
-    scan_rsp_buf[scan_rsp_buf_idx + 1] = SL_BT_ADV_DATA_TYPE_COMPLETE_LOCAL_NAME;
-    memcpy(&scan_rsp_buf[scan_rsp_buf_idx + 2], ctx.cfg->name, strlen(ctx.cfg->name));
-
-    size_remaining_scan_rsp -= entry_size_scan_rsp;
-    scan_rsp_buf_idx += entry_size_scan_rsp;
-  }
-
-  // Set the final size
-  scan_rsp_data_len = sizeof(scan_rsp_buf) - size_remaining_scan_rsp;
-
-  // Set the user data to the Bluetooth stack
-  if (sl_bt_legacy_advertiser_set_data(advertising_set_handle, sl_bt_advertiser_scan_response_packet, scan_rsp_data_len, scan_rsp_buf) != SL_STATUS_OK) {
-    SID_PAL_LOG_ERROR("pal: set scan resp data failed");
-    return SID_ERROR_GENERIC;
-  }
-
   return SID_ERROR_NONE;
 }
 
@@ -1206,7 +1704,11 @@ static sid_error_t ble_adapter_start_advertisement(void)
   }
 
   // Start advertising with user-defined data to listen for incoming connections
+#if BLE_ADAPTER_EXTENDED_ADV_ENABLE
+  if (sl_bt_extended_advertiser_start(advertising_set_handle, sl_bt_extended_advertiser_connectable, 0) != SL_STATUS_OK) {
+#else
   if (sl_bt_legacy_advertiser_start(advertising_set_handle, sl_bt_legacy_advertiser_connectable) != SL_STATUS_OK) {
+#endif
     SID_PAL_LOG_ERROR("pal: start adv failed");
     return SID_ERROR_GENERIC;
   }
@@ -1238,43 +1740,42 @@ static sid_error_t ble_adapter_send_data(sid_ble_cfg_service_identifier_t id, ui
     return SID_ERROR_PORT_NOT_OPEN;
   }
 
-  if (!data || !length || (length > ctx.mtu_size)) {
+  if (!data || !length || (length > ctx.mtu_size) || (length > BLE_ADAPTER_TX_FRAME_SIZE_MAX)) {
     SID_PAL_LOG_ERROR("pal: invalid args");
     return SID_ERROR_INVALID_ARGS;
   }
 
-  uint16_t handle = 0;
-  bool found = false;
+  uint16_t handle = (id < BLE_ADAPTER_SERVICE_ID_COUNT) ? ble_notify_handle[id] : 0;
 
-  for (uint8_t i = 0; i < ctx.cfg->num_profile; i++) {
-    if (id == ctx.cfg->profile[i].service.type) {
-      for (uint8_t j = 0; j < ctx.cfg->profile[i].char_count; j++) {
-        if (ctx.cfg->profile[i].characteristic[j].properties.is_notify) {
-          handle = ble_profile[i].current_characteristic_handle[j];
-          found = true;
-          break;
-        }
-      }
-    }
-    if (found) {
-      break;
-    }
+  if (handle == 0) {
+    SID_PAL_LOG_ERROR("pal: invalid arg to send notif");
+    return SID_ERROR_INVALID_ARGS;
   }
 
-  if (found) {
-    // Notification does not need confirmation
-    if (sl_bt_gatt_server_send_notification(ctx.conn_id, handle, length, data) != SL_STATUS_OK) {
-      // Call the application (failure)
-      ctx.callback->ind_callback(false);
+  // Queue the frame, the result is reported through ind_callback once the
+  // stack accepted it (or the frame was dropped)
+  sid_pal_enter_critical_region();
+  if (ble_tx_queue_count >= BLE_ADAPTER_TX_QUEUE_DEPTH) {
+    ble_tx_stats.frames_rejected++;
+    sid_pal_exit_critical_region();
+    SID_PAL_LOG_WARNING("pal: sid BLE TX queue full");
+    return SID_ERROR_OUT_OF_RESOURCES;
+  }
+  sid_pal_ble_tx_frame_t *frame = &ble_tx_queue[ble_tx_queue_head];
+  frame->handle = handle;
+  frame->length = length;
+  memcpy(frame->data, data, length);
+  ble_tx_queue_head = (ble_tx_queue_head + 1) % BLE_ADAPTER_TX_QUEUE_DEPTH;
+  ble_tx_queue_count++;
+  ble_tx_stats.frames_queued++;
+  if (ble_tx_queue_count > ble_tx_stats.queue_depth_max) {
+    ble_tx_stats.queue_depth_max = ble_tx_queue_count;
+  }
+  sid_pal_exit_critical_region();
 
-      SID_PAL_LOG_ERROR("pal: send notif failed");
-      return SID_ERROR_GENERIC;
-    }
-    // Call the application (success)
-    ctx.callback->ind_callback(true);
-  } else {
-    SID_PAL_LOG_ERROR("pal: invalid arg to send notif");
-    return SID_ERROR_INVALID_ARGS;
+  // Wake up the Bluetooth event context to send it
+  if (sl_bt_external_signal(BLE_ADAPTER_TX_EXTERNAL_SIGNAL) != SL_STATUS_OK) {
+    SID_PAL_LOG_ERROR("pal: sid BLE TX signal failed");
   }
 
   return SID_ERROR_NONE;
@@ -1321,9 +1822,12 @@ static sid_error_t ble_adapter_deinit(void)
   if (advertising_set_handle != SL_BT_INVALID_ADVERTISING_SET_HANDLE) {
     sl_bt_advertiser_delete_set(advertising_set_handle);
     advertising_set_handle = SL_BT_INVALID_ADVERTISING_SET_HANDLE;
+    is_adv_set_configured = false;
+    is_adv_timing_applied = false;
   }
 
-  // Cleanup the resources
+  // Drop the pending notifications and cleanup the resources
+  sl_ble_tx_queue_flush();
   sl_ble_free_resources();
 
   // Stop the Bluetooth stack
@@ -1369,6 +1873,11 @@ static void sl_ble_adapter_on_connection_opened(sl_bt_evt_connection_opened_t *e
     bd_addr remote_addr;
     memcpy(remote_addr.addr, event->address.addr, sizeof(remote_addr.addr));
 
+    // TX and connection statistics are kept per connection
+    sl_ble_adapter_reset_tx_stats();
+    memset(&ble_conn_stats, 0, sizeof(ble_conn_stats));
+    ble_conn_stats.phy = sl_bt_gap_phy_1m;
+
     // Let the GATT Server call the corresponding callback
     ble_connection_cb_fnc(event->connection, true, &remote_addr);
 
@@ -1378,6 +1887,20 @@ static void sl_ble_adapter_on_connection_opened(sl_bt_evt_connection_opened_t *e
       (void)sl_bt_advertiser_stop(advertising_set_handle);
       is_adv_active = false;
     }
+
+#if BLE_ADAPTER_THROUGHPUT_PROFILE_ENABLE
+    // Request 2M PHY and long LL PDUs, the central may refuse either of them.
+    // The outcome is reported by the PHY status and data length events.
+    // A connection made over the Coded PHY stays there to keep the range.
+#if !(BLE_ADAPTER_EXTENDED_ADV_ENABLE && BLE_ADAPTER_EXTENDED_ADV_CODED_PHY_ENABLE)
+    if (sl_bt_connection_set_preferred_phy(event->connection, sl_bt_gap_phy_2m, sl_bt_gap_phy_any) != SL_STATUS_OK) {
+      SID_PAL_LOG_WARNING("pal: set preferred PHY failed");
+    }
+#endif
+    if (sl_bt_connection_set_data_length(event->connection, BLE_ADAPTER_DLE_TX_OCTETS, BLE_ADAPTER_DLE_TX_TIME_US) != SL_STATUS_OK) {
+      SID_PAL_LOG_WARNING("pal: set data length failed");
+    }
+#endif
   }
 }
 
@@ -1388,6 +1911,14 @@ static void sl_ble_adapter_on_connection_closed(sl_bt_evt_connection_closed_t *e
   bd_addr remote_addr;
   memcpy(remote_addr.addr, ctx.bt_addr, sizeof(remote_addr.addr));
   ble_connection_cb_fnc(event->connection, false, &remote_addr);
+
+  // Frames that could not be sent on this connection are dropped
+  sl_ble_tx_queue_flush();
+
+  if (is_ble_conn_idle_timer_initialized) {
+    (void)sid_pal_timer_cancel(&ble_conn_idle_timer);
+  }
+  ble_conn_stats.is_bulk = false;
 }
 
 static void sl_ble_adapter_on_gatt_server_characteristic_status_id(sl_bt_evt_gatt_server_characteristic_status_t *event)
@@ -1456,5 +1987,31 @@ static void sl_ble_adapter_on_gatt_server_user_write_request_id(sl_bt_evt_gatt_s
 
 static void sl_ble_adapter_on_gatt_mtu_exchanged_id(sl_bt_evt_gatt_mtu_exchanged_t *event)
 {
+  ble_conn_stats.mtu = event->mtu;
   ctx.callback->mtu_callback(event->mtu);
 }
+
+static void sl_ble_adapter_on_connection_parameters(sl_bt_evt_connection_parameters_t *event)
+{
+  if (event->connection == ctx.conn_id) {
+    ble_conn_stats.interval = event->interval;
+    ble_conn_stats.latency = event->latency;
+    ble_conn_stats.timeout = event->timeout;
+    ble_conn_stats.txsize = event->txsize;
+  }
+}
+
+static void sl_ble_adapter_on_connection_phy_status(sl_bt_evt_connection_phy_status_t *event)
+{
+  if (event->connection == ctx.conn_id) {
+    ble_conn_stats.phy = event->phy;
+  }
+}
+
+static void sl_ble_adapter_on_connection_data_length(sl_bt_evt_connection_data_length_t *event)
+{
+  if (event->connection == ctx.conn_id) {
+    ble_conn_stats.tx_data_len = event->tx_data_len;
+    ble_conn_stats.rx_data_len = event->rx_data_len;
+  }
+}
@@ -317,12 +317,24 @@ int32_t sid_pal_radio_start_continuous_rx(void)
   return sid_pal_radio_start_rx(0);
 }
 
-// Not used by Silabs
 int32_t sid_pal_radio_set_rx_duty_cycle(uint32_t rx_time, uint32_t sleep_time)
 {
-  (void)rx_time;
-  (void)sleep_time;
-  return RADIO_ERROR_NOT_SUPPORTED;
+  int32_t err = RADIO_ERROR_NONE;
+
+  if (rx_time == 0 || sleep_time == 0) {
+    err = RADIO_ERROR_INVALID_PARAMS;
+    goto ret;
+  }
+
+  if (efr32xgxx_set_rx_duty_cycle(rx_time, sleep_time) != RADIO_ERROR_NONE) {
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
+
+  drv_ctx.radio_state = SID_PAL_RADIO_RX_DC;
+
+  ret:
+  return err;
 }
 
 int16_t sid_pal_radio_rssi(void)
@@ -39,13 +39,17 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 #include <stdbool.h>
+#include "em_core.h"
 #include <sid_clock_ifc.h>
 #include <sid_pal_delay_ifc.h>
 #include <sid_pal_log_ifc.h>
 #include <sid_pal_assert_ifc.h>
+#include <sid_pal_temperature_ifc.h>
 
 #include "silabs/efr32xgxx.h"
 #include "efr32xgxx_radio.h"
+#include "temperature.h"
+#include "nvm3_manager.h"
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
@@ -70,6 +74,7 @@
 #define EFR32XGXX_RAIL_50KBPS_IDX                   (0)
 #define EFR32XGXX_RAIL_150KBPS_IDX                  (1)
 #define EFR32XGXX_RAIL_250KBPS_IDX                  (2)
+#define EFR32XGXX_RAIL_PROFILE_COUNT                (3)
 
 #define EFR32XGXX_SYNCWORD_BYTES                    (8)
 
@@ -87,6 +92,33 @@
 #define POLYNOMIAL_CRC16                            (0x1021)
 #define POLYNOMIAL_CRC32                            (0x04C11DB7)
 
+// Lead time kept in front of a scheduled rx window so RAIL can wake the radio from EM2 in time
+#define EFR32XGXX_RX_DC_MIN_LEAD_US                 (EFR32XGXX_RADIO_WARMUP_VALUE)
+
+// VCO temperature calibration is run when the temperature moved by this much (milli degree Celsius)
+#ifndef EFR32XGXX_TEMP_CAL_DELTA
+#define EFR32XGXX_TEMP_CAL_DELTA                    (5000)
+#endif
+
+// NVM3 object the one-time IR calibration result is kept in across boots,
+// allocated in the PAL range of nvm3_manager.h
+#ifndef EFR32XGXX_IRCAL_NVM3_KEY
+#define EFR32XGXX_IRCAL_NVM3_KEY                    SLI_SID_NVM3_MAP_KEY(PAL, SLI_SID_NVM3_PAL_KEY_RADIO_IRCAL)
+#endif
+
+// Layout of the stored IR calibration, values with another version are measured again
+#define EFR32XGXX_IRCAL_CACHE_VERSION               (1)
+
+// IR calibration result as stored in NVM3, together with what it was measured
+// with. The values are only reused when all of it still matches.
+typedef struct {
+  uint32_t version;
+  uint32_t rail_version;
+  uint32_t phy_tag;
+  RAIL_AntennaSel_t rf_path;
+  RAIL_IrCalValues_t values;
+} efr32xgxx_ircal_cache_t;
+
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
 // Greater the priority value, lesser the priority
 #define EFR32XGXX_RX_PRIORITY                       (200)
@@ -107,6 +139,14 @@ static void efr32xgxx_rfready(RAIL_Handle_t rail_handle);
 static void efr32xgxx_event_notify(sid_pal_radio_events_t radio_event);
 static void efr32xgxx_rx_timer_expired(RAIL_Handle_t rail_handle);
 static void efr32xgxx_tx_timer_expired(RAIL_Handle_t rail_handle);
+static int32_t efr32xgxx_schedule_rx_dc_window(void);
+static void efr32xgxx_temperature_cb(int32_t temperature, void *context);
+static void efr32xgxx_request_cal(RAIL_CalMask_t cal_mask);
+static RAIL_Status_t efr32xgxx_run_pending_cal(void);
+static RAIL_Status_t efr32xgxx_calibrate_ir(void);
+static void efr32xgxx_ircal_cache_header(efr32xgxx_ircal_cache_t *cache, RAIL_AntennaSel_t rf_path);
+static void efr32xgxx_load_phy_profiles(void);
+static int32_t efr32xgxx_apply_rf_profile(void);
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
 static void efr32xgxx_radio_yield(void);
 #endif
@@ -131,6 +171,30 @@ static bool g_is_first_set_gfsk_mod_params = true;
 static sid_pal_radio_events_t g_last_radio_event = SID_PAL_RADIO_EVENT_UNKNOWN;
 static RAIL_Config_t g_rail_cfg = { .eventsCallback = &radio_irq };
 
+// RX duty cycle, all times are in RAIL time base (us)
+static bool g_rx_dc_active = false;
+static uint32_t g_rx_dc_rx_time_us = 0;
+static uint32_t g_rx_dc_period_us = 0;
+static RAIL_Time_t g_rx_dc_window_start = 0;
+
+// PHY profiles available in efr32xgxx_channelConfigs, loaded once at radio init
+typedef struct {
+  const RAIL_ChannelConfig_t *config;
+  uint32_t base_frequency;
+  uint32_t channel_spacing;
+} efr32xgxx_phy_profile_t;
+
+static efr32xgxx_phy_profile_t g_phy_profiles[EFR32XGXX_RAIL_PROFILE_COUNT];
+static uint8_t g_phy_profile_count = 0;
+// Profile currently configured in RAIL
+static int8_t g_active_rf_profile = EFR32XGXX_RAIL_INVALID_IDX;
+static efr32xgxx_phy_switch_stats_t g_phy_switch_stats = { 0 };
+
+// Calibrations requested by RAIL or by the temperature service, they are run
+// by efr32xgxx_run_pending_cal() once the radio is idle
+static volatile RAIL_CalMask_t g_cal_pending = RAIL_CAL_NONE;
+static efr32xgxx_cal_stats_t g_cal_stats = { 0 };
+
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
 static uint16_t g_prev_channel = 0;
 // For multiprotocol versions of RAIL, this can be used to control how a receive or transmit operation is run.
@@ -206,6 +270,17 @@ void efr32xgxx_event_handler(void)
 void efr32xgxx_radio_irq_process(void)
 {
   efr32xgxx_event_handler();
+
+  // Calibrations requested from the radio irq are run here, out of the radio
+  // event handler, if the stack left the radio idle (e.g. after a TX done)
+  (void)efr32xgxx_run_pending_cal();
+}
+
+void efr32xgxx_get_cal_stats(efr32xgxx_cal_stats_t *stats)
+{
+  if (stats != NULL) {
+    *stats = g_cal_stats;
+  }
 }
 
 uint16_t reverse16(uint16_t n)
@@ -383,37 +458,22 @@ int32_t efr32xgxx_set_radio_init_hard(void)
     goto ret;
   }
 
-  // Return the current set of pending calibrations
+  // Return the current set of pending calibrations, the radio is idle during
+  // init so they are run right away (IRCAL is restored from NVM3 if possible)
   pending_calib = RAIL_GetPendingCal(g_rail_handle);
+  efr32xgxx_request_cal(pending_calib);
 
-  // VCO Temperature Calibration
-  if (pending_calib & RAIL_CAL_TEMP_VCO) {
-    status = RAIL_CalibrateTemp(g_rail_handle);
-    if (status != RAIL_STATUS_NO_ERROR) {
-      SID_PAL_LOG_ERROR("pal: radio temp calib err: %d", status);
-      err = RADIO_ERROR_HARDWARE_ERROR;
-      goto ret;
-    }
+  status = efr32xgxx_run_pending_cal();
+  if (status != RAIL_STATUS_NO_ERROR) {
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
   }
 
-  // Image Rejection Calibration (IRCAL)
-  if (pending_calib & RAIL_CAL_ONETIME_IRCAL) {
-    RAIL_AntennaSel_t rfPath = RAIL_ANTENNA_AUTO;
-    RAIL_Status_t retVal = RAIL_GetRfPath(g_rail_handle, &rfPath);
-    if (retVal == RAIL_STATUS_NO_ERROR) {
-      status = RAIL_CalibrateIrAlt(g_rail_handle, NULL, rfPath);
-      if (status != RAIL_STATUS_NO_ERROR) {
-        SID_PAL_LOG_ERROR("pal: radio ir calib err: %d", status);
-        err = RADIO_ERROR_HARDWARE_ERROR;
-        goto ret;
-      }
-    } else {
-      SID_PAL_LOG_ERROR("pal: radio RF path err: %d", retVal);
-      err = RADIO_ERROR_HARDWARE_ERROR;
-      goto ret;
-    }
+  // Track temperature changes to recalibrate the VCO while the radio is idle
+  (void)sid_pal_temperature_init();
+  if (sli_sid_temperature_register_cb(EFR32XGXX_TEMP_CAL_DELTA, efr32xgxx_temperature_cb, NULL) != SID_ERROR_NONE) {
+    SID_PAL_LOG_WARNING("pal: radio temp cb register failed");
   }
-
   // Radio is initialized
   g_radio_init_once = true;
 
@@ -435,13 +495,18 @@ int32_t efr32xgxx_set_radio_init(void)
     goto ret;
   }
 
-  RAIL_ConfigChannels(g_rail_handle, efr32xgxx_channelConfigs[g_rf_profile], &radio_cfg_changed_hander);
+  efr32xgxx_load_phy_profiles();
+  err = efr32xgxx_apply_rf_profile();
+  if (err != RADIO_ERROR_NONE) {
+    goto ret;
+  }
 
   RAIL_Events_t events = RAIL_EVENT_CAL_NEEDED
                          | RAIL_EVENT_RX_PACKET_RECEIVED
                          | RAIL_EVENT_RX_FRAME_ERROR
                          | RAIL_EVENT_RX_FIFO_OVERFLOW
                          | RAIL_EVENT_RX_PACKET_ABORTED
+                         | RAIL_EVENT_RX_SCHEDULED_RX_END
                          | RAIL_EVENT_TX_PACKET_SENT
                          | RAIL_EVENT_TX_ABORTED
                          | RAIL_EVENT_TX_BLOCKED
@@ -540,6 +605,7 @@ int32_t efr32xgxx_set_sleep(void)
 #else
   efr32xgxx_set_radio_idle();
 #endif
+  (void)efr32xgxx_run_pending_cal();
   return RADIO_ERROR_NONE;
 }
 
@@ -550,6 +616,7 @@ int32_t efr32xgxx_set_standby(void)
 #else
   efr32xgxx_set_radio_idle();
 #endif
+  (void)efr32xgxx_run_pending_cal();
   return RADIO_ERROR_NONE;
 }
 
@@ -583,7 +650,11 @@ int32_t efr32xgxx_set_tx(const uint32_t timeout)
   int32_t err = RADIO_ERROR_NONE;
 
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
-  efr32xgxx_cancel_radio_timer();
+  if (g_rx_dc_active) {
+    efr32xgxx_set_radio_idle();
+  } else {
+    efr32xgxx_cancel_radio_timer();
+  }
 #else
   efr32xgxx_set_radio_idle();
 #endif
@@ -632,7 +703,8 @@ int32_t efr32xgxx_set_rx(const uint32_t timeout)
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
   // Check if channel has changed
   // If we call RAIL_StartRx while not idle but with a different channel, any ongoing receive or transmit operation will be aborted
-  if (g_prev_channel != g_channel) {
+  // A pending scheduled rx window of the duty cycle has to be dropped as well
+  if ((g_prev_channel != g_channel) || g_rx_dc_active) {
     efr32xgxx_set_radio_idle();
   } else {
     efr32xgxx_cancel_radio_timer();
@@ -680,6 +752,49 @@ int32_t efr32xgxx_set_rx(const uint32_t timeout)
   return err;
 }
 
+/**************************************************************************//**
+ * Hardware timed rx duty cycle.
+ *
+ * Every period of (rx_time + sleep_time) ms a RAIL scheduled rx window of
+ * rx_time ms is opened, the windows are chained from the rx scheduled end
+ * event. Between two windows the radio is idle and the RAIL power manager
+ * lets the core enter EM2, the next window is woken up by the RAIL timer
+ * which is kept in sync with the sleeptimer across EM2. The window is not
+ * closed in the middle of a packet, a received packet ends the duty cycle
+ * as on the SX126x.
+ *****************************************************************************/
+int32_t efr32xgxx_set_rx_duty_cycle(const uint32_t rx_time, const uint32_t sleep_time)
+{
+  int32_t err = RADIO_ERROR_NONE;
+
+  // The period has to fit the signed distance used on the RAIL time base
+  if ((rx_time == 0) || (sleep_time == 0)
+      || ((uint64_t)rx_time + sleep_time > (INT32_MAX / EFR32XGXX_TIMER_MS2USEC(1)))) {
+    err = RADIO_ERROR_INVALID_PARAMS;
+    goto ret;
+  }
+
+  g_preamble_detected = 0;
+
+  // Drops any ongoing operation, a previous duty cycle included
+  efr32xgxx_set_radio_idle();
+
+  g_rx_dc_rx_time_us = EFR32XGXX_TIMER_MS2USEC(rx_time);
+  g_rx_dc_period_us = EFR32XGXX_TIMER_MS2USEC(rx_time + sleep_time);
+  // The first window is opened right away, like a plain rx
+  g_rx_dc_window_start = RAIL_GetTime() + EFR32XGXX_RX_DC_MIN_LEAD_US;
+
+  err = efr32xgxx_schedule_rx_dc_window();
+  if (err != RADIO_ERROR_NONE) {
+    goto ret;
+  }
+
+  g_rx_dc_active = true;
+
+  ret:
+  return err;
+}
+
 // This function is not supported.
 int32_t efr32xgxx_set_tx_cw(void)
 {
@@ -694,12 +809,24 @@ int32_t efr32xgxx_set_tx_cpbl(void)
 
 int32_t efr32xgxx_set_rf_freq(const uint32_t freq_in_hz)
 {
+  if ((g_rf_profile < 0) || (g_rf_profile >= g_phy_profile_count)) {
+    return RADIO_ERROR_INVALID_PARAMS;
+  }
+
   // Compute channel from frequency
-  g_channel = (freq_in_hz - efr32xgxx_channelConfigs[g_rf_profile]->configs->baseFrequency) / efr32xgxx_channelConfigs[g_rf_profile]->configs->channelSpacing;
+  const efr32xgxx_phy_profile_t *profile = &g_phy_profiles[g_rf_profile];
+  g_channel = (freq_in_hz - profile->base_frequency) / profile->channel_spacing;
 
   return RADIO_ERROR_NONE;
 }
 
+void efr32xgxx_get_phy_switch_stats(efr32xgxx_phy_switch_stats_t *stats)
+{
+  if (stats != NULL) {
+    *stats = g_phy_switch_stats;
+  }
+}
+
 int32_t efr32xgxx_set_gfsk_mod_params(const efr32xgxx_mod_params_gfsk_t *params)
 {
   int32_t err = RADIO_ERROR_NONE;
@@ -724,12 +851,18 @@ int32_t efr32xgxx_set_gfsk_mod_params(const efr32xgxx_mod_params_gfsk_t *params)
     }
   }
 
-  if (efr32xgxx_set_standby() != RADIO_ERROR_NONE) {
-    err = RADIO_ERROR_HARDWARE_ERROR;
-    goto ret;
+  // Only the channel config differs between the data rates, the rest of the
+  // radio init does not need to run again
+  if (g_rf_profile != g_active_rf_profile) {
+    if (efr32xgxx_set_standby() != RADIO_ERROR_NONE) {
+      err = RADIO_ERROR_HARDWARE_ERROR;
+      goto ret;
+    }
   }
 
-  if (efr32xgxx_set_radio_init() != RADIO_ERROR_NONE) {
+  if (efr32xgxx_apply_rf_profile() != RADIO_ERROR_NONE) {
+    // Stay on the profile RAIL is still configured with
+    g_rf_profile = g_active_rf_profile;
     err = RADIO_ERROR_HARDWARE_ERROR;
     goto ret;
   }
@@ -869,13 +1002,236 @@ static void radio_cfg_changed_hander(RAIL_Handle_t rail_handle, const RAIL_Chann
 
 static void efr32xgxx_set_radio_idle(void)
 {
+  g_rx_dc_active = false;
   efr32xgxx_cancel_radio_timer();
   RAIL_Idle(g_rail_handle, RAIL_IDLE, true);
 }
 
+static void efr32xgxx_temperature_cb(int32_t temperature, void *context)
+{
+  (void)temperature;
+  (void)context;
+
+  efr32xgxx_request_cal(RAIL_CAL_TEMP_VCO);
+}
+
+static void efr32xgxx_request_cal(RAIL_CalMask_t cal_mask)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  g_cal_pending |= cal_mask;
+  CORE_EXIT_ATOMIC();
+}
+
+/**************************************************************************//**
+ * Run the pending calibrations if the radio is neither receiving nor
+ * transmitting, they stay pending otherwise. Must not be called from the
+ * radio event handler.
+ *****************************************************************************/
+static RAIL_Status_t efr32xgxx_run_pending_cal(void)
+{
+  RAIL_Status_t status = RAIL_STATUS_NO_ERROR;
+  RAIL_CalMask_t cal_mask;
+  RAIL_CalMask_t failed_mask = RAIL_CAL_NONE;
+  CORE_DECLARE_IRQ_STATE;
+
+  if (g_cal_pending == RAIL_CAL_NONE) {
+    return RAIL_STATUS_NO_ERROR;
+  }
+
+  if (RAIL_GetRadioState(g_rail_handle) & (RAIL_RF_STATE_RX | RAIL_RF_STATE_TX)) {
+    return RAIL_STATUS_NO_ERROR;
+  }
+
+  CORE_ENTER_ATOMIC();
+  cal_mask = g_cal_pending;
+  g_cal_pending = RAIL_CAL_NONE;
+  CORE_EXIT_ATOMIC();
+
+  RAIL_Time_t start = RAIL_GetTime();
+
+  if (cal_mask & RAIL_CAL_ONETIME_IRCAL) {
+    cal_mask &= ~RAIL_CAL_ONETIME_IRCAL;
+    status = efr32xgxx_calibrate_ir();
+    if (status != RAIL_STATUS_NO_ERROR) {
+      failed_mask |= RAIL_CAL_ONETIME_IRCAL;
+    }
+  }
+
+  if (cal_mask != RAIL_CAL_NONE) {
+    RAIL_Status_t cal_status = RAIL_Calibrate(g_rail_handle, NULL, cal_mask);
+    if (cal_status != RAIL_STATUS_NO_ERROR) {
+      SID_PAL_LOG_ERROR("pal: radio calib err: %d", cal_status);
+      failed_mask |= cal_mask;
+      status = cal_status;
+    }
+  }
+
+  // Failed calibrations are tried again on the next idle gap
+  if (failed_mask != RAIL_CAL_NONE) {
+    efr32xgxx_request_cal(failed_mask);
+  }
+
+  uint32_t elapsed_us = RAIL_GetTime() - start;
+
+  g_cal_stats.count++;
+  g_cal_stats.last_us = elapsed_us;
+  g_cal_stats.total_us += elapsed_us;
+  if (elapsed_us > g_cal_stats.max_us) {
+    g_cal_stats.max_us = elapsed_us;
+  }
+  if (status != RAIL_STATUS_NO_ERROR) {
+    g_cal_stats.errors++;
+  }
+
+  return status;
+}
+
+/**************************************************************************//**
+ * Image rejection calibration. The result depends on the chip, the RF path
+ * and the radio configuration, so it is computed once and then restored from
+ * NVM3 as long as the firmware still uses the same RAIL and PHY configs.
+ *****************************************************************************/
+static RAIL_Status_t efr32xgxx_calibrate_ir(void)
+{
+  efr32xgxx_ircal_cache_t cache;
+  efr32xgxx_ircal_cache_t expected;
+  RAIL_AntennaSel_t rf_path = RAIL_ANTENNA_AUTO;
+  RAIL_Status_t status;
+  Ecode_t ecode;
+
+  status = RAIL_GetRfPath(g_rail_handle, &rf_path);
+  if (status != RAIL_STATUS_NO_ERROR) {
+    SID_PAL_LOG_ERROR("pal: radio RF path err: %d", status);
+    goto ret;
+  }
+
+  efr32xgxx_ircal_cache_header(&expected, rf_path);
+
+  memset(&cache, 0, sizeof(cache));
+  ecode = nvm3_readData(nvm3_defaultHandle, EFR32XGXX_IRCAL_NVM3_KEY, &cache, sizeof(cache));
+  if ((ecode == ECODE_NVM3_OK)
+      && (cache.version == expected.version)
+      && (cache.rail_version == expected.rail_version)
+      && (cache.phy_tag == expected.phy_tag)
+      && (cache.rf_path == expected.rf_path)) {
+    status = RAIL_ApplyIrCalibrationAlt(g_rail_handle, &cache.values, rf_path);
+    if (status == RAIL_STATUS_NO_ERROR) {
+      g_cal_stats.ircal_restored++;
+      goto ret;
+    }
+    SID_PAL_LOG_WARNING("pal: radio stored ir calib rejected: %d", status);
+  }
+
+  cache = expected;
+  status = RAIL_CalibrateIrAlt(g_rail_handle, &cache.values, rf_path);
+  if (status != RAIL_STATUS_NO_ERROR) {
+    SID_PAL_LOG_ERROR("pal: radio ir calib err: %d", status);
+    goto ret;
+  }
+
+  ecode = sli_sid_nvm3_write(EFR32XGXX_IRCAL_NVM3_KEY, &cache, sizeof(cache));
+  if (ecode != ECODE_NVM3_OK) {
+    // Not fatal, the calibration is run again on the next boot
+    SID_PAL_LOG_WARNING("pal: radio ir calib store err: %d", ecode);
+  }
+
+  ret:
+  return status;
+}
+
+/**************************************************************************//**
+ * Fill in what a stored IR calibration must match to be reused: the cache
+ * layout, the RAIL library version, the PHY configs and the RF path.
+ *****************************************************************************/
+static void efr32xgxx_ircal_cache_header(efr32xgxx_ircal_cache_t *cache, RAIL_AntennaSel_t rf_path)
+{
+  RAIL_Version_t rail_version;
+  uint32_t phy[EFR32XGXX_RAIL_PROFILE_COUNT * 4] = { 0 };
+
+  memset(cache, 0, sizeof(*cache));
+
+  RAIL_GetVersion(&rail_version, false);
+  cache->version = EFR32XGXX_IRCAL_CACHE_VERSION;
+  cache->rail_version = ((uint32_t)rail_version.major << 24)
+                        | ((uint32_t)rail_version.minor << 16)
+                        | ((uint32_t)rail_version.rev << 8)
+                        | rail_version.build;
+
+  efr32xgxx_load_phy_profiles();
+  for (uint8_t idx = 0; idx < g_phy_profile_count; idx++) {
+    const RAIL_ChannelConfigEntry_t *entry = &g_phy_profiles[idx].config->configs[0];
+
+    phy[idx * 4] = entry->baseFrequency;
+    phy[idx * 4 + 1] = entry->channelSpacing;
+    phy[idx * 4 + 2] = entry->physicalChannelOffset;
+    phy[idx * 4 + 3] = ((uint32_t)entry->channelNumberStart << 16) | entry->channelNumberEnd;
+  }
+  cache->phy_tag = compute_crc32((const uint8_t *)phy, sizeof(phy));
+  cache->rf_path = rf_path;
+}
+
+/**************************************************************************//**
+ * Cache the PHY profiles of the chip specific efr32xgxx_channelConfigs table.
+ * The table is NULL terminated and may hold fewer entries than data rates.
+ *****************************************************************************/
+static void efr32xgxx_load_phy_profiles(void)
+{
+  if (g_phy_profile_count != 0) {
+    return;
+  }
+
+  for (uint8_t idx = 0; idx < EFR32XGXX_RAIL_PROFILE_COUNT; idx++) {
+    const RAIL_ChannelConfig_t *config = efr32xgxx_channelConfigs[idx];
+
+    if ((config == NULL) || (config->length == 0)) {
+      break;
+    }
+    g_phy_profiles[idx].config = config;
+    g_phy_profiles[idx].base_frequency = config->configs[0].baseFrequency;
+    g_phy_profiles[idx].channel_spacing = config->configs[0].channelSpacing;
+    g_phy_profile_count++;
+  }
+}
+
+/**************************************************************************//**
+ * Configure RAIL for g_rf_profile. Nothing is done when the profile is
+ * already configured, otherwise the time spent in RAIL is recorded.
+ *****************************************************************************/
+static int32_t efr32xgxx_apply_rf_profile(void)
+{
+  if (g_rf_profile == g_active_rf_profile) {
+    g_phy_switch_stats.skipped++;
+    return RADIO_ERROR_NONE;
+  }
+
+  if ((g_rf_profile < 0) || (g_rf_profile >= g_phy_profile_count)) {
+    SID_PAL_LOG_ERROR("pal: radio rf profile not available: %d", g_rf_profile);
+    return RADIO_ERROR_NOT_SUPPORTED;
+  }
+
+  RAIL_Time_t start = RAIL_GetTime();
+  RAIL_ConfigChannels(g_rail_handle, g_phy_profiles[g_rf_profile].config, &radio_cfg_changed_hander);
+  uint32_t elapsed_us = RAIL_GetTime() - start;
+
+  g_active_rf_profile = g_rf_profile;
+
+  g_phy_switch_stats.switches++;
+  g_phy_switch_stats.last_us = elapsed_us;
+  if (elapsed_us > g_phy_switch_stats.max_us) {
+    g_phy_switch_stats.max_us = elapsed_us;
+  }
+
+  return RADIO_ERROR_NONE;
+}
+
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
 static void efr32xgxx_radio_yield(void)
 {
+  if (g_rx_dc_active) {
+    // Yielding does not cancel a scheduled rx window
+    efr32xgxx_set_radio_idle();
+  }
   efr32xgxx_cancel_radio_timer();
   RAIL_YieldRadio(g_rail_handle);
 }
@@ -910,8 +1266,6 @@ static void efr32xgxx_event_notify(sid_pal_radio_events_t radio_event)
 // to mimic semtech behaviour
 static void radio_irq(RAIL_Handle_t rail_handle, RAIL_Events_t events)
 {
-  RAIL_Status_t status;
-
   //----------------- RX --------------------------
   // Handle RX Events
   if (events & RAIL_EVENT_RX_PACKET_RECEIVED) {
@@ -968,6 +1322,15 @@ static void radio_irq(RAIL_Handle_t rail_handle, RAIL_Events_t events)
     }
   }
 
+  // Window of the rx duty cycle closed without a packet, arm the next one
+  if ((events & RAIL_EVENT_RX_SCHEDULED_RX_END) && g_rx_dc_active) {
+    g_preamble_detected = 0;
+    if (efr32xgxx_schedule_rx_dc_window() != RADIO_ERROR_NONE) {
+      efr32xgxx_set_radio_idle();
+      efr32xgxx_event_notify(SID_PAL_RADIO_EVENT_RX_ERROR);
+    }
+  }
+
   //----------------- TX --------------------------
   // Handle TX Events
   if (events & (RAIL_EVENT_TX_ABORTED | RAIL_EVENT_TX_BLOCKED | RAIL_EVENT_TX_UNDERFLOW)) {
@@ -987,13 +1350,57 @@ static void radio_irq(RAIL_Handle_t rail_handle, RAIL_Events_t events)
 #endif
   }
 
-  // Perform all calibrations when needed
+  // Calibrating here would hold back the radio event processing, the pending
+  // calibrations are only recorded and run once the radio is idle
   if (events & RAIL_EVENT_CAL_NEEDED) {
-    status = RAIL_Calibrate(rail_handle, NULL, RAIL_CAL_ALL_PENDING);
-    if (status != RAIL_STATUS_NO_ERROR) {
-      SID_PAL_LOG_ERROR("pal: radio calib err: %d", status);
-    }
+    efr32xgxx_request_cal(RAIL_GetPendingCal(rail_handle));
+  }
+}
+
+/**************************************************************************//**
+ * Schedule the rx duty cycle window starting at g_rx_dc_window_start and
+ * advance g_rx_dc_window_start to the next period. Windows which could not be
+ * started in time anymore are skipped to keep the period free of drift.
+ *****************************************************************************/
+static int32_t efr32xgxx_schedule_rx_dc_window(void)
+{
+  int32_t err = RADIO_ERROR_NONE;
+  RAIL_Status_t status;
+  RAIL_Time_t now = RAIL_GetTime();
+
+  while ((int32_t)(g_rx_dc_window_start - now) < (int32_t)EFR32XGXX_RX_DC_MIN_LEAD_US) {
+    g_rx_dc_window_start += g_rx_dc_period_us;
+  }
+
+  RAIL_ScheduleRxConfig_t rx_cfg = {
+    .start = g_rx_dc_window_start,
+    .startMode = RAIL_TIME_ABSOLUTE,
+    .end = g_rx_dc_rx_time_us,
+    .endMode = RAIL_TIME_DELAY,
+    .rxTransitionEndSchedule = 0, // Radio goes idle at the end of the window
+    .hardWindowEnd = 0            // A packet being received extends the window
+  };
+
+#if defined(SL_SIDEWALK_DMP_SUPPORTED)
+  g_schedulerInfo = (RAIL_SchedulerInfo_t) { .priority = EFR32XGXX_RX_PRIORITY };
+  status = RAIL_ScheduleRx(g_rail_handle, g_channel, &rx_cfg, &g_schedulerInfo);
+#else
+  status = RAIL_ScheduleRx(g_rail_handle, g_channel, &rx_cfg, NULL);
+#endif
+  if (status != RAIL_STATUS_NO_ERROR) {
+    SID_PAL_LOG_ERROR("pal: radio schedule rx dc err: %d", status);
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
   }
+
+#if defined(SL_SIDEWALK_DMP_SUPPORTED)
+  g_prev_channel = g_channel;
+#endif
+
+  g_rx_dc_window_start += g_rx_dc_period_us;
+
+  ret:
+  return err;
 }
 
 static void efr32xgxx_tx_timer_expired(RAIL_Handle_t rail_handle)
@@ -39,30 +39,180 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 #include <sid_pal_assert_ifc.h>
+#include <sid_time_ops.h>
 
+#include "em_core.h"
+#include "em_device.h"
+#include "sl_sleeptimer.h"
+#include "sl_component_catalog.h"
 #include "gpiointerrupt.h"
 #include <gpio.h>
 
+#if SL_SID_GPIO_IRQ_DEFERRED_ENABLE && defined(SL_CATALOG_KERNEL_PRESENT)
+#include <FreeRTOS.h>
+#include <task.h>
+#endif
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+// Number of external interrupt lines; the interrupt number of a pin is its pin
+// number within the port
+#define GPIO_EXTINT_COUNT                   16
+
+#if SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+#ifndef SL_SID_GPIO_IRQ_TASK_STACK_SIZE
+#define SL_SID_GPIO_IRQ_TASK_STACK_SIZE     (1024 / sizeof(configSTACK_DEPTH_TYPE))
+#endif
+#ifndef SL_SID_GPIO_IRQ_TASK_PRIORITY
+#define SL_SID_GPIO_IRQ_TASK_PRIORITY       (configMAX_PRIORITIES - 1)
+#endif
+#else
+#ifndef SL_SID_GPIO_IRQ_SWI_PRIORITY
+#define SL_SID_GPIO_IRQ_SWI_PRIORITY        5
+#endif
+#endif // SL_CATALOG_KERNEL_PRESENT
+#endif // SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+static void gpio_irq_handler(uint8_t int_no);
+static void gpio_irq_dispatch(uint8_t gpio_number);
+#if SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+static sid_error_t gpio_deferred_init(void);
+static void gpio_deferred_run(void);
+#endif
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
 // gpio application specific config
 extern struct GPIO_LookupItem gpio_lookup_table[];
 
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+// interrupt number -> gpio_lookup_table index + 1 (0 when unused), filled by
+// sid_pal_gpio_set_irq
+static uint8_t gpio_extint_map[GPIO_EXTINT_COUNT];
+// sleeptimer tick of the last edge seen on each pin
+static volatile uint64_t gpio_edge_ticks[SL_PIN_MAX];
+#if SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+static uint32_t gpio_deferred_mask;
+static volatile uint32_t gpio_deferred_pending;
+static bool gpio_deferred_init_done;
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+static TaskHandle_t gpio_irq_task_handle;
+#endif
+#endif // SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
-static void gpio_irq_handler(uint8_t pin)
+static void gpio_irq_dispatch(uint8_t gpio_number)
+{
+  struct GPIO_LookupItem * lookupptr = &gpio_lookup_table[gpio_number];
+
+  if (lookupptr->callback) {
+    lookupptr->callback(gpio_number, lookupptr->callbackarg);
+  }
+}
+
+static void gpio_irq_handler(uint8_t int_no)
 {
-  for (uint8_t ix = 0; ix < SL_PIN_MAX; ix++) {
-    if (pin == gpio_lookup_table[ix].Pin) {
-      if (gpio_lookup_table[ix].callback) {
-        gpio_lookup_table[ix].callback(ix, gpio_lookup_table[ix].callbackarg);
-      }
+  if (int_no >= GPIO_EXTINT_COUNT) {
+    return;
+  }
+
+  if (gpio_extint_map[int_no] == 0) {
+    return;
+  }
+
+  uint8_t gpio_number = gpio_extint_map[int_no] - 1;
+
+  gpio_edge_ticks[gpio_number] = sl_sleeptimer_get_tick_count64();
+
+#if SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+  if (gpio_deferred_mask & (1UL << gpio_number)) {
+    gpio_deferred_pending |= (1UL << gpio_number);
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(gpio_irq_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+#else
+    NVIC_SetPendingIRQ(SW2_IRQn);
+#endif
+    return;
+  }
+#endif // SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+
+  gpio_irq_dispatch(gpio_number);
+}
+
+#if SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+static void gpio_deferred_run(void)
+{
+  uint32_t pending;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  pending = gpio_deferred_pending;
+  gpio_deferred_pending = 0;
+  CORE_EXIT_ATOMIC();
+
+  for (uint8_t ix = 0; pending != 0; ix++, pending >>= 1) {
+    if (pending & 1UL) {
+      gpio_irq_dispatch(ix);
     }
   }
 }
 
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+static void gpio_irq_task(void *context)
+{
+  (void)context;
+
+  while (1) {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    gpio_deferred_run();
+  }
+}
+#else
+void SW2_IRQHandler(void)
+{
+  gpio_deferred_run();
+}
+#endif // SL_CATALOG_KERNEL_PRESENT
+
+static sid_error_t gpio_deferred_init(void)
+{
+  if (gpio_deferred_init_done) {
+    return SID_ERROR_NONE;
+  }
+
+#if defined(SL_CATALOG_KERNEL_PRESENT)
+  BaseType_t status = xTaskCreate(gpio_irq_task,
+                                  "GPIO IRQ",
+                                  SL_SID_GPIO_IRQ_TASK_STACK_SIZE,
+                                  NULL,
+                                  SL_SID_GPIO_IRQ_TASK_PRIORITY,
+                                  &gpio_irq_task_handle);
+  if (status != pdPASS) {
+    return SID_ERROR_OOM;
+  }
+#else
+  NVIC_ClearPendingIRQ(SW2_IRQn);
+  NVIC_SetPriority(SW2_IRQn, SL_SID_GPIO_IRQ_SWI_PRIORITY);
+  NVIC_EnableIRQ(SW2_IRQn);
+#endif // SL_CATALOG_KERNEL_PRESENT
+
+  gpio_deferred_init_done = true;
+  return SID_ERROR_NONE;
+}
+#endif // SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -270,6 +420,10 @@ sid_error_t sid_pal_gpio_set_irq(uint32_t gpio_number,
     lookupptr->irq.rising = IsRisingEdge;
     lookupptr->callback = gpio_callback;
     lookupptr->callbackarg = callback_arg;
+    if (lookupptr->Pin >= GPIO_EXTINT_COUNT) {
+      return SID_ERROR_INVALID_ARGS;
+    }
+    gpio_extint_map[lookupptr->Pin] = (uint8_t)(gpio_number + 1);
     GPIOINT_CallbackRegister(lookupptr->Pin, gpio_irq_handler);
     GPIO_ExtIntConfig(lookupptr->GPIO_Port, lookupptr->Pin, lookupptr->Pin, IsRisingEdge, IsFallingEdge, enableIrq);
   } else {
@@ -316,3 +470,55 @@ sid_error_t sid_pal_gpio_irq_disable(uint32_t gpio_number)
   }
   return retval;
 }
+
+sid_error_t sli_sid_gpio_get_irq_latency(uint32_t gpio_number, struct sid_timespec * latency)
+{
+  if (gpio_number >= SL_PIN_MAX || latency == NULL) {
+    return SID_ERROR_INVALID_ARGS;
+  }
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  uint64_t edge_ticks = gpio_edge_ticks[gpio_number];
+  CORE_EXIT_ATOMIC();
+
+  if (edge_ticks == 0) {
+    return SID_ERROR_NOT_FOUND;
+  }
+
+  uint64_t ticks = sl_sleeptimer_get_tick_count64() - edge_ticks;
+  uint32_t ticks_per_sec = sl_sleeptimer_get_timer_frequency();
+
+  latency->tv_sec = (uint32_t)(ticks / ticks_per_sec);
+  latency->tv_nsec = (uint32_t)(((ticks % ticks_per_sec) * SID_TIME_NSEC_PER_SEC) / ticks_per_sec);
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_gpio_set_irq_deferred(uint32_t gpio_number, bool deferred)
+{
+  if (gpio_number >= SL_PIN_MAX) {
+    return SID_ERROR_INVALID_ARGS;
+  }
+
+#if SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+  if (deferred) {
+    sid_error_t err = gpio_deferred_init();
+    if (err != SID_ERROR_NONE) {
+      return err;
+    }
+  }
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if (deferred) {
+    gpio_deferred_mask |= (1UL << gpio_number);
+  } else {
+    gpio_deferred_mask &= ~(1UL << gpio_number);
+    gpio_deferred_pending &= ~(1UL << gpio_number);
+  }
+  CORE_EXIT_ATOMIC();
+  return SID_ERROR_NONE;
+#else
+  return deferred ? SID_ERROR_NOSUPPORT : SID_ERROR_NONE;
+#endif // SL_SID_GPIO_IRQ_DEFERRED_ENABLE
+}
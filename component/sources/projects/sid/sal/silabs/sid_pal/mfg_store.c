@@ -45,6 +45,7 @@
 #include <stdint.h>
 #include <string.h>
 #include "nvm3_manager.h"
+#include "mfg_store.h"
 #include "em_system.h" // for SYSTEM_GetUnique
 #include "sl_malloc.h"
 
@@ -63,6 +64,8 @@
 #define MFG_VERSION_1_VAL                   0x01000000
 #define MFG_VERSION_2_VAL                   0x2
 
+#define MFG_WORD_SIZE                       4u  // in bytes
+
 #define ENCODED_DEV_ID_SIZE_5_BYTES_MASK    0xA0
 #define DEV_ID_MSB_MASK                     0x1F
 
@@ -86,10 +89,30 @@ enum mfg_store_error_status {
   MFG_STORE_ERROR_ST_ERASE_NOT_ACTIVATED = -8,
 };
 
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+// Cached values are the sidewalk core values up to the APID, indexed by value
+#define MFG_CACHE_VALUE_MAX                 SID_PAL_MFG_STORE_APID
+// Entry offset of a value that is not cached and has to be read from NVM3
+#define MFG_CACHE_OFFSET_NONE               UINT16_MAX
+#define MFG_CACHE_ALIGN(len)                (((len) + (MFG_WORD_SIZE - 1)) & ~(MFG_WORD_SIZE - 1))
+
+// A cached value with a length of 0 is not provisioned
+typedef struct {
+  uint16_t offset;
+  uint16_t length;
+} mfg_cache_entry_t;
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+static void mfg_cache_fill(void);
+static const mfg_cache_entry_t *mfg_cache_lookup(uint16_t value);
+static void mfg_cache_update(uint16_t value, const uint8_t *buffer, uint16_t length);
+#endif
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -97,7 +120,17 @@ enum mfg_store_error_status {
 // -----------------------------------------------------------------------------
 //                                Static Variables
 // -----------------------------------------------------------------------------
-static const uint32_t MFG_WORD_SIZE = 4;  // in bytes
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+static struct {
+  bool is_valid;
+  uint16_t cached_values;
+  uint16_t pool_used;
+  uint32_t hits;
+  uint32_t misses;
+  mfg_cache_entry_t entries[MFG_CACHE_VALUE_MAX + 1];
+  alignas(MFG_WORD_SIZE) uint8_t pool[SL_SID_MFG_STORE_CACHE_POOL_SIZE];
+} mfg_cache;
+#endif
 
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
@@ -114,14 +147,23 @@ void sid_pal_mfg_store_init(sid_pal_mfg_store_region_t mfg_store_region)
       return;
     }
   }
+  sli_sid_nvm3_init();
 
   uint16_t obj_cnt = (uint16_t)nvm3_enumObjects(nvm3_defaultHandle, NULL, 0, SLI_SID_NVM3_KEY_MIN_MFG, SLI_SID_NVM3_KEY_MAX_MFG);
   SID_PAL_LOG_INFO("pal: mfg store opened with %d object(s)", obj_cnt);
+
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  mfg_cache_fill();
+  SID_PAL_LOG_INFO("pal: mfg store cached %d value(s), %d bytes", mfg_cache.cached_values, mfg_cache.pool_used);
+#endif
 }
 
 void sid_pal_mfg_store_deinit(void)
 {
   // do not deinit default nvm3 instance as it is also used by gsdk
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  mfg_cache.is_valid = false;
+#endif
 }
 
 int32_t sid_pal_mfg_store_write(uint16_t value, const uint8_t *buffer, uint16_t length)
@@ -137,19 +179,16 @@ int32_t sid_pal_mfg_store_write(uint16_t value, const uint8_t *buffer, uint16_t
     return MFG_STORE_ERROR_ST_WRONG_INPUT_ARGS;
   }
 
-  Ecode_t status = nvm3_writeData(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(MFG, value), buffer, (size_t)length);
+  // Repack is scheduled by the nvm3 manager
+  Ecode_t status = sli_sid_nvm3_write(SLI_SID_NVM3_MAP_KEY(MFG, value), buffer, (size_t)length);
   if (status != ECODE_NVM3_OK) {
     SID_PAL_LOG_ERROR("pal: mfg write, write err: %d", status);
     return MFG_STORE_ERROR_ST_WRITE_ERROR;
   }
 
-  if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-    status = nvm3_repack(nvm3_defaultHandle);
-    if (status != ECODE_NVM3_OK) {
-      SID_PAL_LOG_ERROR("pal: mfg write, repack err: %d", status);
-      return MFG_STORE_ERROR_ST_REPACK_ERROR;
-    }
-  }
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  mfg_cache_update(value, buffer, length);
+#endif
 
   return MFG_STORE_ERROR_ST_SUCCESS;
 #else
@@ -179,6 +218,19 @@ void sid_pal_mfg_store_read(uint16_t value, uint8_t *buffer, uint16_t length)
     return;
   }
 
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  const mfg_cache_entry_t *entry = mfg_cache_lookup(value);
+  if (entry) {
+    mfg_cache.hits++;
+    // Like nvm3_readData nothing is copied when more than the stored length is requested
+    if (length <= entry->length) {
+      memcpy(buffer, &mfg_cache.pool[entry->offset], length);
+    }
+    return;
+  }
+  mfg_cache.misses++;
+#endif
+
   nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &object_length);
 
   if (object_type == NVM3_OBJECTTYPE_DATA) {
@@ -196,6 +248,15 @@ uint16_t sid_pal_mfg_store_get_length_for_value(uint16_t value)
     return object_length;
   }
 
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  const mfg_cache_entry_t *entry = mfg_cache_lookup(value);
+  if (entry) {
+    mfg_cache.hits++;
+    return entry->length;
+  }
+  mfg_cache.misses++;
+#endif
+
   nvm3_getObjectInfo(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(MFG, value), &object_type, &object_length);
 
   return (object_type == NVM3_OBJECTTYPE_DATA) ? object_length : 0;
@@ -208,6 +269,10 @@ int32_t sid_pal_mfg_store_erase(void)
   nvm3_ObjectKey_t *key_list = NULL;
   Ecode_t status = ECODE_NVM3_OK;
 
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  mfg_cache.is_valid = false;
+#endif
+
   obj_cnt = nvm3_enumObjects(nvm3_defaultHandle, NULL, 0, SLI_SID_NVM3_KEY_MIN_MFG, SLI_SID_NVM3_KEY_MAX_MFG);
   if (obj_cnt == 0) {
     SID_PAL_LOG_INFO("pal: mfg erase, nothing to erase");
@@ -331,3 +396,138 @@ bool sid_pal_mfg_store_serial_num_get(uint8_t serial_num[SID_PAL_MFG_STORE_SERIA
 
   return true;
 }
+
+void sid_pal_mfg_store_apid_get(uint8_t apid[SID_PAL_MFG_STORE_APID_SIZE])
+{
+  sid_pal_mfg_store_read(SID_PAL_MFG_STORE_APID, apid, SID_PAL_MFG_STORE_APID_SIZE);
+}
+
+void sid_pal_mfg_store_app_pub_key_get(uint8_t app_pub[SID_PAL_MFG_STORE_APP_PUB_ED25519_SIZE])
+{
+  sid_pal_mfg_store_read(SID_PAL_MFG_STORE_APP_PUB_ED25519, app_pub, SID_PAL_MFG_STORE_APP_PUB_ED25519_SIZE);
+}
+
+const uint8_t *sli_sid_mfg_store_get_ptr(uint16_t value, uint16_t *length)
+{
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  const mfg_cache_entry_t *entry = mfg_cache_lookup(value);
+  if (entry && entry->length) {
+    mfg_cache.hits++;
+    if (length) {
+      *length = entry->length;
+    }
+    return &mfg_cache.pool[entry->offset];
+  }
+#else
+  (void)value;
+#endif
+
+  if (length) {
+    *length = 0;
+  }
+  return NULL;
+}
+
+void sli_sid_mfg_store_get_cache_stats(sli_sid_mfg_store_cache_stats_t *stats)
+{
+  if (!stats) {
+    return;
+  }
+
+  memset(stats, 0, sizeof(*stats));
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+  stats->hits = mfg_cache.hits;
+  stats->misses = mfg_cache.misses;
+  stats->cached_values = mfg_cache.cached_values;
+  stats->cached_bytes = mfg_cache.pool_used;
+  stats->is_valid = mfg_cache.is_valid;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+#if SL_SID_MFG_STORE_CACHE_ENABLE
+/*******************************************************************************
+ * Reads the immutable mfg values into the cache pool. Private keys stay in
+ * NVM3 only, values that do not fit in the pool are read from NVM3 as well.
+ ******************************************************************************/
+static void mfg_cache_fill(void)
+{
+  uint32_t object_type;
+  size_t object_length;
+
+  mfg_cache.is_valid = false;
+  mfg_cache.cached_values = 0;
+  mfg_cache.pool_used = 0;
+
+  for (uint16_t value = 0; value <= MFG_CACHE_VALUE_MAX; value++) {
+    mfg_cache_entry_t *entry = &mfg_cache.entries[value];
+    entry->offset = MFG_CACHE_OFFSET_NONE;
+    entry->length = 0;
+
+    if (value == 0
+        || value == SID_PAL_MFG_STORE_DEVICE_PRIV_ED25519
+        || value == SID_PAL_MFG_STORE_DEVICE_PRIV_P256R1) {
+      continue;
+    }
+
+    uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(MFG, value);
+    if (nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &object_length) != ECODE_NVM3_OK
+        || object_type != NVM3_OBJECTTYPE_DATA
+        || object_length == 0) {
+      // Not provisioned, remembered so that later reads do not search NVM3
+      entry->offset = 0;
+      continue;
+    }
+
+    if (object_length > (size_t)(SL_SID_MFG_STORE_CACHE_POOL_SIZE - mfg_cache.pool_used)) {
+      continue;
+    }
+
+    if (nvm3_readData(nvm3_defaultHandle, mapped_key, &mfg_cache.pool[mfg_cache.pool_used], object_length) != ECODE_NVM3_OK) {
+      continue;
+    }
+
+    entry->offset = mfg_cache.pool_used;
+    entry->length = (uint16_t)object_length;
+    mfg_cache.pool_used = (uint16_t)MFG_CACHE_ALIGN(mfg_cache.pool_used + object_length);
+    if (mfg_cache.pool_used > SL_SID_MFG_STORE_CACHE_POOL_SIZE) {
+      mfg_cache.pool_used = SL_SID_MFG_STORE_CACHE_POOL_SIZE;
+    }
+    mfg_cache.cached_values++;
+  }
+
+  mfg_cache.is_valid = true;
+}
+
+static const mfg_cache_entry_t *mfg_cache_lookup(uint16_t value)
+{
+  if (!mfg_cache.is_valid
+      || value > MFG_CACHE_VALUE_MAX
+      || mfg_cache.entries[value].offset == MFG_CACHE_OFFSET_NONE) {
+    return NULL;
+  }
+  return &mfg_cache.entries[value];
+}
+
+/*******************************************************************************
+ * Keeps the cache coherent with a write. A rewrite with the same length is
+ * patched in place, any other change of a cached value disables the cache
+ * until the next sid_pal_mfg_store_init.
+ ******************************************************************************/
+static void mfg_cache_update(uint16_t value, const uint8_t *buffer, uint16_t length)
+{
+  const mfg_cache_entry_t *entry = mfg_cache_lookup(value);
+  if (!entry) {
+    return;
+  }
+
+  if (entry->length == length) {
+    memcpy(&mfg_cache.pool[entry->offset], buffer, length);
+  } else {
+    mfg_cache.is_valid = false;
+  }
+}
+#endif
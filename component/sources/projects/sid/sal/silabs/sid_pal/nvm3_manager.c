@@ -39,16 +39,41 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 
+#include <string.h>
 #include "nvm3_manager.h"
+#include "em_core.h"
+#include "em_device.h"
+#include "sl_sleeptimer.h"
+#include "sl_component_catalog.h"
+#include <sid_pal_log_ifc.h>
+#if SL_SID_NVM3_BACKGROUND_REPACK_ENABLE && defined(SL_CATALOG_KERNEL_PRESENT)
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#define NVM3_REPACK_TASK
+#endif
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+// Worst case header and alignment overhead of an nvm3 data object
+#define NVM3_OBJ_HDR_SIZE                 8u
+#define NVM3_OBJ_SIZE(len)                (NVM3_OBJ_HDR_SIZE + (((len) + 3u) & ~3u))
+
+#if defined(NVM3_REPACK_TASK)
+#define NVM3_REPACK_TASK_STACK_DEPTH      (SL_SID_NVM3_REPACK_TASK_STACK_SIZE / sizeof(configSTACK_DEPTH_TYPE))
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+static sli_sid_nvm3_range_t nvm3_get_range(nvm3_ObjectKey_t key);
+static void nvm3_account_write(nvm3_ObjectKey_t key, size_t len, Ecode_t status);
+static void nvm3_request_repack(void);
+static Ecode_t nvm3_repack_step(void);
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -57,10 +82,113 @@
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
+static sli_sid_nvm3_stats_t nvm3_stats;
+// Bytes written to flash since boot including the object overhead
+static uint64_t nvm3_flash_bytes;
+static volatile bool is_repack_pending;
+
+static bool is_initialized;
+
+#if defined(NVM3_REPACK_TASK)
+static SemaphoreHandle_t repack_trigger = NULL;
+static TaskHandle_t repack_task_handle = NULL;
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
+static sli_sid_nvm3_range_t nvm3_get_range(nvm3_ObjectKey_t key)
+{
+  if (key >= SLI_SID_NVM3_KEY_MIN_APP && key <= SLI_SID_NVM3_KEY_MAX_APP) {
+    return SLI_SID_NVM3_RANGE_APP;
+  } else if (key >= SLI_SID_NVM3_KEY_MIN_PAL && key <= SLI_SID_NVM3_KEY_MAX_PAL) {
+    return SLI_SID_NVM3_RANGE_PAL;
+  } else if (key >= SLI_SID_NVM3_KEY_MIN_KV && key <= SLI_SID_NVM3_KEY_MAX_KV) {
+    return SLI_SID_NVM3_RANGE_KV;
+  } else if (key >= SLI_SID_NVM3_KEY_MIN_MFG && key <= SLI_SID_NVM3_KEY_MAX_MFG) {
+    return SLI_SID_NVM3_RANGE_MFG;
+  }
+  return SLI_SID_NVM3_RANGE_OTHER;
+}
+
+static void nvm3_account_write(nvm3_ObjectKey_t key, size_t len, Ecode_t status)
+{
+  sli_sid_nvm3_range_t range = nvm3_get_range(key);
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  if (status == ECODE_NVM3_OK) {
+    nvm3_stats.writes[range]++;
+    nvm3_stats.bytes_written[range] += (uint32_t)len;
+    // Flash is written in a ring, every page gets erased once per page size written
+    nvm3_flash_bytes += NVM3_OBJ_SIZE(len);
+    nvm3_stats.page_erases_estimate = (uint32_t)(nvm3_flash_bytes / FLASH_PAGE_SIZE);
+  } else {
+    nvm3_stats.write_errors++;
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+#if defined(NVM3_REPACK_TASK)
+static void nvm3_repack_task(void *context)
+{
+  (void)context;
+
+  while (1) {
+    if (xSemaphoreTake(repack_trigger, portMAX_DELAY) == pdTRUE) {
+      // One step at a time so that any other ready task runs in between
+      while (sli_sid_nvm3_process()) {
+        taskYIELD();
+      }
+    }
+  }
+}
+#endif
+
+static void nvm3_request_repack(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  nvm3_stats.repack_requests++;
+  is_repack_pending = true;
+  CORE_EXIT_CRITICAL();
+
+#if !SL_SID_NVM3_BACKGROUND_REPACK_ENABLE
+  (void)sli_sid_nvm3_process();
+#elif defined(NVM3_REPACK_TASK)
+  // Without the task (not initialized or creation failed) the repack stays
+  // pending, nvm3 still repacks by itself when it runs out of space
+  if (repack_task_handle != NULL) {
+    (void)xSemaphoreGive(repack_trigger);
+  }
+#endif
+}
+
+static Ecode_t nvm3_repack_step(void)
+{
+  uint32_t start = sl_sleeptimer_get_tick_count();
+  Ecode_t status = nvm3_repack(nvm3_defaultHandle);
+  uint32_t duration_ms = sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count() - start);
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  nvm3_stats.repack_steps++;
+  nvm3_stats.repack_time_total_ms += duration_ms;
+  if (duration_ms > nvm3_stats.repack_time_max_ms) {
+    nvm3_stats.repack_time_max_ms = duration_ms;
+  }
+  if (status != ECODE_NVM3_OK) {
+    nvm3_stats.repack_errors++;
+  }
+  CORE_EXIT_CRITICAL();
+
+  if (status != ECODE_NVM3_OK) {
+    SID_PAL_LOG_ERROR("pal: nvm3 repack err: %d", status);
+  }
+  return status;
+}
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -106,3 +234,114 @@ sid_error_t sli_sid_nvm3_convert_ecode_to_sid_error(Ecode_t nvm3_return_code)
 
   return sid_error_code;
 }
+
+void sli_sid_nvm3_init(void)
+{
+  bool init_done;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  init_done = is_initialized;
+  is_initialized = true;
+  CORE_EXIT_CRITICAL();
+
+  if (init_done) {
+    return;
+  }
+
+#if defined(NVM3_REPACK_TASK)
+  repack_trigger = xSemaphoreCreateBinary();
+  if (repack_trigger == NULL) {
+    SID_PAL_LOG_ERROR("pal: nvm3 repack sem create err");
+    return;
+  }
+
+  if (xTaskCreate(nvm3_repack_task, "NVM3", NVM3_REPACK_TASK_STACK_DEPTH, NULL, tskIDLE_PRIORITY, &repack_task_handle) != pdPASS) {
+    SID_PAL_LOG_ERROR("pal: nvm3 repack task create err");
+    vSemaphoreDelete(repack_trigger);
+    repack_trigger = NULL;
+    repack_task_handle = NULL;
+    return;
+  }
+#endif
+}
+
+Ecode_t sli_sid_nvm3_write(nvm3_ObjectKey_t key, const void *value, size_t len)
+{
+  Ecode_t status = nvm3_writeData(nvm3_defaultHandle, key, value, len);
+
+  if (status == ECODE_NVM3_ERR_STORAGE_FULL) {
+    // The background repack did not keep up, free space now and retry once
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_CRITICAL();
+    nvm3_stats.repack_forced++;
+    CORE_EXIT_CRITICAL();
+    while (nvm3_repackNeeded(nvm3_defaultHandle)) {
+      if (nvm3_repack_step() != ECODE_NVM3_OK) {
+        break;
+      }
+    }
+    status = nvm3_writeData(nvm3_defaultHandle, key, value, len);
+  }
+
+  nvm3_account_write(key, len, status);
+
+  if (status == ECODE_NVM3_OK && nvm3_repackNeeded(nvm3_defaultHandle)) {
+    nvm3_request_repack();
+  }
+
+  return status;
+}
+
+bool sli_sid_nvm3_process(void)
+{
+  if (!is_repack_pending) {
+    return false;
+  }
+
+  if (nvm3_repackNeeded(nvm3_defaultHandle)) {
+    if (nvm3_repack_step() != ECODE_NVM3_OK) {
+      // Retried on the next write that needs a repack
+      is_repack_pending = false;
+      return false;
+    }
+  }
+
+  is_repack_pending = nvm3_repackNeeded(nvm3_defaultHandle);
+  return is_repack_pending;
+}
+
+bool sli_sid_nvm3_is_repack_pending(void)
+{
+  return is_repack_pending;
+}
+
+void sli_sid_nvm3_get_stats(sli_sid_nvm3_stats_t *stats)
+{
+  if (stats == NULL) {
+    return;
+  }
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  memcpy(stats, &nvm3_stats, sizeof(*stats));
+  CORE_EXIT_CRITICAL();
+
+  // Kept by nvm3 in the page headers, survives resets
+  uint32_t erase_count = 0;
+  Ecode_t status = nvm3_getEraseCount(nvm3_defaultHandle, &erase_count);
+  if (status != ECODE_NVM3_OK) {
+    SID_PAL_LOG_WARNING("pal: nvm3 erase count err: %d", status);
+    erase_count = 0;
+  }
+  stats->erase_count = erase_count;
+}
+
+void sli_sid_nvm3_reset_stats(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  memset(&nvm3_stats, 0, sizeof(nvm3_stats));
+  nvm3_flash_bytes = 0;
+  CORE_EXIT_CRITICAL();
+}
@@ -84,6 +84,9 @@ sid_error_t sid_pal_storage_kv_init(void)
       retval = SID_ERROR_GENERIC;
     }
   }
+  if (retval == SID_ERROR_NONE) {
+    sli_sid_nvm3_init();
+  }
 
   uint16_t obj_cnt = (uint16_t)nvm3_enumObjects(nvm3_defaultHandle, NULL, 0, SLI_SID_NVM3_KEY_MIN_KV, SLI_SID_NVM3_KEY_MAX_KV);
   SID_PAL_LOG_INFO("pal: kv store opened with %d object(s)", obj_cnt);
@@ -250,7 +253,7 @@ sid_error_t sid_pal_storage_kv_record_set(uint16_t group, uint16_t key, void con
       // Copy the actual data after the header
       memcpy(&raw_file_buffer[STORAGE_KV_REC_HDR_SIZE], p_data, len);
 
-      status = nvm3_writeData(nvm3_defaultHandle, mapped_key, raw_file_buffer, new_object_size);
+      status = sli_sid_nvm3_write(mapped_key, raw_file_buffer, new_object_size);
 
       sl_free(raw_file_buffer);
     }
@@ -275,13 +278,8 @@ sid_error_t sid_pal_storage_kv_record_set(uint16_t group, uint16_t key, void con
     // Copy the actual data after the header
     memcpy(&raw_file_buffer[data_len + STORAGE_KV_REC_HDR_SIZE], p_data, len);
 
-    status = nvm3_writeData(nvm3_defaultHandle, mapped_key, raw_file_buffer, new_object_size);
-
-    if (status == ECODE_OK) {
-      if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-        status = nvm3_repack(nvm3_defaultHandle);
-      }
-    }
+    // Repack is scheduled by the nvm3 manager
+    status = sli_sid_nvm3_write(mapped_key, raw_file_buffer, new_object_size);
 
     sl_free(raw_file_buffer);
   }
@@ -366,10 +364,9 @@ sid_error_t sid_pal_storage_kv_record_delete(uint16_t group, uint16_t key)
         if (status != ECODE_NVM3_OK) {
           break;
         }
-        status = nvm3_writeData(nvm3_defaultHandle,
-                                mapped_key,
-                                raw_file_buffer,
-                                data_len - record_header.data_size - STORAGE_KV_REC_HDR_SIZE);
+        status = sli_sid_nvm3_write(mapped_key,
+                                    raw_file_buffer,
+                                    data_len - record_header.data_size - STORAGE_KV_REC_HDR_SIZE);
 
         if (status != ECODE_NVM3_OK) {
           break;
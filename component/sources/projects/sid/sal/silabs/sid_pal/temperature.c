@@ -38,17 +38,241 @@
 // -----------------------------------------------------------------------------
 //                                   Includes
 // -----------------------------------------------------------------------------
+#include <stddef.h>
 #include <sid_pal_temperature_ifc.h>
 
+#include "em_core.h"
+#include "em_emu.h"
+#include "sl_sleeptimer.h"
+#include "temperature.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#if defined(_EMU_TEMP_TEMP_MASK)
+#define TEMPERATURE_INTERNAL_SENSOR_PRESENT
+#endif
+
+// Sampling period of the internal sensor, doubled after every stable sample
+// up to the maximum and reset to the minimum when the temperature moves
+#ifndef SLI_SID_TEMPERATURE_PERIOD_MIN_MS
+#define SLI_SID_TEMPERATURE_PERIOD_MIN_MS     1000
+#endif
+#ifndef SLI_SID_TEMPERATURE_PERIOD_MAX_MS
+#define SLI_SID_TEMPERATURE_PERIOD_MAX_MS     32000
+#endif
+// A sample closer than this to the filtered value counts as stable (m°C)
+#ifndef SLI_SID_TEMPERATURE_STABLE_DELTA
+#define SLI_SID_TEMPERATURE_STABLE_DELTA      500
+#endif
+// Exponential filter weight of a new sample, 1 / 2^shift
+#ifndef SLI_SID_TEMPERATURE_FILTER_SHIFT
+#define SLI_SID_TEMPERATURE_FILTER_SHIFT      2
+#endif
+
+typedef struct {
+  sli_sid_temperature_cb_t callback;
+  void *context;
+  int32_t delta;
+  int32_t reference;
+  bool fired;
+} temperature_cb_entry_t;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+static bool temperature_process_sample(int32_t sample);
+#if defined(TEMPERATURE_INTERNAL_SENSOR_PRESENT)
+static void temperature_timer_cb(sl_sleeptimer_timer_handle_t *handle, void *data);
+#endif
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static volatile int32_t filtered_temperature;
+static volatile bool has_sample = false;
+static volatile bool external_source = false;
+static temperature_cb_entry_t callbacks[SLI_SID_TEMPERATURE_MAX_CALLBACKS];
+static volatile uint8_t callback_count = 0;
+#if defined(TEMPERATURE_INTERNAL_SENSOR_PRESENT)
+static bool is_init = false;
+static sl_sleeptimer_timer_handle_t temperature_timer;
+static uint32_t sample_period_ms = SLI_SID_TEMPERATURE_PERIOD_MIN_MS;
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
 sid_error_t sid_pal_temperature_init(void)
 {
+#if defined(TEMPERATURE_INTERNAL_SENSOR_PRESENT)
+  if (is_init || external_source) {
+    return SID_ERROR_NONE;
+  }
+
+  is_init = true;
+  sample_period_ms = SLI_SID_TEMPERATURE_PERIOD_MIN_MS;
+  // Take the first sample right away so readers get a value immediately
+  temperature_timer_cb(&temperature_timer, NULL);
+  return SID_ERROR_NONE;
+#else
+  // Readings can still be fed by an external sensor
   return SID_ERROR_NOSUPPORT;
+#endif
 }
 
 int16_t sid_pal_temperature_get(void)
 {
-  return 0;
+  if (!has_sample) {
+    return 0;
+  }
+
+  int32_t temperature = filtered_temperature;
+  // round to the nearest degree
+  temperature += (temperature >= 0) ? 500 : -500;
+  return (int16_t)(temperature / 1000);
+}
+
+sid_error_t sli_sid_temperature_get(int32_t *temperature)
+{
+  if (temperature == NULL) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (!has_sample) {
+    return SID_ERROR_UNINITIALIZED;
+  }
+
+  *temperature = filtered_temperature;
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_temperature_register_cb(int32_t delta,
+                                            sli_sid_temperature_cb_t callback,
+                                            void *context)
+{
+  sid_error_t err = SID_ERROR_NONE;
+
+  if (callback == NULL) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (delta <= 0) {
+    return SID_ERROR_INVALID_ARGS;
+  }
+
+  bool initial = false;
+  int32_t value = 0;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if (callback_count >= SLI_SID_TEMPERATURE_MAX_CALLBACKS) {
+    err = SID_ERROR_OOM;
+  } else {
+    // Give the new callback its initial value without waiting for a sample
+    initial = has_sample;
+    value = filtered_temperature;
+
+    temperature_cb_entry_t *entry = &callbacks[callback_count];
+    entry->callback = callback;
+    entry->context = context;
+    entry->delta = delta;
+    entry->reference = value;
+    entry->fired = initial;
+    callback_count++;
+  }
+  CORE_EXIT_ATOMIC();
+
+  if (initial) {
+    callback(value, context);
+  }
+
+  return err;
+}
+
+void sli_sid_temperature_feed(int32_t temperature)
+{
+  if (!external_source) {
+    external_source = true;
+#if defined(TEMPERATURE_INTERNAL_SENSOR_PRESENT)
+    if (is_init) {
+      (void)sl_sleeptimer_stop_timer(&temperature_timer);
+    }
+#endif
+  }
+
+  (void)temperature_process_sample(temperature);
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Filter a new sample and fire the callbacks whose threshold is crossed.
+ *
+ * @param[in]   sample          raw temperature in milli degree Celsius
+ *
+ * @return true if the sample was close to the filtered value
+ ******************************************************************************/
+static bool temperature_process_sample(int32_t sample)
+{
+  bool stable;
+  int32_t filtered;
+
+  if (!has_sample) {
+    filtered = sample;
+    stable = false;
+  } else {
+    int32_t diff = sample - filtered_temperature;
+    filtered = filtered_temperature + diff / (1 << SLI_SID_TEMPERATURE_FILTER_SHIFT);
+    stable = (diff < SLI_SID_TEMPERATURE_STABLE_DELTA) && (diff > -SLI_SID_TEMPERATURE_STABLE_DELTA);
+  }
+  filtered_temperature = filtered;
+  has_sample = true;
+
+  for (uint8_t i = 0; i < callback_count; i++) {
+    temperature_cb_entry_t *entry = &callbacks[i];
+    int32_t moved = filtered - entry->reference;
+
+    if (!entry->fired || moved >= entry->delta || moved <= -entry->delta) {
+      entry->reference = filtered;
+      entry->fired = true;
+      entry->callback(filtered, entry->context);
+    }
+  }
+
+  return stable;
+}
+
+#if defined(TEMPERATURE_INTERNAL_SENSOR_PRESENT)
+static void temperature_timer_cb(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  (void)handle;
+  (void)data;
+
+  if (external_source) {
+    return;
+  }
+
+  int32_t sample = (int32_t)(EMU_TemperatureGet() * 1000.0f);
+
+  if (temperature_process_sample(sample)) {
+    if (sample_period_ms < SLI_SID_TEMPERATURE_PERIOD_MAX_MS) {
+      sample_period_ms *= 2;
+      if (sample_period_ms > SLI_SID_TEMPERATURE_PERIOD_MAX_MS) {
+        sample_period_ms = SLI_SID_TEMPERATURE_PERIOD_MAX_MS;
+      }
+    }
+  } else {
+    sample_period_ms = SLI_SID_TEMPERATURE_PERIOD_MIN_MS;
+  }
+
+  (void)sl_sleeptimer_start_timer_ms(&temperature_timer,
+                                     sample_period_ms,
+                                     temperature_timer_cb,
+                                     NULL,
+                                     0,
+                                     0);
 }
+#endif
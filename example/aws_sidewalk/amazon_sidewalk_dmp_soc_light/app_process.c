@@ -133,13 +133,13 @@ static void exec_time(app_context_t *app_ctx);
 static void exec_mtu(app_context_t *app_ctx);
 
 /*******************************************************************************
- * Function to convert application message into sidewalk message and to send it
- * over the sidewalk network
+ * Function to send an encoded application message over the sidewalk network
  *
  * @param[in] app_ctx Application context
- * @param[in] send_app_msg Message to be sent
+ * @param[in] send_sid_msg Sidewalk message holding the encoded application message
+ * @param[in] status Status of the application message encoding
  ******************************************************************************/
-static void send_message(app_context_t *app_ctx, sl_sid_app_msg_t *send_app_msg);
+static void send_message(app_context_t *app_ctx, struct sid_msg *send_sid_msg, sl_sid_app_msg_st_t status);
 #endif
 
 /*******************************************************************************
@@ -742,7 +742,9 @@ static void dev_reset_timer_cb(TimerHandle_t tmr_hdl)
 #if defined(SL_SID_APP_MSG_PRESENT)
 static void exec_device_reset(app_context_t *app_ctx)
 {
-  sl_sid_app_msg_t app_msg;
+  uint8_t tx_buf[SL_SID_APP_MSG_TX_BUF_SIZE(app_ctx->app_msg.rst_dev_ctx)];
+  struct sid_msg send_sid_msg = { .data = tx_buf, .size = sizeof(tx_buf) };
+  sl_sid_app_msg_st_t status;
 
   app_ctx->app_msg.rst_dev_ctx.param_ack.ack_nack = SL_SID_APP_MSG_APP_NACK_VAL;
 
@@ -775,30 +777,29 @@ static void exec_device_reset(app_context_t *app_ctx)
 
   send_response:
 
-  sl_sid_app_msg_dev_mgmt_rst_dev_prepare_send(&app_ctx->app_msg.rst_dev_ctx, &app_msg);
-  send_message(app_ctx, &app_msg);
+  status = sl_sid_app_msg_dev_mgmt_rst_dev_prepare_send(&app_ctx->app_msg.rst_dev_ctx, &send_sid_msg);
+  send_message(app_ctx, &send_sid_msg, status);
 }
 #endif
 
 #if defined(SL_SID_APP_MSG_PRESENT)
 static void exec_send_button_press_resp(app_context_t *app_ctx)
 {
-  sl_sid_app_msg_t app_msg;
-
   // the operation is already set for requests rather than real btn press
   if (!app_ctx->app_msg.button_press_ctx.is_emulation) {
     app_ctx->app_msg.button_press_ctx.hdl.operation = SL_SID_APP_MSG_OP_NTFY;
   }
   app_ctx->app_msg.button_press_ctx.is_emulation = false;
 
-  sl_sid_app_msg_dev_mgmt_button_press_prepare_send(&app_ctx->app_msg.button_press_ctx, &app_msg);
-  send_message(app_ctx, &app_msg);
+  uint8_t tx_buf[SL_SID_APP_MSG_TX_BUF_SIZE(app_ctx->app_msg.button_press_ctx)];
+  struct sid_msg send_sid_msg = { .data = tx_buf, .size = sizeof(tx_buf) };
+
+  sl_sid_app_msg_st_t status = sl_sid_app_msg_dev_mgmt_button_press_prepare_send(&app_ctx->app_msg.button_press_ctx, &send_sid_msg);
+  send_message(app_ctx, &send_sid_msg, status);
 }
 
 void sl_sidewalk_led_manager_led_state_changed(uint8_t led_id, sl_led_state_t new_led_state)
 {
-  sl_sid_app_msg_t app_msg;
-
   g_app_ctx.app_msg.toggle_led_ctx.param_send.led = led_id;
   g_app_ctx.app_msg.toggle_led_ctx.param_send.state = new_led_state;
   g_app_ctx.app_msg.toggle_led_ctx.param_ack.ack_nack = SL_SID_APP_MSG_APP_ACK_VAL;
@@ -808,8 +809,11 @@ void sl_sidewalk_led_manager_led_state_changed(uint8_t led_id, sl_led_state_t ne
   // Bluetooth update
   app_bluetooth_update_led_status(g_app_ctx.app_msg.toggle_led_ctx.param_send.state);
 
-  sl_sid_app_msg_dev_mgmt_toggle_led_prepare_send(&g_app_ctx.app_msg.toggle_led_ctx, &app_msg);
-  send_message(&g_app_ctx, &app_msg);
+  uint8_t tx_buf[SL_SID_APP_MSG_TX_BUF_SIZE(g_app_ctx.app_msg.toggle_led_ctx)];
+  struct sid_msg send_sid_msg = { .data = tx_buf, .size = sizeof(tx_buf) };
+
+  sl_sid_app_msg_st_t status = sl_sid_app_msg_dev_mgmt_toggle_led_prepare_send(&g_app_ctx.app_msg.toggle_led_ctx, &send_sid_msg);
+  send_message(&g_app_ctx, &send_sid_msg, status);
 }
 
 static void exec_ble_start_stop(app_context_t *app_ctx)
@@ -851,30 +855,34 @@ static void exec_ble_start_stop(app_context_t *app_ctx)
 
   app_log_info("app: sending ble status: 0x%02x", app_ctx->app_msg.ble_start_stop_ctx.param_send.state);
 
-  sl_sid_app_msg_t app_msg;
+  uint8_t tx_buf[SL_SID_APP_MSG_TX_BUF_SIZE(app_ctx->app_msg.ble_start_stop_ctx)];
+  struct sid_msg send_sid_msg = { .data = tx_buf, .size = sizeof(tx_buf) };
 
-  sl_sid_app_msg_dmp_soc_light_ble_start_stop_prepare_send(&app_ctx->app_msg.ble_start_stop_ctx, &app_msg);
-  send_message(app_ctx, &app_msg);
+  sl_sid_app_msg_st_t status = sl_sid_app_msg_dmp_soc_light_ble_start_stop_prepare_send(&app_ctx->app_msg.ble_start_stop_ctx, &send_sid_msg);
+  send_message(app_ctx, &send_sid_msg, status);
 }
 
 static void exec_counter_update(app_context_t *app_ctx)
 {
-  sl_sid_app_msg_t app_msg;
-
   app_log_info("app: sending ctr update: %d", app_ctx->counter);
   app_ctx->app_msg.update_counter_ctx.param_ack.ack_nack = SL_SID_APP_MSG_APP_ACK_VAL;
   app_ctx->app_msg.update_counter_ctx.param_ack.optional = (uint16_t)app_ctx->counter;
   app_ctx->app_msg.update_counter_ctx.param_send.counter = app_ctx->counter;
   app_ctx->counter++;
 
-  sl_sid_app_msg_dmp_soc_light_update_counter_prepare_send(&app_ctx->app_msg.update_counter_ctx, &app_msg);
-  send_message(app_ctx, &app_msg);
+  uint8_t tx_buf[SL_SID_APP_MSG_TX_BUF_SIZE(app_ctx->app_msg.update_counter_ctx)];
+  struct sid_msg send_sid_msg = { .data = tx_buf, .size = sizeof(tx_buf) };
+
+  sl_sid_app_msg_st_t status = sl_sid_app_msg_dmp_soc_light_update_counter_prepare_send(&app_ctx->app_msg.update_counter_ctx, &send_sid_msg);
+  send_message(app_ctx, &send_sid_msg, status);
 }
 
 static void exec_time(app_context_t *app_ctx)
 {
   struct sid_timespec curr_time = SID_TIME_INFINITY;
-  sl_sid_app_msg_t app_msg;
+  uint8_t tx_buf[SL_SID_APP_MSG_TX_BUF_SIZE(app_ctx->app_msg.time_ctx)];
+  struct sid_msg send_sid_msg = { .data = tx_buf, .size = sizeof(tx_buf) };
+  sl_sid_app_msg_st_t status;
 
   app_ctx->app_msg.time_ctx.param_ack.ack_nack = SL_SID_APP_MSG_APP_NACK_VAL;
 
@@ -891,14 +899,16 @@ static void exec_time(app_context_t *app_ctx)
 
   send_response:
 
-  sl_sid_app_msg_sid_time_prepare_send(&app_ctx->app_msg.time_ctx, &app_msg);
-  send_message(app_ctx, &app_msg);
+  status = sl_sid_app_msg_sid_time_prepare_send(&app_ctx->app_msg.time_ctx, &send_sid_msg);
+  send_message(app_ctx, &send_sid_msg, status);
 }
 
 static void exec_mtu(app_context_t *app_ctx)
 {
   uint32_t mtu = 0xFFFFFFFF;
-  sl_sid_app_msg_t app_msg;
+  uint8_t tx_buf[SL_SID_APP_MSG_TX_BUF_SIZE(app_ctx->app_msg.mtu_ctx)];
+  struct sid_msg send_sid_msg = { .data = tx_buf, .size = sizeof(tx_buf) };
+  sl_sid_app_msg_st_t status;
 
   app_ctx->app_msg.mtu_ctx.param_ack.ack_nack = SL_SID_APP_MSG_APP_NACK_VAL;
 
@@ -914,8 +924,8 @@ static void exec_mtu(app_context_t *app_ctx)
 
   send_response:
 
-  sl_sid_app_msg_sid_mtu_prepare_send(&app_ctx->app_msg.mtu_ctx, &app_msg);
-  send_message(app_ctx, &app_msg);
+  status = sl_sid_app_msg_sid_mtu_prepare_send(&app_ctx->app_msg.mtu_ctx, &send_sid_msg);
+  send_message(app_ctx, &send_sid_msg, status);
 }
 #endif
 
@@ -954,16 +964,14 @@ static int32_t init_and_start_regular_ble(app_context_t *app_ctx)
 }
 
 #if defined(SL_SID_APP_MSG_PRESENT)
-static void send_message(app_context_t *app_ctx, sl_sid_app_msg_t *app_msg)
+static void send_message(app_context_t *app_ctx, struct sid_msg *send_sid_msg, sl_sid_app_msg_st_t status)
 {
   if (app_ctx->state != STATE_SIDEWALK_READY && app_ctx->state != STATE_SIDEWALK_SECURE_CONNECTION) {
     app_log_warning("app: msg cant be sent as sid is not ready yet");
     return;
   }
 
-  // Convert application message into sidewalk message
-  struct sid_msg send_sid_msg;
-  sl_sid_app_msg_st_t status = sl_sid_app_msg_prepare_sid_msg(app_msg, &send_sid_msg);
+  // Application message is already encoded into the sidewalk message buffer
   if (status != SL_SID_APP_MSG_ERR_ST_SUCCESS) {
     app_log_error("app: app msg send error (status: %d)", status);
     return;
@@ -974,14 +982,14 @@ static void send_message(app_context_t *app_ctx, sl_sid_app_msg_t *app_msg)
     .type = SID_MSG_TYPE_NOTIFY,
     .link_type = SID_LINK_TYPE_ANY,
   };
-  sid_error_t ret = sid_put_msg(app_ctx->sidewalk_handle, &send_sid_msg, &desc);
+  sid_error_t ret = sid_put_msg(app_ctx->sidewalk_handle, send_sid_msg, &desc);
   if (ret != SID_ERROR_NONE) {
     app_log_error("app: queueing data failed: %d", (int)ret);
     return;
   }
 
   app_log_info("app: queued data msg id: %u", desc.id);
-  app_log_hexdump_info(send_sid_msg.data, send_sid_msg.size);
+  app_log_hexdump_info(send_sid_msg->data, send_sid_msg->size);
 
   return;
 }
@@ -47,6 +47,7 @@
 #include "sl_sidewalk_pdp_parser.h"
 #include "sl_sidewalk_pdp_priv_key_prov.h"
 #include "sl_sidewalk_pdp_on_dev_cert_gen.h"
+#include "sid_on_dev_cert.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -70,11 +71,23 @@ static process_req_t process_req[] = {
   sl_sid_pdp_on_dev_cert_gen_write_app_key,
   sl_sid_pdp_on_dev_cert_gen_commit
 };
+// Largest response data of each command, an internal error is a sid_error_t
+static const uint16_t process_rsp_max_len[] = {
+  sizeof(sid_error_t),
+  sizeof(sid_error_t),
+  sizeof(sid_error_t),
+  sizeof(uint32_t) + SID_ODC_SMSN_SIZE,
+  sizeof(uint32_t) + SID_ODC_CSR_MAX_SIZE,
+  sizeof(sid_error_t),
+  sizeof(sid_error_t),
+  sizeof(sid_error_t)
+};
 
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+static sl_sid_pdp_status_t process_batch(const uint8_t * const in, uint16_t in_len, uint8_t * const out, uint16_t out_size, uint16_t * const out_len);
 static void send_response(uint32_t status, uint32_t data_len, const uint8_t *data);
 
 // -----------------------------------------------------------------------------
@@ -109,7 +122,11 @@ void app_process(void)
     }
 
     // process request and prepare response if needed
-    sl_sid_pdp_st = process_req[cmd](req, req_len, tx_pkt, sizeof(tx_pkt), &tx_len);
+    if (cmd == SL_SID_PDP_CMD_BATCH) {
+      sl_sid_pdp_st = process_batch(req, req_len, tx_pkt, sizeof(tx_pkt), &tx_len);
+    } else {
+      sl_sid_pdp_st = process_req[cmd](req, req_len, tx_pkt, sizeof(tx_pkt), &tx_len);
+    }
     if (sl_sid_pdp_st != SL_SID_PDP_STATUS_SUCCESS) {
       goto cleanup;
     }
@@ -123,6 +140,66 @@ void app_process(void)
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
+static sl_sid_pdp_status_t process_batch(const uint8_t * const in, uint16_t in_len, uint8_t * const out, uint16_t out_size, uint16_t * const out_len)
+{
+  sl_sid_pdp_status_t sl_sid_pdp_st = SL_SID_PDP_STATUS_SUCCESS;
+  uint16_t in_idx = 0;
+  uint16_t out_idx = SL_SID_PDP_BATCH_RSP_HDR_LEN;
+
+  if (out_size < SL_SID_PDP_BATCH_RSP_HDR_LEN) {
+    return SL_SID_PDP_STATUS_ERR_OUT_ARGS_NOT_VALID;
+  }
+
+  // requests are processed in order, the first failure ends the batch
+  while (in_idx < in_len) {
+    const uint8_t *req = NULL;
+    uint16_t req_len = 0;
+    uint16_t data_len = 0;
+    uint8_t cmd;
+    uint32_t status;
+
+    sl_sid_pdp_st = sl_sid_pdp_parse_batch_req(in, in_len, &in_idx, &req, &req_len, &cmd);
+    if (sl_sid_pdp_st != SL_SID_PDP_STATUS_SUCCESS) {
+      break;
+    }
+
+    if (cmd == SL_SID_PDP_CMD_BATCH) {
+      sl_sid_pdp_st = SL_SID_PDP_STATUS_ERR_BATCH_NESTED;
+      break;
+    }
+
+    // handlers do not bound their response to out_size, make sure the
+    // largest one fits before running the command
+    if ((out_size - out_idx) < (SL_SID_PDP_BATCH_RSP_ENTRY_HDR_LEN + process_rsp_max_len[cmd])) {
+      sl_sid_pdp_st = SL_SID_PDP_STATUS_ERR_BATCH_RSP_TOO_BIG;
+      break;
+    }
+
+    uint8_t *entry = &out[out_idx];
+    sl_sid_pdp_st = process_req[cmd](req,
+                                     req_len,
+                                     &entry[SL_SID_PDP_BATCH_RSP_ENTRY_HDR_LEN],
+                                     out_size - out_idx - SL_SID_PDP_BATCH_RSP_ENTRY_HDR_LEN,
+                                     &data_len);
+
+    status = sl_sid_pdp_st;
+    memcpy(&entry[0], (uint8_t *)&status, sizeof(status));
+    memcpy(&entry[sizeof(status)], (uint8_t *)&data_len, sizeof(data_len));
+    out_idx += SL_SID_PDP_BATCH_RSP_ENTRY_HDR_LEN + data_len;
+
+    if (sl_sid_pdp_st != SL_SID_PDP_STATUS_SUCCESS) {
+      break;
+    }
+  }
+
+  // the length lets the host tell a complete response from a partial read
+  uint16_t entries_len = out_idx - SL_SID_PDP_BATCH_RSP_HDR_LEN;
+  memcpy(&out[0], (uint8_t *)&entries_len, sizeof(entries_len));
+  *out_len = out_idx;
+
+  return sl_sid_pdp_st;
+}
+
 static void send_response(uint32_t status, uint32_t data_len, const uint8_t *data)
 {
   sl_iostream_write(sl_iostream_rtt_handle, (const void *)&status, sizeof(status));
@@ -43,6 +43,7 @@
 #include "sl_system_init.h"
 #include "app_process.h"
 #include "app_init.h"
+#include "nvm3_manager.h"
 #if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
 #include "sl_power_manager.h"
 #endif // SL_CATALOG_POWER_MANAGER_PRESENT
@@ -66,6 +67,9 @@ int main(void)
   while (1) {
     sl_system_process_action();
     app_process();
+    // Finish the nvm3 repacks scheduled by the provisioning writes before sleeping
+    while (sli_sid_nvm3_process()) {
+    }
 #if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
     sl_power_manager_sleep();
 #endif // SL_CATALOG_POWER_MANAGER_PRESENT
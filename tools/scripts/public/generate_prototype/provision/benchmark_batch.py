@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: MIT-0
+#
+
+"""
+Measures the throughput of the batch mode in images per second.
+
+Without --manifest a lot of synthetic aws devices (random certificate chains,
+one shared device profile) is generated first, the images are therefore not
+valid for a real device and are deleted afterwards unless --keep is given.
+"""
+
+from __future__ import annotations
+import argparse
+import base64
+import binascii
+import csv
+import json
+import os
+import shutil
+import sys
+import tempfile
+from ctypes import sizeof
+from pathlib import Path
+from typing import List
+
+from sid_provision.batch import DEFAULT_CHUNKSIZE, create_context, read_manifest, run_batch
+from sid_provision.run import (
+    PRK_SIZE,
+    SMSN_SIZE,
+    SidCertMfgED25519Chain,
+    SidCertMfgP256R1Chain,
+    valid_yaml_file,
+)
+
+
+def create_synthetic_lot(work_dir: Path, count: int) -> str:
+    device_profile = {
+        "Sidewalk": {
+            "ApplicationServerPublicKey": binascii.hexlify(os.urandom(32)).decode(),
+            "DakCertificateMetadata": [{"DeviceTypeId": "0123456789ABCDEF"}],
+        }
+    }
+    (work_dir / "device_profile.json").write_text(json.dumps(device_profile))
+
+    manifest = work_dir / "manifest.csv"
+    with open(manifest, "w", newline="") as manifest_file:
+        writer = csv.writer(manifest_file)
+        writer.writerow(["name", "wireless_device_json", "device_profile_json"])
+        for index in range(count):
+            wireless_device = {
+                "Sidewalk": {
+                    "SidewalkManufacturingSn": binascii.hexlify(os.urandom(SMSN_SIZE)).decode(),
+                    "DeviceCertificates": [
+                        {
+                            "SigningAlg": "Ed25519",
+                            "Value": base64.b64encode(os.urandom(sizeof(SidCertMfgED25519Chain))).decode(),
+                        },
+                        {
+                            "SigningAlg": "P256r1",
+                            "Value": base64.b64encode(os.urandom(sizeof(SidCertMfgP256R1Chain))).decode(),
+                        },
+                    ],
+                    "PrivateKeys": [
+                        {"SigningAlg": "Ed25519", "Value": binascii.hexlify(os.urandom(PRK_SIZE)).decode()},
+                        {"SigningAlg": "P256r1", "Value": binascii.hexlify(os.urandom(PRK_SIZE)).decode()},
+                    ],
+                }
+            }
+            name = f"device_{index:06d}"
+            (work_dir / f"{name}.json").write_text(json.dumps(wireless_device))
+            writer.writerow([name, f"{name}.json", "device_profile.json"])
+    return str(manifest)
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        description="Report the batch mode throughput in images per second",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument("--platform", default="silabs", help="Target platform")
+    parser.add_argument("--input", default="aws", help="Input type of the manifest devices")
+    parser.add_argument("--manifest", default=None, help="Benchmark an existing manifest instead of a synthetic lot")
+    parser.add_argument("--count", type=int, default=1000, help="Number of synthetic devices")
+    parser.add_argument("--formats", nargs="+", default=["nvm3"], help="Output formats")
+    parser.add_argument("--config", type=valid_yaml_file, default=None, help="Config Yaml of the mfg page offsets")
+    parser.add_argument("--chip", default=None, help="Which chip to generate the mfg page")
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        nargs="+",
+        default=sorted({1, 2, 4, os.cpu_count() or 1}),
+        help="Worker counts to benchmark",
+    )
+    parser.add_argument("--chunksize", type=int, default=DEFAULT_CHUNKSIZE, help="Devices handed to a worker at once")
+    parser.add_argument("--keep", action="store_true", help="Keep the generated lot and images")
+    args = parser.parse_args()
+
+    work_dir = Path(tempfile.mkdtemp(prefix="sid_batch_bench_"))
+    try:
+        manifest = args.manifest
+        if manifest is None:
+            print(f"Creating {args.count} synthetic devices in {work_dir}")
+            manifest = create_synthetic_lot(work_dir, args.count)
+
+        results: List[tuple] = []
+        for jobs in args.jobs:
+            ctx = create_context(
+                platform_name=args.platform,
+                input_type=args.input,
+                output_dir=str(work_dir / f"out_{jobs}"),
+                formats=args.formats,
+                config=args.config,
+                chip_name=args.chip,
+            )
+            summary = run_batch(ctx, read_manifest(manifest), workers=jobs, chunksize=args.chunksize)
+            if summary.failed:
+                print(f"{summary.failed} devices failed, see {summary.index_file}")
+                sys.exit(1)
+            results.append((jobs, summary))
+            print(f"jobs {jobs:3d}: {summary.generated} images in {summary.elapsed:7.2f}s")
+
+        base = results[0][1].images_per_second
+        print()
+        print(f"{'jobs':>5} {'images/s':>10} {'speedup':>8}")
+        for jobs, summary in results:
+            speedup = summary.images_per_second / base if base else 0.0
+            print(f"{jobs:>5} {summary.images_per_second:>10.1f} {speedup:>7.2f}x")
+    finally:
+        if args.keep:
+            print(f"Lot and images kept in {work_dir}")
+        else:
+            shutil.rmtree(work_dir, ignore_errors=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,10 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: MIT-0
+#
+
+import sid_provision.batch
+
+if __name__ == "__main__":
+    sid_provision.batch.main()
@@ -0,0 +1,595 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: MIT-0
+#
+
+"""
+Batch mode of the provision script.
+
+Reads a manifest of device json files (csv or jsonl), generates the
+manufacturing images of every device with a process pool and streams them to
+an output directory together with a checksum index.
+
+Everything that is the same for every device of a lot (platform, config yaml,
+chip address, shared device profile, app server public key, commander init
+file) is resolved once in the parent and handed to each worker a single time
+through the pool initializer, so per device only the device json files are
+parsed and encoded.
+"""
+
+from __future__ import annotations
+import argparse
+import binascii
+import contextlib
+import csv
+import dataclasses
+import hashlib
+import io
+import json
+import multiprocessing
+import os
+import subprocess
+import sys
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any
+from typing import Dict
+from typing import Iterable
+from typing import Iterator
+from typing import List
+from typing import Optional
+from intelhex import IntelHex
+
+from sid_provision.run import (
+    ARG_GROUPS,
+    AttrDict,
+    SidChipAddr,
+    SidMfg,
+    SidMfgAcsJson,
+    SidMfgAwsJson,
+    SidMfgBBJson,
+    SidMfgOutBin,
+    SidMfgOutNVM3,
+    SidPlatformArgs,
+    get_default_config_file,
+    get_default_platform_chip,
+    is_file_or_hex,
+    auto_int,
+    print_subprocess_results,
+    valid_path_to_commander,
+    valid_yaml_file,
+)
+
+# pylint: disable=C0114,C0115,C0116
+
+INPUT_TYPES = ["aws", "acs", "bb"]
+
+# Columns a manifest row may have, paths are relative to the manifest file
+MANIFEST_FILE_COLUMNS = [
+    "wireless_device_json",
+    "device_profile_json",
+    "certificate_json",
+    "json",
+]
+
+DEFAULT_INDEX_FILE = "index.jsonl"
+DEFAULT_CHUNKSIZE = 32
+
+
+@dataclass
+class BatchJob:
+    index: int
+    name: str
+    files: Dict[str, str] = field(default_factory=dict)
+    app_srv_pub: Optional[str] = None
+
+
+@dataclass
+class BatchOutFile:
+    ext: str
+    file: str
+    sha256: str
+    size: int
+
+
+@dataclass
+class BatchResult:
+    index: int
+    name: str
+    outputs: List[BatchOutFile] = field(default_factory=list)
+    error: str = ""
+    log: str = ""
+
+    @property
+    def ok(self) -> bool:
+        return not self.error
+
+
+@dataclass
+class BatchContext:
+    """Per lot state, pickled once per worker"""
+
+    platform: str
+    input_type: str
+    chip: SidChipAddr
+    formats: List[str]
+    output_dir: str
+    config: Dict[str, Any] = field(default_factory=dict)
+    device_profile_json: Optional[str] = None
+    app_srv_pub: Optional[bytes] = None
+    commander: str = ""
+    init_file: str = ""
+
+
+@dataclass
+class BatchSummary:
+    total: int = 0
+    failed: int = 0
+    skipped: int = 0
+    elapsed: float = 0.0
+    index_file: str = ""
+
+    @property
+    def generated(self) -> int:
+        return self.total - self.failed
+
+    @property
+    def images_per_second(self) -> float:
+        return self.generated / self.elapsed if self.elapsed else 0.0
+
+
+def get_platform(name: str) -> SidPlatformArgs:
+    for _ in ARG_GROUPS:
+        if _.platform.str_name == name:
+            return _
+    raise ValueError(f"Platform {name} unsupported!")
+
+
+def get_platform_formats(platform: SidPlatformArgs) -> List[str]:
+    return [_.ext for _ in platform.output_args]
+
+
+def read_manifest(manifest: str) -> Iterator[BatchJob]:
+    """
+    Yields one job per manifest row. A ".jsonl"/".ndjson" manifest holds one
+    json object per line, anything else is read as csv with a header row. An
+    optional "name" column selects the output file name, otherwise the name of
+    the first device json file is used.
+    """
+    base = Path(manifest).parent
+
+    def rows() -> Iterator[Dict[str, str]]:
+        with open(manifest, "r", newline="") as manifest_file:
+            if Path(manifest).suffix.lower() in (".jsonl", ".ndjson"):
+                for line_no, line in enumerate(manifest_file, start=1):
+                    if line.strip():
+                        try:
+                            yield json.loads(line)
+                        except json.JSONDecodeError as ex:
+                            raise ValueError(f"{manifest}:{line_no}: invalid json line") from ex
+            else:
+                yield from csv.DictReader(manifest_file)
+
+    names = set()
+    for index, row in enumerate(rows()):
+        files = {}
+        for column in MANIFEST_FILE_COLUMNS:
+            val = (row.get(column) or "").strip()
+            if val:
+                files[column] = str(base / val)
+
+        name = (row.get("name") or "").strip()
+        if not name:
+            first = next((files[_] for _ in MANIFEST_FILE_COLUMNS if _ in files and _ != "device_profile_json"), None)
+            name = Path(first).stem if first else f"device_{index:06d}"
+        if name in names:
+            raise ValueError(f"Duplicate output name {name} in {manifest}")
+        names.add(name)
+
+        app_srv_pub = (row.get("app_srv_pub") or "").strip() or None
+        if app_srv_pub and Path(base / app_srv_pub).is_file():
+            app_srv_pub = str(base / app_srv_pub)
+
+        yield BatchJob(index=index, name=name, files=files, app_srv_pub=app_srv_pub)
+
+
+# Worker process state, set once by _init_worker
+_ctx: Optional[BatchContext] = None
+_config: Any = None
+_json_cache: Dict[str, dict] = {}
+
+
+def _init_worker(ctx: BatchContext) -> None:
+    global _ctx, _config, _json_cache
+    _ctx = ctx
+    _config = AttrDict(ctx.config)
+    _json_cache = {}
+
+
+def _load_json(path: str, cache: bool = False) -> dict:
+    if cache and path in _json_cache:
+        return _json_cache[path]
+    with open(path, "r") as json_file:
+        json_data = json.load(json_file)
+    json_data["_SidewalkFileName"] = path
+    if cache:
+        _json_cache[path] = json_data
+    return json_data
+
+
+def _build_mfg(job: BatchJob) -> SidMfg:
+    assert _ctx is not None
+    if _ctx.input_type == "aws":
+        wireless_device = job.files.get("wireless_device_json")
+        # The device profile is usually the same file for the whole lot, parse it once per worker
+        device_profile = job.files.get("device_profile_json", _ctx.device_profile_json if wireless_device else None)
+        certificate = job.files.get("certificate_json")
+        if not (wireless_device and device_profile) and not certificate:
+            raise ValueError("Provide either wireless_device_json and device_profile_json or certificate_json")
+        return SidMfgAwsJson(
+            aws_wireless_device_json=_load_json(wireless_device) if wireless_device else {},
+            aws_device_profile_json=_load_json(device_profile, cache=True) if device_profile else {},
+            aws_certificate_json=_load_json(certificate) if certificate else {},
+            config=_config,
+        )
+
+    if "json" not in job.files:
+        raise ValueError("Missing json column")
+
+    if _ctx.input_type == "acs":
+        app_pub = is_file_or_hex(job.app_srv_pub) if job.app_srv_pub else _ctx.app_srv_pub
+        if app_pub is None:
+            raise ValueError("Missing app_srv_pub")
+        return SidMfgAcsJson(acs_json=_load_json(job.files["json"]), app_pub=app_pub, config=_config)
+
+    return SidMfgBBJson(bb_json=_load_json(job.files["json"]), config=_config)
+
+
+def _encode_hex(encoded: bytes, chip: SidChipAddr) -> bytes:
+    h = IntelHex()
+    h.frombytes(encoded, chip.offset_addr)
+    out = io.StringIO()
+    h.tofile(out, "hex")
+    return out.getvalue().encode()
+
+
+def _write_output(job: BatchJob, ext: str, data: bytes) -> BatchOutFile:
+    assert _ctx is not None
+    file_name = f"{job.name}.{ext}"
+    path = Path(_ctx.output_dir) / file_name
+    tmp_path = path.with_name(path.name + ".tmp")
+    with open(tmp_path, "wb") as out_file:
+        out_file.write(data)
+    # Only complete images ever show up under their final name
+    os.replace(tmp_path, path)
+    return BatchOutFile(ext=ext, file=file_name, sha256=hashlib.sha256(data).hexdigest(), size=len(data))
+
+
+def _run_commander_set(job: BatchJob) -> bytes:
+    assert _ctx is not None
+    nvm3_file = Path(_ctx.output_dir) / f"{job.name}.nvm3"
+    s37_file = Path(_ctx.output_dir) / f"{job.name}.s37.tmp"
+    gen_mfg_args = [
+        f"{_ctx.commander}",
+        "nvm3",
+        "set",
+        f"{_ctx.init_file}",
+        "--nvm3file",
+        f"{nvm3_file}",
+        "--outfile",
+        f"{s37_file}",
+    ]
+    result = subprocess.run(args=gen_mfg_args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    print_subprocess_results(result, " ".join(gen_mfg_args))
+    data = s37_file.read_bytes()
+    os.remove(s37_file)
+    return data
+
+
+def _remove_outputs(job: BatchJob, result: BatchResult) -> None:
+    """A device either has all of its images or none of them"""
+    assert _ctx is not None
+    for ext in _ctx.formats:
+        for file_name in (f"{job.name}.{ext}", f"{job.name}.{ext}.tmp"):
+            try:
+                os.remove(Path(_ctx.output_dir) / file_name)
+            except OSError:
+                pass
+    result.outputs = []
+
+
+def _generate(job: BatchJob) -> BatchResult:
+    assert _ctx is not None
+    result = BatchResult(index=job.index, name=job.name)
+    log = io.StringIO()
+    try:
+        with contextlib.redirect_stdout(log), contextlib.redirect_stderr(log):
+            sid_mfg = _build_mfg(job)
+            encoded: Optional[bytes] = None
+            for ext in _ctx.formats:
+                if ext in ("bin", "hex") and encoded is None:
+                    out_bin = SidMfgOutBin("", _config)
+                    out_bin.write(sid_mfg)
+                    encoded = bytes(out_bin.get_output_bin())
+
+                if ext == "bin":
+                    data = encoded
+                elif ext == "hex":
+                    data = _encode_hex(encoded, _ctx.chip)
+                elif ext == "nvm3":
+                    out_nvm3 = SidMfgOutNVM3("", _config)
+                    out_nvm3.write(sid_mfg)
+                    data = "\n".join(out_nvm3.get_output_nvm3()).encode()
+                elif ext == "s37":
+                    data = _run_commander_set(job)
+                else:
+                    raise ValueError(f"Unsupported output format {ext}")
+                result.outputs.append(_write_output(job, ext, data))
+    except (Exception, SystemExit) as ex:
+        result.error = f"{type(ex).__name__}: {ex}" if str(ex) else type(ex).__name__
+        _remove_outputs(job, result)
+    result.log = log.getvalue()
+    return result
+
+
+def _create_init_file(ctx: BatchContext) -> str:
+    """Commander init file is the same for every device of a chip, create it only once"""
+    init_file = str(Path(ctx.output_dir) / f"initfile_{ctx.chip.name}.s37")
+    gen_init_args = [
+        f"{ctx.commander}",
+        "nvm3",
+        "initfile",
+        "--address",
+        f"{ctx.chip.offset_addr}",
+        "--size",
+        "0x6000",
+        "--device",
+        f"{ctx.chip.full_name}",
+        "--outfile",
+        f"{init_file}",
+    ]
+    result = subprocess.run(args=gen_init_args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    print_subprocess_results(result, " ".join(gen_init_args))
+    return init_file
+
+
+def _index_record(result: BatchResult) -> Dict[str, Any]:
+    record: Dict[str, Any] = {"index": result.index, "name": result.name}
+    if result.ok:
+        record["status"] = "ok"
+        record["files"] = {_.ext: {"file": _.file, "sha256": _.sha256, "size": _.size} for _ in result.outputs}
+    else:
+        record["status"] = "error"
+        record["error"] = result.error
+    return record
+
+
+def _read_done(ctx: BatchContext, index_file: str) -> List[Dict[str, Any]]:
+    """
+    Returns the index records of the devices whose images are all on disk
+    with the recorded size. Failed devices and devices with missing images
+    are generated again.
+    """
+    done: Dict[str, Dict[str, Any]] = {}
+    try:
+        with open(index_file, "r") as index:
+            lines = index.readlines()
+    except FileNotFoundError:
+        return []
+
+    for line in lines:
+        try:
+            record = json.loads(line)
+        except json.JSONDecodeError:
+            # The last line is cut when the previous run was killed while writing it
+            continue
+        files = record.get("files", {})
+        if record.get("status") != "ok" or not all(_ in files for _ in ctx.formats):
+            continue
+        if all(
+            (Path(ctx.output_dir) / files[_]["file"]).is_file()
+            and (Path(ctx.output_dir) / files[_]["file"]).stat().st_size == files[_]["size"]
+            for _ in ctx.formats
+        ):
+            done[record["name"]] = record
+    return list(done.values())
+
+
+def run_batch(
+    ctx: BatchContext,
+    jobs: Iterable[BatchJob],
+    workers: int,
+    chunksize: int = DEFAULT_CHUNKSIZE,
+    index_file: Optional[str] = None,
+    verbose: bool = False,
+    resume: bool = False,
+) -> BatchSummary:
+    """
+    Generates the images of all jobs and writes one line per device to the
+    index file as soon as its images are written. With resume the devices
+    the index already records as generated are skipped, so an interrupted
+    lot can be continued.
+    """
+    Path(ctx.output_dir).mkdir(parents=True, exist_ok=True)
+    summary = BatchSummary(index_file=index_file or str(Path(ctx.output_dir) / DEFAULT_INDEX_FILE))
+
+    done = _read_done(ctx, summary.index_file) if resume else []
+    if done:
+        done_names = {_["name"] for _ in done}
+
+        def pending(jobs: Iterable[BatchJob]) -> Iterator[BatchJob]:
+            for job in jobs:
+                if job.name in done_names:
+                    summary.skipped += 1
+                else:
+                    yield job
+
+        jobs = pending(jobs)
+
+    if "s37" in ctx.formats:
+        if "nvm3" not in ctx.formats or ctx.formats.index("nvm3") > ctx.formats.index("s37"):
+            raise ValueError("s37 output requires nvm3 output to be generated first")
+        ctx = dataclasses.replace(ctx, init_file=_create_init_file(ctx))
+
+    start = time.perf_counter()
+    with open(summary.index_file, "w") as index:
+        # Records of skipped devices are kept, failed devices get a new one
+        for record in done:
+            index.write(json.dumps(record) + "\n")
+        index.flush()
+
+        def consume(results: Iterable[BatchResult]) -> None:
+            for result in results:
+                summary.total += 1
+                if not result.ok:
+                    summary.failed += 1
+                    print(f"[{result.index}] {result.name} failed: {result.error}", file=sys.stderr)
+                    if verbose and result.log:
+                        print(result.log, file=sys.stderr)
+                elif verbose:
+                    print(f"[{result.index}] Generated {', '.join(_.file for _ in result.outputs)}")
+                index.write(json.dumps(_index_record(result)) + "\n")
+                index.flush()
+
+        try:
+            if workers <= 1:
+                _init_worker(ctx)
+                consume(_generate(_) for _ in jobs)
+            else:
+                with multiprocessing.Pool(processes=workers, initializer=_init_worker, initargs=(ctx,)) as pool:
+                    consume(pool.imap_unordered(_generate, jobs, chunksize=chunksize))
+        finally:
+            summary.elapsed = time.perf_counter() - start
+            if ctx.init_file:
+                try:
+                    os.remove(ctx.init_file)
+                except OSError:
+                    pass
+
+    return summary
+
+
+def create_context(
+    platform_name: str,
+    input_type: str,
+    output_dir: str,
+    formats: Optional[List[str]] = None,
+    config: Optional[dict] = None,
+    chip_name: Optional[str] = None,
+    addr: Optional[int] = None,
+    device_profile_json: Optional[str] = None,
+    app_srv_pub: Optional[bytes] = None,
+    commander: str = "",
+) -> BatchContext:
+    platform = get_platform(platform_name)
+    platform_formats = get_platform_formats(platform)
+    formats = formats or platform_formats
+    for _ in formats:
+        if _ not in platform_formats:
+            raise ValueError(f"Output format {_} unsupported on {platform_name}, choose from {platform_formats}")
+
+    if config is None:
+        config = valid_yaml_file(get_default_config_file(platform, None, None))
+
+    chip = SidChipAddr(name="None", offset_addr=0)
+    if platform.chips:
+        chip = platform.get_chip_from_name(chip_name or get_default_platform_chip(platform, None, None))
+        if chip is None:
+            raise ValueError(f"Specified chip {chip_name} unsupported!")
+        # Copy, the chip table of the platform is shared by all lots
+        chip = dataclasses.replace(chip, offset_addr=addr if addr else chip.offset_addr)
+
+    if "s37" in formats and not commander:
+        raise ValueError("Simplicity Commander not found, use --commander-bin")
+
+    return BatchContext(
+        platform=platform_name,
+        input_type=input_type,
+        chip=chip,
+        formats=list(formats),
+        output_dir=output_dir,
+        config=config or {},
+        device_profile_json=device_profile_json,
+        app_srv_pub=app_srv_pub,
+        commander=commander,
+    )
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(
+        description="""Generate the mfg pages of a whole lot of devices listed in a manifest""",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument("platform", choices=[_.platform.str_name for _ in ARG_GROUPS], help="Target platform")
+    parser.add_argument("input", choices=INPUT_TYPES, help="Input type of the device json files")
+    parser.add_argument(
+        "--manifest",
+        required=True,
+        help=f"csv (with header) or jsonl manifest, columns: name, {', '.join(MANIFEST_FILE_COLUMNS)}, app_srv_pub",
+    )
+    parser.add_argument("--output_dir", default="mfg_out", help="Directory the images are written to")
+    parser.add_argument("--index", default=None, help=f"Checksum index file (default: OUTPUT_DIR/{DEFAULT_INDEX_FILE})")
+    parser.add_argument("--formats", nargs="+", default=None, help="Output formats (default: all of the platform)")
+    parser.add_argument(
+        "--config", type=valid_yaml_file, default=None, help="Config Yaml that defines the mfg page offsets"
+    )
+    parser.add_argument("--chip", default=None, help="Which chip to generate the mfg page")
+    parser.add_argument("--addr", type=auto_int, default=None, help="Override of the chip mfg page address")
+    parser.add_argument("--commander-bin", default=None, help="Simplicity Commander tool binary path")
+    parser.add_argument(
+        "--device_profile_json", default=None, help="Device profile used for aws rows without a device_profile_json"
+    )
+    parser.add_argument("--app_srv_pub", type=is_file_or_hex, default=None, help="App server public key for acs rows")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="Number of worker processes")
+    parser.add_argument("--chunksize", type=int, default=DEFAULT_CHUNKSIZE, help="Devices handed to a worker at once")
+    parser.add_argument("--verbose", action="store_true", help="Print every generated device")
+    parser.add_argument(
+        "--resume", action="store_true", help="Skip the devices the index already records as generated"
+    )
+    args = parser.parse_args()
+
+    try:
+        platform = get_platform(args.platform)
+        commander = args.commander_bin
+        if commander is None and "s37" in (args.formats or get_platform_formats(platform)):
+            commander = valid_path_to_commander(platform, None, None)
+        ctx = create_context(
+            platform_name=args.platform,
+            input_type=args.input,
+            output_dir=args.output_dir,
+            formats=args.formats,
+            config=args.config,
+            chip_name=args.chip,
+            addr=args.addr,
+            device_profile_json=args.device_profile_json,
+            app_srv_pub=args.app_srv_pub,
+            commander=commander or "",
+        )
+        print(f"Using chip config [{ctx.chip.help_str}], outputs {ctx.formats}, {args.jobs} workers")
+        summary = run_batch(
+            ctx,
+            read_manifest(args.manifest),
+            workers=args.jobs,
+            chunksize=args.chunksize,
+            index_file=args.index,
+            verbose=args.verbose,
+            resume=args.resume,
+        )
+    except (ValueError, OSError, AssertionError, binascii.Error) as ex:
+        print(f"Batch failed: {ex}")
+        sys.exit(1)
+
+    print(
+        f"Generated {summary.generated}/{summary.total} devices in {summary.elapsed:.2f}s "
+        f"({summary.images_per_second:.1f} images/s), index {summary.index_file}"
+    )
+    if summary.skipped:
+        print(f"Skipped {summary.skipped} devices already generated")
+    if summary.failed:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -863,7 +863,8 @@ class SidMfgAwsJson(SidMfg):
 
     def _get_apid_from_aws_device_profile_json(self, _aws_device_profile_json):
         def _get_device_type_id_from_dak(_aws_device_profile_json):
-            search_dak = _aws_device_profile_json.Sidewalk.get("DakCertificateMetadata", [])
+            # Do not extend the profile lists in place, the profile can be shared by many devices
+            search_dak = list(_aws_device_profile_json.Sidewalk.get("DakCertificateMetadata", []))
             search_dak += _aws_device_profile_json.Sidewalk.get("DAKCertificate", [])
             for _ in search_dak:
                 _device_type_id = _.get("DeviceTypeId", None)
@@ -0,0 +1,342 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: MIT-0
+#
+
+import binascii
+import contextlib
+import hashlib
+import io
+import json
+import os
+import tempfile
+import unittest
+
+from intelhex import IntelHex
+
+from sid_provision import batch
+from sid_provision.run import SidMfgValueId
+
+NORDIC_PAGE_ADDR = 0xFD000
+
+
+def make_config():
+    """Packs every mfg value back to back, offsets are in 4 byte words"""
+    offsets = dict()
+    word = 0
+    for value_id in SidMfgValueId:
+        if value_id.size is None:
+            continue
+        words = (value_id.size + 3) // 4
+        offsets[value_id.name] = {"start": word, "end": word + words}
+        word += words
+    return {"offset_size": 4, "mfg_page_size": word + 1, "mfg_offsets": offsets}
+
+
+def make_value(seed, size):
+    return bytes((seed + i) & 0xFF for i in range(size))
+
+
+def make_bb_json(seed):
+    """BB json whose values all derive from seed, returns it with the expected mfg values"""
+    expected = dict()
+
+    def value(value_id, offset):
+        data = make_value(seed + offset, value_id.size)
+        expected[value_id] = data
+        return binascii.hexlify(data).decode()
+
+    def cert(name, offset, ids):
+        fields = [
+            "ed25519_pub",
+            "ed25519_signature",
+            "ed25519_serial",
+            "p256r1_pub",
+            "p256r1_signature",
+            "p256r1_serial",
+        ]
+        entry = {"cert_name": name}
+        for field, value_id in zip(fields, ids):
+            if value_id is not None:
+                entry[field] = value(value_id, offset)
+                offset += 1
+        return entry
+
+    v = SidMfgValueId
+    bb_json = {
+        "ringNetDevId": value(v.SID_PAL_MFG_STORE_DEVID, 0),
+        "PKI": {
+            "device_cert": {
+                "ed25519_priv": value(v.SID_PAL_MFG_STORE_DEVICE_PRIV_ED25519, 1),
+                "ed25519_pub": value(v.SID_PAL_MFG_STORE_DEVICE_PUB_ED25519, 2),
+                "ed25519_signature": value(v.SID_PAL_MFG_STORE_DEVICE_PUB_ED25519_SIGNATURE, 3),
+                "p256r1_priv": value(v.SID_PAL_MFG_STORE_DEVICE_PRIV_P256R1, 4),
+                "p256r1_pub": value(v.SID_PAL_MFG_STORE_DEVICE_PUB_P256R1, 5),
+                "p256r1_signature": value(v.SID_PAL_MFG_STORE_DEVICE_PUB_P256R1_SIGNATURE, 6),
+            },
+            "intermediate_certs": [
+                cert(
+                    "AMZN", 10, [v.SID_PAL_MFG_STORE_AMZN_PUB_ED25519, None, None, v.SID_PAL_MFG_STORE_AMZN_PUB_P256R1]
+                ),
+                cert(
+                    "MAN",
+                    20,
+                    [
+                        v.SID_PAL_MFG_STORE_MAN_PUB_ED25519,
+                        v.SID_PAL_MFG_STORE_MAN_PUB_ED25519_SIGNATURE,
+                        v.SID_PAL_MFG_STORE_MAN_ED25519_SERIAL,
+                        v.SID_PAL_MFG_STORE_MAN_PUB_P256R1,
+                        v.SID_PAL_MFG_STORE_MAN_PUB_P256R1_SIGNATURE,
+                        v.SID_PAL_MFG_STORE_MAN_P256R1_SERIAL,
+                    ],
+                ),
+                cert(
+                    "MODEL",
+                    30,
+                    [
+                        v.SID_PAL_MFG_STORE_PRODUCT_PUB_ED25519,
+                        v.SID_PAL_MFG_STORE_PRODUCT_PUB_ED25519_SIGNATURE,
+                        v.SID_PAL_MFG_STORE_PRODUCT_ED25519_SERIAL,
+                        v.SID_PAL_MFG_STORE_PRODUCT_PUB_P256R1,
+                        v.SID_PAL_MFG_STORE_PRODUCT_PUB_P256R1_SIGNATURE,
+                        v.SID_PAL_MFG_STORE_PRODUCT_P256R1_SERIAL,
+                    ],
+                ),
+            ],
+        },
+    }
+    expected[v.SID_PAL_MFG_STORE_MAGIC] = b"SID0"
+    expected[v.SID_PAL_MFG_STORE_VERSION] = (7).to_bytes(4, "big")
+    return bb_json, expected
+
+
+def decode_nvm3(text):
+    objs = dict()
+    for line in text.splitlines():
+        key, kind, data = line.split(":")
+        assert kind == "OBJ", line
+        objs[int(key, 16)] = binascii.unhexlify(data)
+    return objs
+
+
+def decode_bin(data, config):
+    word = config["offset_size"]
+    values = dict()
+    for value_id in SidMfgValueId:
+        info = config["mfg_offsets"].get(value_id.name)
+        if info is None:
+            continue
+        raw = data[info["start"] * word : info["end"] * word]
+        if raw != b"\xff" * len(raw):
+            values[value_id] = raw[: value_id.size]
+    return values
+
+
+class TestBatch(unittest.TestCase):
+    def setUp(self):
+        self._tmp = tempfile.TemporaryDirectory()
+        self.dir = self._tmp.name
+        self.out_dir = os.path.join(self.dir, "out")
+
+    def tearDown(self):
+        self._tmp.cleanup()
+
+    def write_json(self, name, data):
+        with open(os.path.join(self.dir, name), "w") as f:
+            json.dump(data, f)
+        return name
+
+    def write_manifest(self, name, lines):
+        path = os.path.join(self.dir, name)
+        with open(path, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        return path
+
+    def make_lot(self, count):
+        """Writes count BB devices and a jsonl manifest, returns it with the expected values per name"""
+        lines = list()
+        expected = dict()
+        for i in range(count):
+            bb_json, values = make_bb_json(i * 7)
+            name = f"dev{i}"
+            lines.append(json.dumps({"name": name, "json": self.write_json(f"{name}.json", bb_json)}))
+            expected[name] = values
+        return self.write_manifest("lot.jsonl", lines), expected
+
+    def run_batch(self, ctx, manifest, workers=1, **kwargs):
+        # Failed devices are reported on stderr
+        with open(os.devnull, "w") as devnull, contextlib.redirect_stderr(devnull):
+            return batch.run_batch(ctx, batch.read_manifest(manifest), workers=workers, **kwargs)
+
+    def read_index(self, summary):
+        with open(summary.index_file) as f:
+            return [json.loads(_) for _ in f]
+
+    def read_output(self, name):
+        with open(os.path.join(self.out_dir, name), "rb") as f:
+            return f.read()
+
+    def test_nvm3_round_trip(self):
+        manifest, expected = self.make_lot(3)
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3"])
+        summary = self.run_batch(ctx, manifest)
+
+        self.assertEqual((summary.total, summary.failed), (3, 0))
+        for name, values in expected.items():
+            objs = decode_nvm3(self.read_output(f"{name}.nvm3").decode())
+            # The magic is only part of the flat images
+            del values[SidMfgValueId.SID_PAL_MFG_STORE_MAGIC]
+            self.assertEqual(objs, {_.value: data for _, data in values.items()})
+
+    def test_bin_and_hex_round_trip(self):
+        config = make_config()
+        manifest, expected = self.make_lot(2)
+        ctx = batch.create_context("nordic", "bb", self.out_dir, formats=["bin", "hex"], config=config)
+        summary = self.run_batch(ctx, manifest)
+
+        self.assertEqual((summary.total, summary.failed), (2, 0))
+        for name, values in expected.items():
+            image = self.read_output(f"{name}.bin")
+            self.assertEqual(len(image), config["mfg_page_size"] * config["offset_size"])
+            self.assertEqual(decode_bin(image, config), values)
+
+            hex_image = IntelHex(io.StringIO(self.read_output(f"{name}.hex").decode()))
+            self.assertEqual(hex_image.minaddr(), NORDIC_PAGE_ADDR)
+            self.assertEqual(hex_image.tobinstr(), image)
+
+    def test_index_checksums(self):
+        manifest, _ = self.make_lot(2)
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3"])
+        summary = self.run_batch(ctx, manifest)
+
+        records = self.read_index(summary)
+        self.assertEqual(sorted(_["name"] for _ in records), ["dev0", "dev1"])
+        for record in records:
+            self.assertEqual(record["status"], "ok")
+            out = record["files"]["nvm3"]
+            data = self.read_output(out["file"])
+            self.assertEqual(out["size"], len(data))
+            self.assertEqual(out["sha256"], hashlib.sha256(data).hexdigest())
+
+    def test_worker_pool_matches_single_process(self):
+        manifest, _ = self.make_lot(4)
+        single_dir = os.path.join(self.dir, "single")
+        ctx = batch.create_context("silabs", "bb", single_dir, formats=["nvm3"])
+        self.run_batch(ctx, manifest)
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3"])
+        summary = self.run_batch(ctx, manifest, workers=2, chunksize=1)
+
+        self.assertEqual((summary.total, summary.failed), (4, 0))
+        for i in range(4):
+            with open(os.path.join(single_dir, f"dev{i}.nvm3"), "rb") as f:
+                self.assertEqual(self.read_output(f"dev{i}.nvm3"), f.read())
+
+    def test_failed_device_does_not_stop_lot(self):
+        bb_json, _ = make_bb_json(0)
+        bb_json["ringNetDevId"] = "not hex"
+        manifest, _ = self.make_lot(2)
+        with open(manifest, "a") as f:
+            f.write(json.dumps({"name": "bad", "json": self.write_json("bad.json", bb_json)}) + "\n")
+            f.write(json.dumps({"name": "no_json"}) + "\n")
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3"])
+        summary = self.run_batch(ctx, manifest)
+
+        self.assertEqual((summary.total, summary.failed, summary.generated), (4, 2, 2))
+        records = {_["name"]: _ for _ in self.read_index(summary)}
+        self.assertEqual(records["bad"]["status"], "error")
+        self.assertTrue(records["bad"]["error"].startswith("Error: "))
+        self.assertEqual(records["no_json"]["error"], "ValueError: Missing json column")
+        # Neither a partial image nor a temporary file is left behind
+        self.assertEqual(sorted(os.listdir(self.out_dir)), ["dev0.nvm3", "dev1.nvm3", "index.jsonl"])
+
+    def test_failed_format_removes_device_images(self):
+        manifest, _ = self.make_lot(1)
+        # A commander that does nothing lets the nvm3 image through but never writes the s37 one
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3", "s37"], commander="true")
+        summary = self.run_batch(ctx, manifest)
+
+        self.assertEqual((summary.total, summary.failed), (1, 1))
+        self.assertEqual(self.read_index(summary)[0]["status"], "error")
+        self.assertEqual(os.listdir(self.out_dir), ["index.jsonl"])
+
+    def test_resume_skips_generated_devices(self):
+        manifest, _ = self.make_lot(3)
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3"])
+        summary = self.run_batch(ctx, manifest)
+        first = {_["name"]: _ for _ in self.read_index(summary)}
+        # dev1 lost its image, dev2 was interrupted while its index line was written
+        os.remove(os.path.join(self.out_dir, "dev1.nvm3"))
+        with open(summary.index_file, "w") as f:
+            f.write(json.dumps(first["dev0"]) + "\n" + json.dumps(first["dev1"]) + "\n" + '{"index": 2, "na')
+        dev0_mtime = os.stat(os.path.join(self.out_dir, "dev0.nvm3")).st_mtime_ns
+
+        summary = self.run_batch(ctx, manifest, resume=True)
+
+        self.assertEqual((summary.total, summary.failed, summary.skipped), (2, 0, 1))
+        self.assertEqual(os.stat(os.path.join(self.out_dir, "dev0.nvm3")).st_mtime_ns, dev0_mtime)
+        records = {_["name"]: _ for _ in self.read_index(summary)}
+        self.assertEqual(records, first)
+
+    def test_without_resume_index_is_rewritten(self):
+        manifest, _ = self.make_lot(2)
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3"])
+        self.run_batch(ctx, manifest)
+        summary = self.run_batch(ctx, manifest)
+
+        self.assertEqual((summary.total, summary.skipped), (2, 0))
+        self.assertEqual(len(self.read_index(summary)), 2)
+
+    def test_acs_without_app_srv_pub(self):
+        manifest = self.write_manifest("lot.csv", ["name,json", "dev0," + self.write_json("dev0.json", {})])
+        ctx = batch.create_context("silabs", "acs", self.out_dir, formats=["nvm3"])
+        summary = self.run_batch(ctx, manifest)
+
+        self.assertEqual(summary.failed, 1)
+        self.assertEqual(self.read_index(summary)[0]["error"], "ValueError: Missing app_srv_pub")
+
+    def test_aws_without_device_files(self):
+        manifest = self.write_manifest(
+            "lot.csv", ["name,wireless_device_json", "dev0," + self.write_json("dev0.json", {})]
+        )
+        ctx = batch.create_context("silabs", "aws", self.out_dir, formats=["nvm3"])
+        summary = self.run_batch(ctx, manifest)
+
+        self.assertEqual(summary.failed, 1)
+        self.assertIn("certificate_json", self.read_index(summary)[0]["error"])
+
+    def test_manifest_names(self):
+        manifest = self.write_manifest("lot.csv", ["name,json,device_profile_json", ",a/first.json,", ",,profile.json"])
+        jobs = list(batch.read_manifest(manifest))
+
+        self.assertEqual([_.name for _ in jobs], ["first", "device_000001"])
+        self.assertEqual(jobs[0].files["json"], os.path.join(self.dir, "a", "first.json"))
+
+    def test_manifest_duplicate_name(self):
+        manifest = self.write_manifest("lot.csv", ["name,json", "dev,a.json", "dev,b.json"])
+        with self.assertRaisesRegex(ValueError, "Duplicate output name dev"):
+            list(batch.read_manifest(manifest))
+
+    def test_manifest_invalid_json_line(self):
+        manifest = self.write_manifest("lot.jsonl", [json.dumps({"json": "a.json"}), "", "{not json"])
+        with self.assertRaisesRegex(ValueError, "lot.jsonl:3: invalid json line"):
+            list(batch.read_manifest(manifest))
+
+    def test_context_errors(self):
+        with self.assertRaisesRegex(ValueError, "Platform none unsupported"):
+            batch.create_context("none", "bb", self.out_dir)
+        with self.assertRaisesRegex(ValueError, "Output format bin unsupported"):
+            batch.create_context("silabs", "bb", self.out_dir, formats=["bin"])
+        with self.assertRaisesRegex(ValueError, "Simplicity Commander not found"):
+            batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3", "s37"])
+        with self.assertRaisesRegex(ValueError, "Specified chip xg99 unsupported"):
+            batch.create_context("silabs", "bb", self.out_dir, formats=["nvm3"], chip_name="xg99")
+
+    def test_s37_requires_nvm3_first(self):
+        ctx = batch.create_context("silabs", "bb", self.out_dir, formats=["s37", "nvm3"], commander="commander")
+        with self.assertRaisesRegex(ValueError, "s37 output requires nvm3"):
+            batch.run_batch(ctx, [], workers=1)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,96 @@
+# !/usr/bin/env python3
+
+import json
+import queue
+import threading
+import time
+from .stage_timer import StageTimer
+
+RESULT_STATUS_OK = "ok"
+RESULT_STATUS_FAILED = "failed"
+
+class Orchestrator:
+  """Provisions devices concurrently, one worker per J-Link probe.
+
+  Jobs are taken in order by whichever probe is free. provision_fn is called
+  as provision_fn(jlink_ser, job, stage_timer) and raises on failure. A failed
+  device is reported and its probe moves on to the next job."""
+
+  def __init__(self, logger, jlink_sers, provision_fn):
+    if not jlink_sers:
+      raise ValueError("at least one J-Link serial number is required")
+    if len(set(jlink_sers)) != len(jlink_sers):
+      raise ValueError("J-Link serial numbers are not unique")
+    self._logger = logger
+    self._jlink_sers = list(jlink_sers)
+    self._provision_fn = provision_fn
+
+  def run(self, jobs):
+    """Returns one result per job, in job order"""
+    pending = queue.Queue()
+    for idx, job in enumerate(jobs):
+      pending.put((idx, job))
+    results = [None] * len(jobs)
+    workers = [threading.Thread(target=self._worker, args=(jlink_ser, pending, results), name=str(jlink_ser))
+               for jlink_ser in self._jlink_sers]
+    for w in workers:
+      w.start()
+    for w in workers:
+      w.join()
+    return results
+
+  def _worker(self, jlink_ser, pending, results):
+    while True:
+      try:
+        idx, job = pending.get_nowait()
+      except queue.Empty:
+        return
+      timer = StageTimer()
+      result = {
+        "job": idx,
+        "device": job_name(job),
+        "jlink_ser": jlink_ser,
+        "status": RESULT_STATUS_OK,
+        "error": None,
+      }
+      self._logger.info("Provisioning {0} with J-Link {1}".format(result["device"], jlink_ser))
+      start = time.monotonic()
+      try:
+        self._provision_fn(jlink_ser, job, timer)
+      except (Exception, SystemExit) as e:
+        # the signing path exits on error, keep the other probes running
+        result["status"] = RESULT_STATUS_FAILED
+        result["error"] = "{0}: {1}".format(type(e).__name__, e)
+        self._logger.error("Provisioning {0} failed: {1}".format(result["device"], result["error"]))
+      result["duration"] = time.monotonic() - start
+      result["stages"] = dict(timer.stages)
+      results[idx] = result
+
+def job_name(job):
+  if isinstance(job, dict):
+    for key in ("dsn", "sid_cert"):
+      if job.get(key):
+        return str(job[key])
+  return str(job)
+
+def build_report(results, wall_time):
+  stages = dict()
+  for r in results:
+    for name, duration in r["stages"].items():
+      stages.setdefault(name, []).append(duration)
+  nb_ok = sum(1 for r in results if r["status"] == RESULT_STATUS_OK)
+  return {
+    "summary": {
+      "devices": len(results),
+      "ok": nb_ok,
+      "failed": len(results) - nb_ok,
+      "wall_time": wall_time,
+      "devices_per_hour": (nb_ok * 3600.0 / wall_time) if wall_time > 0 else 0.0,
+      "stages": {name: {"mean": sum(d) / len(d), "max": max(d), "total": sum(d)} for name, d in stages.items()},
+    },
+    "devices": results,
+  }
+
+def write_report(report, filename):
+  with open(filename, "w") as f:
+    json.dump(report, f, indent=2)
@@ -1,21 +1,28 @@
 # !/usr/bin/env python3
 
 import binascii
+import time
 from enum import Enum
 from .serial_wire import *
 from .pdp_api import *
 
+# time the device has to answer a batch
+PDP_BATCH_RSP_TIMEOUT = 10.0
+# a failed status without data following within this time is the whole response
+PDP_STATUS_ONLY_WAIT = 0.5
+
 class PDPMode(str, Enum):
   PRIV_KEY_PROV = 'priv_key_prov'
   ON_DEV_CERT_GEN = 'on_dev_cert_gen'
 
 class PDP:
-  def __init__(self, logger, jlink_dev, jlink_ser, soc_ram_st_addr, soc_stack_size, pdp_img):
+  def __init__(self, logger, jlink_dev, jlink_ser, soc_ram_st_addr, soc_stack_size, pdp_img, sw=None):
     self._logger = logger
     self._soc_ram_st_addr = soc_ram_st_addr
     self._soc_stack_st_addr = self._soc_ram_st_addr + soc_stack_size
     self._pdp_img = pdp_img
-    self._sw = SerialWire(jlink_dev, jlink_ser)
+    # the serial wire transport can be replaced, ie: by a mock for testing
+    self._sw = sw if sw else SerialWire(jlink_dev, jlink_ser)
 
   def comm_open(self, start_rtt=False):
     self._logger.info("Opening serial wire connection (start_rtt: {0})".format(start_rtt))
@@ -45,12 +52,67 @@ class PDP:
       return None
     return rx_pkt[PROTOCOL_DATA_START_IDX:]
 
+  def comm_send_receive_batch(self, cmds):
+    """Sends commands in as few packets as the device buffers allow.
+    Returns the response data of each command, None if one of them failed"""
+    rsp_plds = list()
+    for batch in split_batches(cmds):
+      tx_pkt = Batch(batch).serialize()
+      self._logger.debug("tx batch of {0}: {1}".format(len(batch), binascii.hexlify(tx_pkt)))
+      if not self._check_tx(tx_pkt):
+        return None
+      self._sw.rtt_send(tx_pkt)
+      rx_pkt = self._receive_batch()
+      if rx_pkt is None:
+        self._logger.error("Batch response timeout")
+        return None
+      self._logger.debug("rx: {0}".format(binascii.hexlify(bytes(rx_pkt))))
+      if len(rx_pkt) == PROTOCOL_DATA_START_IDX:
+        # the device rejected the batch before running any command
+        status = int.from_bytes(rx_pkt[PROTOCOL_STATUS_RANGE], BYTE_ORDER_LE)
+        self._logger.error("Batch failed with status: {0}".format(status))
+        return None
+      entries = parse_batch_rsp(rx_pkt[PROTOCOL_DATA_START_IDX:])
+      for idx, (status, data) in enumerate(entries):
+        if status != PROTOCOL_STATUS_NO_ERR:
+          int_err = int.from_bytes(data[:PROTOCOL_RSP_INT_ERR_LEN], BYTE_ORDER_LE) if len(data) >= PROTOCOL_RSP_INT_ERR_LEN else PROTOCOL_STATUS_NO_ERR
+          self._logger.error("Command {0} failed with status: {1} (internal_error: {2})".format(batch[idx].cmd, status, int_err))
+          return None
+        rsp_plds.append(data)
+      status = int.from_bytes(rx_pkt[PROTOCOL_STATUS_RANGE], BYTE_ORDER_LE)
+      if status != PROTOCOL_STATUS_NO_ERR or len(entries) != len(batch):
+        self._logger.error("Batch failed with status: {0} after {1}/{2} commands".format(status, len(entries), len(batch)))
+        return None
+      self._logger.info("Status: OK({0}) for {1} commands".format(status, len(batch)))
+    return rsp_plds
+
   def burn_ram_img(self):
     self._logger.info("Burning PDP application image at {0} (size: {1} bytes)".format(hex(self._soc_ram_st_addr), len(self._pdp_img)))
     reset_ok, written = self._sw.burn_ram_img(self._soc_ram_st_addr, self._soc_stack_st_addr, self._pdp_img)
     if reset_ok:
       self._logger.debug("{0} bytes written".format(written))
 
+  def _receive_batch(self):
+    # status and entries are written separately, read until the announced length arrived.
+    # A batch rejected before it ran only gets the status, None if nothing complete arrives in time
+    deadline = time.monotonic() + PDP_BATCH_RSP_TIMEOUT
+    rx_pkt = bytes()
+    while True:
+      status_only = len(rx_pkt) == PROTOCOL_DATA_START_IDX and\
+                    int.from_bytes(rx_pkt[PROTOCOL_STATUS_RANGE], BYTE_ORDER_LE) != PROTOCOL_STATUS_NO_ERR
+      remaining = deadline - time.monotonic()
+      if remaining <= 0:
+        return rx_pkt if status_only else None
+      rx = bytes(self._sw.rtt_receive(timeout=min(remaining, PDP_STATUS_ONLY_WAIT) if status_only else remaining))
+      if not rx:
+        if status_only:
+          return rx_pkt
+        continue
+      rx_pkt += rx
+      rsp_len = batch_rsp_len(rx_pkt[PROTOCOL_DATA_START_IDX:])
+      if rsp_len is not None and len(rx_pkt) >= PROTOCOL_DATA_START_IDX + rsp_len:
+        return rx_pkt
+
   def _check_tx(self, tx_pkt):
     if len(tx_pkt) >= SERIAL_WIRE_TX_BUF_SIZE:
       self._logger.error('tx packet too big {0}'.format(SERIAL_WIRE_TX_BUF_SIZE))
@@ -28,6 +28,26 @@ PROTOCOL_DATA_CSR_VALUE_START_IDX = 4
 # protocol error status
 PROTOCOL_STATUS_NO_ERR = 0
 
+# PDP application buffer sizes (SL_SID_PDP_RX_BUF_SIZE and SL_SID_PDP_TX_BUF_SIZE)
+PROTOCOL_DEV_RX_BUF_SIZE = 896
+PROTOCOL_DEV_TX_BUF_SIZE = 512
+
+# request header: 2-byte command and 2-byte data length
+PROTOCOL_REQ_HDR_LEN = 4
+
+# batch response data: 2-byte length of the entries, then per processed command
+# 4-byte status, 2-byte data length and data
+PROTOCOL_BATCH_RSP_LEN_RANGE = slice(0, 2)
+PROTOCOL_BATCH_RSP_HDR_LEN = 2
+PROTOCOL_BATCH_RSP_ENTRY_STATUS_LEN = 4
+PROTOCOL_BATCH_RSP_ENTRY_LEN_LEN = 2
+PROTOCOL_BATCH_RSP_ENTRY_HDR_LEN = PROTOCOL_BATCH_RSP_ENTRY_STATUS_LEN + PROTOCOL_BATCH_RSP_ENTRY_LEN_LEN
+
+# largest response data of a command, an internal error is a 4-byte sid_error_t
+PROTOCOL_RSP_INT_ERR_LEN = 4
+PROTOCOL_SMSN_SIZE = 32
+PROTOCOL_CSR_MAX_SIZE = 160
+
 # used in on-device certificate generation
 class CryptoCurve(int, Enum):
   ED25519 = 1
@@ -44,8 +64,12 @@ class CommandList:
   ON_DEV_CERT_GEN_WRITE_CERT_CHAIN = 5
   ON_DEV_CERT_GEN_WRITE_APP_SRV_PUB_KEY = 6
   ON_DEV_CERT_GEN_STORE = 7
+  # Several of the above commands in one packet
+  BATCH = 8
 
 class Base(object):
+  rsp_max_len = PROTOCOL_RSP_INT_ERR_LEN
+
   def serialize(self):
     p = bytearray()
     p.extend(int(self.cmd).to_bytes(2, BYTE_ORDER_LE))
@@ -81,6 +105,8 @@ class OnDevCertGen_Init(Base):
     self.body = bytearray()
 
 class OnDevCertGen_GenSMSN(Base):
+  rsp_max_len = 4 + PROTOCOL_SMSN_SIZE
+
   def __init__(self, dev_type, dsn, apid, board_id):
     self.cmd = CommandList.ON_DEV_CERT_GEN_GEN_SMSN
     self.body = bytearray()
@@ -95,6 +121,8 @@ class OnDevCertGen_GenSMSN(Base):
       self.body.extend(board_id.encode())
 
 class OnDevCertGen_GenCSR(Base):
+  rsp_max_len = 4 + PROTOCOL_CSR_MAX_SIZE
+
   def __init__(self, crypto_curve):
     self.cmd = CommandList.ON_DEV_CERT_GEN_GEN_CSR
     self.body = bytearray()
@@ -118,4 +146,61 @@ class OnDevCertGen_WriteAppSrvPubKey(Base):
 class OnDevCertGen_Store(Base):
   def __init__(self):
     self.cmd = CommandList.ON_DEV_CERT_GEN_STORE
-    self.body = bytearray()
\ No newline at end of file
+    self.body = bytearray()
+
+class Batch(Base):
+  def __init__(self, cmds):
+    self.cmd = CommandList.BATCH
+    self.body = bytearray()
+    for c in cmds:
+      self.body.extend(c.serialize())
+
+def split_batches(cmds, req_size_max=PROTOCOL_DEV_RX_BUF_SIZE, rsp_size_max=PROTOCOL_DEV_TX_BUF_SIZE):
+  """Groups commands, in order, into batches that fit the device buffers"""
+  batches = list()
+  batch = list()
+  req_len = PROTOCOL_REQ_HDR_LEN
+  rsp_len = PROTOCOL_BATCH_RSP_HDR_LEN
+  for c in cmds:
+    c_req_len = PROTOCOL_REQ_HDR_LEN + len(c.body)
+    c_rsp_len = PROTOCOL_BATCH_RSP_ENTRY_HDR_LEN + c.rsp_max_len
+    if PROTOCOL_REQ_HDR_LEN + c_req_len > req_size_max or\
+       PROTOCOL_BATCH_RSP_HDR_LEN + c_rsp_len > rsp_size_max:
+      raise ValueError("command {0} does not fit in a batch".format(c.cmd))
+    if batch and (req_len + c_req_len > req_size_max or rsp_len + c_rsp_len > rsp_size_max):
+      batches.append(batch)
+      batch = list()
+      req_len = PROTOCOL_REQ_HDR_LEN
+      rsp_len = PROTOCOL_BATCH_RSP_HDR_LEN
+    batch.append(c)
+    req_len += c_req_len
+    rsp_len += c_rsp_len
+  if batch:
+    batches.append(batch)
+  return batches
+
+def batch_rsp_len(rsp_data):
+  """Returns the length of a complete batch response data, None until the length field arrived"""
+  if len(rsp_data) < PROTOCOL_BATCH_RSP_HDR_LEN:
+    return None
+  return PROTOCOL_BATCH_RSP_HDR_LEN + int.from_bytes(rsp_data[PROTOCOL_BATCH_RSP_LEN_RANGE], BYTE_ORDER_LE)
+
+def parse_batch_rsp(rsp_data):
+  """Splits batch response data into (status, data) per processed command"""
+  entries = list()
+  end = batch_rsp_len(rsp_data)
+  if end is None or end > len(rsp_data):
+    raise ValueError("batch response truncated")
+  idx = PROTOCOL_BATCH_RSP_HDR_LEN
+  while idx < end:
+    if end - idx < PROTOCOL_BATCH_RSP_ENTRY_HDR_LEN:
+      raise ValueError("batch response entry truncated")
+    status = int.from_bytes(rsp_data[idx:idx + PROTOCOL_BATCH_RSP_ENTRY_STATUS_LEN], BYTE_ORDER_LE)
+    idx += PROTOCOL_BATCH_RSP_ENTRY_STATUS_LEN
+    data_len = int.from_bytes(rsp_data[idx:idx + PROTOCOL_BATCH_RSP_ENTRY_LEN_LEN], BYTE_ORDER_LE)
+    idx += PROTOCOL_BATCH_RSP_ENTRY_LEN_LEN
+    if end - idx < data_len:
+      raise ValueError("batch response entry truncated")
+    entries.append((status, bytes(rsp_data[idx:idx + data_len])))
+    idx += data_len
+  return entries
\ No newline at end of file
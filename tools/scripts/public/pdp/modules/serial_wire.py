@@ -1,5 +1,6 @@
 # !/usr/bin/env python3
 
+import time
 import pylink
 
 SERIAL_WIRE_TX_BUF_SIZE = 1024
@@ -38,10 +39,14 @@ class SerialWire:
       nb_sent = self.jlink.rtt_write(0, data)
     return nb_sent
 
-  def rtt_receive(self):
+  def rtt_receive(self, timeout=None):
+    """Waits for data, returns an empty buffer if none arrived within timeout seconds"""
+    deadline = None if timeout is None else time.monotonic() + timeout
     data = bytes()
     while len(data) == 0:
       data = self.jlink.rtt_read(0, SERIAL_WIRE_RX_BUF_SIZE)
+      if deadline is not None and time.monotonic() >= deadline:
+        break
     return data
 
   def close(self):
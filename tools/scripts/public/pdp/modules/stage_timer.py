@@ -0,0 +1,17 @@
+# !/usr/bin/env python3
+
+import time
+from contextlib import contextmanager
+
+class StageTimer:
+  """Accumulates wall-clock time (in seconds) per named provisioning stage"""
+  def __init__(self):
+    self.stages = dict()
+
+  @contextmanager
+  def stage(self, name):
+    start = time.monotonic()
+    try:
+      yield
+    finally:
+      self.stages[name] = self.stages.get(name, 0.0) + (time.monotonic() - start)
@@ -0,0 +1,223 @@
+# !/usr/bin/env python3
+
+import json
+import logging
+import os
+import sys
+import tempfile
+import threading
+import time
+import types
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+try:
+  import pylink
+except ImportError:
+  sys.modules["pylink"] = types.ModuleType("pylink") # the mock transport replaces it
+try:
+  import prodict
+except ImportError:
+  sys.modules["prodict"] = types.ModuleType("prodict") # only used to load certificate files
+  sys.modules["prodict"].Prodict = dict
+from modules.orchestrator import Orchestrator, build_report, write_report, RESULT_STATUS_OK, RESULT_STATUS_FAILED
+from modules.pdp import PDP
+from modules.pdp_api import *
+from modules.sid_cert import MfgObj
+from priv_key_prov import PrivKeyProv
+
+MOCK_STEP_DELAY = 0.01
+
+class MockProbes:
+  """Bookkeeping shared by the mock transports of all probes"""
+  def __init__(self):
+    self.lock = threading.Lock()
+    self.active = set()
+    self.max_active = 0
+    self.provisioned = list()
+
+class MockSerialWire:
+  """J-Link/RTT transport answering like the PDP application"""
+  def __init__(self, probes, jlink_ser, fail_cmd=None, reject_status=None):
+    self._probes = probes
+    self._jlink_ser = jlink_ser
+    self._fail_cmd = fail_cmd
+    # status of a batch rejected before it ran, only the status is sent then
+    self._reject_status = reject_status
+    self._rx = list()
+
+  def connect(self):
+    with self._probes.lock:
+      assert self._jlink_ser not in self._probes.active, "probe used by two workers"
+      self._probes.active.add(self._jlink_ser)
+      self._probes.max_active = max(self._probes.max_active, len(self._probes.active))
+
+  def close(self):
+    with self._probes.lock:
+      self._probes.active.discard(self._jlink_ser)
+
+  def reset_and_halt(self):
+    pass
+
+  def reset(self):
+    pass
+
+  def rtt_start(self):
+    pass
+
+  def rtt_stop(self):
+    pass
+
+  def burn_ram_img(self, ram_addr, stack_addr, img):
+    time.sleep(MOCK_STEP_DELAY)
+    return True, len(img)
+
+  def rtt_send(self, data):
+    time.sleep(MOCK_STEP_DELAY)
+    cmd = int.from_bytes(data[0:2], BYTE_ORDER_LE)
+    assert cmd == CommandList.BATCH
+    body = data[PROTOCOL_REQ_HDR_LEN:]
+    if self._reject_status is not None:
+      self._rx = [self._reject_status.to_bytes(4, BYTE_ORDER_LE)]
+      return len(data)
+    status = PROTOCOL_STATUS_NO_ERR
+    entries = bytearray()
+    idx = 0
+    while idx < len(body):
+      sub_cmd = int.from_bytes(body[idx:idx + 2], BYTE_ORDER_LE)
+      idx += PROTOCOL_REQ_HDR_LEN + int.from_bytes(body[idx + 2:idx + 4], BYTE_ORDER_LE)
+      sub_status = 1 if sub_cmd == self._fail_cmd else PROTOCOL_STATUS_NO_ERR
+      entries.extend(sub_status.to_bytes(4, BYTE_ORDER_LE))
+      entries.extend((0).to_bytes(2, BYTE_ORDER_LE))
+      if sub_status != PROTOCOL_STATUS_NO_ERR:
+        status = sub_status
+        break
+    rsp = status.to_bytes(4, BYTE_ORDER_LE) + len(entries).to_bytes(2, BYTE_ORDER_LE) + bytes(entries)
+    # status and data arrive in separate reads, like from the target
+    self._rx = [rsp[:PROTOCOL_DATA_START_IDX], rsp[PROTOCOL_DATA_START_IDX:]]
+    return len(data)
+
+  def rtt_receive(self, timeout=None):
+    if not self._rx:
+      # nothing more is sent, RTT reads come back empty once timeout expired
+      time.sleep(timeout)
+      return bytes()
+    return self._rx.pop(0)
+
+class MockPart:
+  def get_jlink_device(self):
+    return "EFR32MG24BxxxF1536"
+
+  def get_ram_start_addr(self):
+    return 0x20000000
+
+  def get_stack_size(self):
+    return 0x1000
+
+class FailingPDP:
+  """PDP whose batches all fail, the way comm_send_receive_batch reports it"""
+  def __init__(self):
+    self.is_open = False
+
+  def comm_open(self, start_rtt=False):
+    self.is_open = True
+
+  def comm_reset_and_halt(self):
+    pass
+
+  def comm_close(self, stop_rtt=False):
+    self.is_open = False
+
+  def burn_ram_img(self):
+    pass
+
+  def comm_send_receive_batch(self, cmds):
+    return None
+
+DYNAMIC_DATA = {
+  MfgObj.SMSN.value: "00" * 32,
+  MfgObj.DEVICE_PRIV_ED25519.value: "00" * 32,
+}
+
+def make_provision_fn(probes, fail_dsn=None):
+  logger = logging.getLogger("test")
+
+  def provision(jlink_ser, job, stage_timer):
+    fail_cmd = CommandList.PRIV_KEY_PROV_INJECT_KEY if job["dsn"] == fail_dsn else None
+    PrivKeyProv(logger, MockPart(), jlink_ser, bytes(16), sw=MockSerialWire(probes, jlink_ser, fail_cmd)).execute(
+      stage_timer=stage_timer, dynamic_data=DYNAMIC_DATA)
+    with probes.lock:
+      probes.provisioned.append(job["dsn"])
+
+  return provision
+
+class TestModule(unittest.TestCase):
+  def setUp(self):
+    logging.getLogger("test").setLevel(logging.CRITICAL)
+    self.jobs = [{"dsn": "DSN{0:02d}".format(i)} for i in range(9)]
+
+  def test_all_jobs_provisioned_once(self):
+    probes = MockProbes()
+    results = Orchestrator(logging.getLogger("test"), ["1", "2", "3"], make_provision_fn(probes)).run(self.jobs)
+    self.assertEqual(sorted(probes.provisioned), [j["dsn"] for j in self.jobs])
+    self.assertEqual([r["device"] for r in results], [j["dsn"] for j in self.jobs])
+    self.assertTrue(all(r["status"] == RESULT_STATUS_OK for r in results))
+    self.assertTrue(all(set(r["stages"]) == {"pdp_flash", "pdp_provision"} for r in results))
+
+  def test_probes_run_concurrently(self):
+    probes = MockProbes()
+    results = Orchestrator(logging.getLogger("test"), ["1", "2", "3"], make_provision_fn(probes)).run(self.jobs)
+    self.assertEqual(probes.max_active, 3)
+    self.assertEqual({r["jlink_ser"] for r in results}, {"1", "2", "3"})
+
+  def test_failure_does_not_stop_other_devices(self):
+    probes = MockProbes()
+    results = Orchestrator(logging.getLogger("test"), ["1", "2"], make_provision_fn(probes, fail_dsn="DSN04")).run(self.jobs)
+    failed = [r for r in results if r["status"] == RESULT_STATUS_FAILED]
+    self.assertEqual([r["device"] for r in failed], ["DSN04"])
+    self.assertIn("SystemError", failed[0]["error"])
+    self.assertEqual(len(probes.provisioned), len(self.jobs) - 1)
+
+  def test_failed_priv_key_batch_reported(self):
+    pdps = list()
+
+    def provision(jlink_ser, job, stage_timer):
+      prov = PrivKeyProv(logging.getLogger("test"), MockPart(), jlink_ser, bytes(16), sw=MockSerialWire(MockProbes(), jlink_ser))
+      prov._pdp = FailingPDP()
+      pdps.append(prov._pdp)
+      prov.execute(stage_timer=stage_timer, dynamic_data=DYNAMIC_DATA)
+
+    results = Orchestrator(logging.getLogger("test"), ["1"], provision).run(self.jobs[:2])
+    self.assertEqual([r["status"] for r in results], [RESULT_STATUS_FAILED] * 2)
+    self.assertIn("SystemError", results[0]["error"])
+    self.assertFalse(any(p.is_open for p in pdps))
+    self.assertEqual(build_report(results, 1.0)["summary"]["ok"], 0)
+
+  def test_status_only_response(self):
+    pdp = PDP(logging.getLogger("test"), "EFR32MG24BxxxF1536", "1", 0x20000000, 0x1000, bytes(16),
+              sw=MockSerialWire(MockProbes(), "1", reject_status=5))
+    pdp.comm_open(start_rtt=True)
+    self.assertIsNone(pdp.comm_send_receive_batch([PrivKeyProv_WriteNVM3(0x10, bytes(8))]))
+    pdp.comm_close(stop_rtt=True)
+
+  def test_duplicate_probe_rejected(self):
+    with self.assertRaises(ValueError):
+      Orchestrator(logging.getLogger("test"), ["1", "1"], make_provision_fn(MockProbes()))
+
+  def test_report(self):
+    probes = MockProbes()
+    results = Orchestrator(logging.getLogger("test"), ["1", "2"], make_provision_fn(probes, fail_dsn="DSN00")).run(self.jobs)
+    report = build_report(results, 2.0)
+    self.assertEqual(report["summary"]["devices"], 9)
+    self.assertEqual(report["summary"]["ok"], 8)
+    self.assertEqual(report["summary"]["failed"], 1)
+    self.assertEqual(report["summary"]["devices_per_hour"], 8 * 1800.0)
+    self.assertEqual(set(report["summary"]["stages"]), {"pdp_flash", "pdp_provision"})
+    with tempfile.TemporaryDirectory() as d:
+      filename = os.path.join(d, "report.json")
+      write_report(report, filename)
+      with open(filename) as f:
+        self.assertEqual(json.load(f)["summary"]["ok"], 8)
+
+if __name__ == '__main__':
+  unittest.main()
@@ -0,0 +1,54 @@
+# !/usr/bin/env python3
+
+import unittest
+from pdp_api import *
+
+def batch_rsp(entries):
+  data = bytearray()
+  for status, pld in entries:
+    data.extend(status.to_bytes(4, BYTE_ORDER_LE))
+    data.extend(len(pld).to_bytes(2, BYTE_ORDER_LE))
+    data.extend(pld)
+  return bytes(len(data).to_bytes(2, BYTE_ORDER_LE) + data)
+
+class TestModule(unittest.TestCase):
+  def test_batch_serialize(self):
+    cmds = [OnDevCertGen_Init(), OnDevCertGen_GenCSR(CryptoCurve.ED25519)]
+    pkt = Batch(cmds).serialize()
+    self.assertEqual(int.from_bytes(pkt[0:2], BYTE_ORDER_LE), CommandList.BATCH)
+    self.assertEqual(int.from_bytes(pkt[2:4], BYTE_ORDER_LE), len(pkt) - PROTOCOL_REQ_HDR_LEN)
+    self.assertEqual(pkt[4:], cmds[0].serialize() + cmds[1].serialize())
+
+  def test_split_keeps_order_and_request_limit(self):
+    cmds = [PrivKeyProv_WriteNVM3(i, bytes(100)) for i in range(20)]
+    batches = split_batches(cmds)
+    self.assertEqual([c for b in batches for c in b], cmds)
+    for b in batches:
+      self.assertLessEqual(len(Batch(b).serialize()), PROTOCOL_DEV_RX_BUF_SIZE)
+    self.assertGreater(len(batches), 1)
+
+  def test_split_response_limit(self):
+    cmds = [OnDevCertGen_Init(),
+            OnDevCertGen_GenSMSN("dev", "dsn", "apid", ""),
+            OnDevCertGen_GenCSR(CryptoCurve.ED25519),
+            OnDevCertGen_GenCSR(CryptoCurve.P256R1)]
+    self.assertEqual(len(split_batches(cmds)), 1)
+    self.assertEqual(len(split_batches(cmds * 2)), 2)
+
+  def test_split_command_too_big(self):
+    with self.assertRaises(ValueError):
+      split_batches([PrivKeyProv_WriteNVM3(0, bytes(PROTOCOL_DEV_RX_BUF_SIZE))])
+
+  def test_parse_batch_rsp(self):
+    rsp = batch_rsp([(0, b''), (0, b'\x01\x02'), (14, b'\xaa\xbb\xcc\xdd')])
+    self.assertEqual(batch_rsp_len(rsp), len(rsp))
+    self.assertEqual(parse_batch_rsp(rsp), [(0, b''), (0, b'\x01\x02'), (14, b'\xaa\xbb\xcc\xdd')])
+
+  def test_parse_batch_rsp_truncated(self):
+    rsp = batch_rsp([(0, b'\x01\x02')])
+    self.assertIsNone(batch_rsp_len(rsp[:1]))
+    with self.assertRaises(ValueError):
+      parse_batch_rsp(rsp[:-1])
+
+if __name__ == '__main__':
+  unittest.main()
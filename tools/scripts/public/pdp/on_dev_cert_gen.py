@@ -22,31 +22,41 @@ class OnDevCertGen(PDPModeBase):
     "sst_hsm_pin",
   }
 
-  def _init(self):
-    self._logger.debug("Initializing on-device certificate generation")
-    tx_pkt = OnDevCertGen_Init().serialize()
-    self._pdp.comm_send_receive(tx_pkt)
-    self._logger.debug("Done")
+  def __init__(self, logger, part, jlink_ser, pdp_img, sw=None, signer=None):
+    super().__init__(logger, part, jlink_ser, pdp_img, sw)
+    # shared signing session, the signing tool is run per device if not provided
+    self._signer = signer
+
+  def _init_and_generate_csrs(self, dev_type, dsn, apid, board_id):
+    self._logger.debug("Initializing on-device certificate generation, generating SMSN and CSRs")
+    rx_plds = self._pdp.comm_send_receive_batch([
+      OnDevCertGen_Init(),
+      OnDevCertGen_GenSMSN(dev_type, dsn, apid, board_id),
+      OnDevCertGen_GenCSR(CryptoCurve.ED25519),
+      OnDevCertGen_GenCSR(CryptoCurve.P256R1)])
+    if rx_plds is None:
+      raise SystemError("Failed to generate SMSN and CSRs")
+    smsn = self._parse_smsn(rx_plds[1])
+    csr_ed25519 = self._parse_csr(CryptoCurve.ED25519, rx_plds[2])
+    csr_p256r1 = self._parse_csr(CryptoCurve.P256R1, rx_plds[3])
+    return smsn, csr_ed25519, csr_p256r1
 
-  def _generate_smsn(self, dev_type, dsn, apid, board_id):
-    self._logger.debug("Generating SMSN")
-    tx_pkt = OnDevCertGen_GenSMSN(dev_type, dsn, apid, board_id).serialize()
-    rx_pld = self._pdp.comm_send_receive(tx_pkt)
+  def _parse_smsn(self, rx_pld):
     smsn_len = int.from_bytes(rx_pld[PROTOCOL_DATA_SMSN_LEN_RANGE], "little")
     smsn = bytes(rx_pld[PROTOCOL_DATA_SMSN_VALUE_START_IDX:])
     self._logger.debug("SMSN({0}): {1}".format(smsn_len, binascii.hexlify(smsn)))
     return smsn
 
-  def _generate_csr(self, crypto_curve):
-    self._logger.debug("Generating CSR {0}".format(crypto_curve))
-    tx_pkt = OnDevCertGen_GenCSR(crypto_curve).serialize()
-    rx_pld = self._pdp.comm_send_receive(tx_pkt)
+  def _parse_csr(self, crypto_curve, rx_pld):
     csr_len = int.from_bytes(rx_pld[PROTOCOL_DATA_CSR_LEN_RANGE], "little")
     csr = bytes(rx_pld[PROTOCOL_DATA_CSR_VALUE_START_IDX:])
-    self._logger.debug("CSR({0}): {1}".format(csr_len, binascii.hexlify(csr)))
+    self._logger.debug("CSR {0}({1}): {2}".format(crypto_curve, csr_len, binascii.hexlify(csr)))
     return csr
 
   def _sign_csr(self, sst_prod_tag, sst_hsm_conn_addr, sst_hsm_pin, csr_ed25519, csr_p256r1, apid):
+    if self._signer:
+      self._logger.debug("Signing CSRs with the shared signing session")
+      return self._signer.sign_csrs(csr_ed25519, csr_p256r1, apid)
     self._logger.debug("Signing CSRs with sidewalk signing tool")
     csr_ed25519_b64 = base64.b64encode(csr_ed25519).decode("utf-8")
     csr_p256r1_b64 = base64.b64encode(csr_p256r1).decode("utf-8")
@@ -69,33 +79,24 @@ class OnDevCertGen(PDPModeBase):
       sys.exit(-1)
     return None, None
 
-  def _write_cert_chain(self, crypto_curve, cert):
-    self._logger.debug("Writing {0} certificate (len: {1})".format(crypto_curve, len(cert)))
-    tx_pkt = OnDevCertGen_WriteCertChain(crypto_curve, cert).serialize()
-    self._pdp.comm_send_receive(tx_pkt)
-    self._logger.debug("Done")
-
-  def _write_app_srv_pub_key(self, app_srv_pub_key_str):
+  def _write_and_store(self, cert_chain_ed25519, cert_chain_p256r1, app_srv_pub_key_str):
+    cmds = list()
+    if cert_chain_ed25519 and cert_chain_p256r1:
+      self._logger.debug("Writing {0} certificate (len: {1})".format(CryptoCurve.ED25519, len(cert_chain_ed25519)))
+      cmds.append(OnDevCertGen_WriteCertChain(CryptoCurve.ED25519, cert_chain_ed25519))
+      self._logger.debug("Writing {0} certificate (len: {1})".format(CryptoCurve.P256R1, len(cert_chain_p256r1)))
+      cmds.append(OnDevCertGen_WriteCertChain(CryptoCurve.P256R1, cert_chain_p256r1))
     app_srv_pub_key = bytearray.fromhex(app_srv_pub_key_str)
     self._logger.debug("Writing application server public key (len: {0}): {1}".format(len(app_srv_pub_key), app_srv_pub_key_str))
-    tx_pkt = OnDevCertGen_WriteAppSrvPubKey(app_srv_pub_key).serialize()
-    self._pdp.comm_send_receive(tx_pkt)
-    self._logger.debug("Done")
-
-  def _store(self):
+    cmds.append(OnDevCertGen_WriteAppSrvPubKey(app_srv_pub_key))
     self._logger.debug("Finalizing on-device certificate generation")
-    tx_pkt = OnDevCertGen_Store().serialize()
-    self._pdp.comm_send_receive(tx_pkt)
+    cmds.append(OnDevCertGen_Store())
+    if self._pdp.comm_send_receive_batch(cmds) is None:
+      raise SystemError("Failed to store the certificates")
     self._logger.debug("Done")
 
   def _provision_dd(self, **kwargs):
-    self._init()
-    smsn = self._generate_smsn(kwargs['dev_type'], kwargs['dsn'], kwargs['apid'], "")
-    csr_ed25519 = self._generate_csr(CryptoCurve.ED25519)
-    csr_p256r1 = self._generate_csr(CryptoCurve.P256R1)
-    cert_chain_ed25519, cert_chain_p256r1 = self._sign_csr(kwargs['sst_prod_tag'], kwargs['sst_hsm_conn_addr'], kwargs['sst_hsm_pin'], csr_ed25519, csr_p256r1, kwargs['apid'])
-    if cert_chain_ed25519 and cert_chain_p256r1:
-      self._write_cert_chain(CryptoCurve.ED25519, cert_chain_ed25519)
-      self._write_cert_chain(CryptoCurve.P256R1, cert_chain_p256r1)
-    self._write_app_srv_pub_key(kwargs['app_srv_pub_key'])
-    self._store()
\ No newline at end of file
+    smsn, csr_ed25519, csr_p256r1 = self._init_and_generate_csrs(kwargs['dev_type'], kwargs['dsn'], kwargs['apid'], "")
+    with self._timer.stage("sign"):
+      cert_chain_ed25519, cert_chain_p256r1 = self._sign_csr(kwargs['sst_prod_tag'], kwargs['sst_hsm_conn_addr'], kwargs['sst_hsm_pin'], csr_ed25519, csr_p256r1, kwargs['apid'])
+    self._write_and_store(cert_chain_ed25519, cert_chain_p256r1, kwargs['app_srv_pub_key'])
\ No newline at end of file
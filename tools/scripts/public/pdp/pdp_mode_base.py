@@ -1,13 +1,15 @@
 # !/usr/bin/env python3
 
 from modules.pdp import PDP
+from modules.stage_timer import StageTimer
 
 class PDPModeBase:
-  def __init__(self, logger, part, jlink_ser, pdp_img):
+  def __init__(self, logger, part, jlink_ser, pdp_img, sw=None):
     _soc_ram_st_addr = part.get_ram_start_addr()
     _soc_stack_size = part.get_stack_size()
     self._logger = logger
-    self._pdp = PDP(self._logger, part.get_jlink_device(), jlink_ser, _soc_ram_st_addr, _soc_stack_size, pdp_img)
+    self._pdp = PDP(self._logger, part.get_jlink_device(), jlink_ser, _soc_ram_st_addr, _soc_stack_size, pdp_img, sw)
+    self._timer = StageTimer()
 
   def _provision_dd(self, **kwargs):
     raise NotImplementedError("_provision_dd not implemented")
@@ -25,10 +27,16 @@ class PDPModeBase:
 
   def _provision(self, **kwargs):
     self._pdp.comm_open(start_rtt=True)
-    self._provision_dd(**kwargs)
-    self._pdp.comm_close(stop_rtt=True)
+    try:
+      self._provision_dd(**kwargs)
+    finally:
+      # release the probe for the next device even if provisioning failed
+      self._pdp.comm_close(stop_rtt=True)
 
-  def execute(self, **kwargs):
+  def execute(self, stage_timer=None, **kwargs):
+    self._timer = stage_timer if stage_timer else StageTimer()
     self._arg_check(**kwargs)
-    self._flash_pdp_bin()
-    self._provision(**kwargs)
\ No newline at end of file
+    with self._timer.stage("pdp_flash"):
+      self._flash_pdp_bin()
+    with self._timer.stage("pdp_provision"):
+      self._provision(**kwargs)
\ No newline at end of file
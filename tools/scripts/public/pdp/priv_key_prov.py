@@ -17,7 +17,7 @@ class PrivKeyProv(PDPModeBase):
     self._logger.debug("Storing {0} onto NVM3".format(MfgObj(mfg_obj_id).name))
     return PrivKeyProv_WriteNVM3(
       mfg_obj_id,
-      bytearray.fromhex(mfg_obj_data)).serialize()
+      bytearray.fromhex(mfg_obj_data))
 
   def _inject(self, mfg_obj_id, mfg_obj_data):
     self._logger.debug("Injecting {0} into SecureVault".format(MfgObj(mfg_obj_id).name))
@@ -29,7 +29,7 @@ class PrivKeyProv(PDPModeBase):
       sid_priv_keys[mfg_obj_id].ka_algo,
       sid_priv_keys[mfg_obj_id].ka_type,
       sid_priv_keys[mfg_obj_id].key_id,
-      bytearray.fromhex(mfg_obj_data)).serialize()
+      bytearray.fromhex(mfg_obj_data))
 
   _mfg_obj_dispatch = {
     MfgObj.DEVICE_PRIV_ED25519.value:           _inject,
@@ -48,6 +48,9 @@ class PrivKeyProv(PDPModeBase):
   }
 
   def _provision_dd(self, **kwargs):
+    cmds = list()
     for mfg_obj_id, mfg_obj_data in kwargs['dynamic_data'].items():
-      tx_pkt = PrivKeyProv._mfg_obj_dispatch[mfg_obj_id](self, mfg_obj_id, mfg_obj_data)
-      self._pdp.comm_send_receive(tx_pkt)
\ No newline at end of file
+      cmds.append(PrivKeyProv._mfg_obj_dispatch[mfg_obj_id](self, mfg_obj_id, mfg_obj_data))
+    # NVM3 writes and key injections are independent, send them batched
+    if self._pdp.comm_send_receive_batch(cmds) is None:
+      raise SystemError("Failed to provision the private keys")
\ No newline at end of file
@@ -0,0 +1,139 @@
+# !/usr/bin/env python3
+
+import argparse
+import logging
+import json
+import os
+import time
+from modules.pdp import PDPMode
+from modules.sid_cert import SidCertProto, SidCertProdOpenSSL, SidCertType
+from modules.commander import Commander
+from modules.part import Part
+from modules.orchestrator import Orchestrator, build_report, write_report, RESULT_STATUS_OK
+from priv_key_prov import PrivKeyProv
+from on_dev_cert_gen import OnDevCertGen
+from signing_session import SigningSession
+
+DEFAULT_REPORT_FILENAME = "out/provision_report.json"
+
+logger = logging.getLogger('provision')
+logger.setLevel(logging.DEBUG)
+ch = logging.StreamHandler()
+ch.setFormatter(logging.Formatter('%(asctime)s %(threadName)s %(levelname)s %(message)s'))
+logger.addHandler(ch)
+
+argparser = argparse.ArgumentParser(description="Sidewalk PDP provisioning script for several J-Link probes")
+argparser.add_argument("--jlink-ser", help="JLink serial numbers, one worker per probe", type=str, nargs='+', required=True)
+argparser.add_argument("--pdp-mode", help="PDP mode", type=str, choices=[PDPMode.PRIV_KEY_PROV, PDPMode.ON_DEV_CERT_GEN], required=True)
+argparser.add_argument("--prod-config", help="Configuration file for production (on-device certificate generation)", type=str)
+argparser.add_argument("--dsn-list", help="File with one device serial number per line (on-device certificate generation)", type=str)
+argparser.add_argument("--sid-cert", help="Sidewalk device certificates, one per device (private key provisioning)", type=str, nargs='+')
+argparser.add_argument("--sid-cert-type", help="Sidewalk device certificate type (private key provisioning)", type=str, choices=[SidCertType.PROTOTYPE, SidCertType.PRODUCTION])
+argparser.add_argument("--part", help="Part (ie: efr32mg24b220f1536im48) (private key provisioning)", type=str)
+argparser.add_argument("--pdp-img", help="Sidewalk PDP application image (private key provisioning)", type=str)
+argparser.add_argument("--sid-init-img", help="Sidewalk initialization image (private key provisioning)", type=str)
+argparser.add_argument("--report", help="JSON results report", type=str, default=DEFAULT_REPORT_FILENAME)
+
+def load_pdp_img(pdp_img):
+  pdp_img_bin = None
+  if pdp_img:
+    with open(pdp_img, 'rb') as f:
+      pdp_img_bin = f.read()
+  return pdp_img_bin
+
+def load_prod_config(prod_config_file):
+  logger.info("Parsing configuration file for production")
+  with open(prod_config_file, "r") as f:
+    return json.load(f)
+
+def load_dsn_list(dsn_list_file):
+  with open(dsn_list_file, "r") as f:
+    return [line.strip() for line in f if line.strip()]
+
+def flash_sid_init_img(worker_logger, part, sid_init_img, jlink_ser):
+  commander = Commander(jlink_ser)
+  worker_logger.info("Wiping device flash memory")
+  commander.masserase(part.get_jlink_device())
+  worker_logger.info("Resetting device")
+  commander.reset(part.get_jlink_device())
+  worker_logger.info("Verifying blank")
+  commander.verify_blank(part.get_jlink_device())
+  worker_logger.info("Flashing sidewalk initialization image")
+  commander.flash(sid_init_img, part.get_jlink_device())
+
+def sanity_check_args(args):
+  if args.pdp_mode == PDPMode.PRIV_KEY_PROV:
+    if not args.sid_cert or not args.sid_cert_type or not args.part or not args.pdp_img or\
+       args.prod_config or args.dsn_list:
+      raise ValueError("Provided args are not consistent")
+  else: # on-device cert gen
+    if not args.prod_config or not args.dsn_list or\
+       args.sid_cert or args.sid_cert_type or args.part or args.pdp_img or args.sid_init_img:
+      raise ValueError("Provided args are not consistent")
+
+def make_priv_key_prov_fn(args):
+  part = Part(args.part)
+  pdp_img = load_pdp_img(args.pdp_img)
+
+  def provision(jlink_ser, job, stage_timer):
+    worker_logger = logger.getChild(str(jlink_ser))
+    if args.sid_init_img:
+      with stage_timer.stage("flash_init_img"):
+        flash_sid_init_img(worker_logger, part, args.sid_init_img, jlink_ser)
+    with stage_timer.stage("parse_cert"):
+      if args.sid_cert_type == SidCertType.PROTOTYPE:
+        sid_cert = SidCertProto(job["sid_cert"], None, None)
+      else:
+        sid_cert = SidCertProdOpenSSL(job["sid_cert"])
+    PrivKeyProv(worker_logger, part, jlink_ser, pdp_img).execute(stage_timer=stage_timer, dynamic_data=sid_cert.get_dynamic_data())
+
+  return provision
+
+def make_on_dev_cert_gen_fn(prod_config, signer):
+  # production config and images are loaded once and shared by all workers
+  part = Part(prod_config["part"])
+  pdp_img = load_pdp_img(prod_config["pdp_img"])
+  sid_init_img = prod_config["sid_init_img"]
+
+  def provision(jlink_ser, job, stage_timer):
+    worker_logger = logger.getChild(str(jlink_ser))
+    if sid_init_img:
+      with stage_timer.stage("flash_init_img"):
+        flash_sid_init_img(worker_logger, part, sid_init_img, jlink_ser)
+    OnDevCertGen(worker_logger, part, jlink_ser, pdp_img, signer=signer).execute(
+      stage_timer=stage_timer,
+      dev_type=prod_config["dev_type"],
+      dsn=job["dsn"],
+      apid=prod_config["apid"],
+      app_srv_pub_key=prod_config["app_srv_pub_key"],
+      sst_prod_tag=prod_config["sst_prod_tag"],
+      sst_hsm_conn_addr=prod_config["sst_hsm_conn_addr"],
+      sst_hsm_pin=prod_config["sst_hsm_pin"])
+
+  return provision
+
+def run(args, jobs, provision_fn):
+  orchestrator = Orchestrator(logger, args.jlink_ser, provision_fn)
+  start = time.monotonic()
+  results = orchestrator.run(jobs)
+  report = build_report(results, time.monotonic() - start)
+  report_dir = os.path.dirname(args.report)
+  if report_dir:
+    os.makedirs(report_dir, exist_ok=True)
+  write_report(report, args.report)
+  summary = report["summary"]
+  logger.info("{0}/{1} devices provisioned in {2:.1f} s, report: {3}".format(summary["ok"], summary["devices"], summary["wall_time"], args.report))
+  return all(r["status"] == RESULT_STATUS_OK for r in results)
+
+if __name__ == "__main__":
+  args = argparser.parse_args()
+  sanity_check_args(args)
+  if args.pdp_mode == PDPMode.PRIV_KEY_PROV:
+    ok = run(args, [{"sid_cert": c} for c in args.sid_cert], make_priv_key_prov_fn(args))
+  else:
+    prod_config = load_prod_config(args.prod_config)
+    jobs = [{"dsn": dsn} for dsn in load_dsn_list(args.dsn_list)]
+    with SigningSession(logger, prod_config["sst_prod_tag"], prod_config["sst_hsm_conn_addr"], prod_config["sst_hsm_pin"]) as signer:
+      ok = run(args, jobs, make_on_dev_cert_gen_fn(prod_config, signer))
+  logger.info("Done")
+  exit(0 if ok else 1)
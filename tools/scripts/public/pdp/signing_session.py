@@ -0,0 +1,104 @@
+# !/usr/bin/env python3
+
+import os
+import threading
+import time
+from os import path
+
+class SigningSession:
+  """Signs the CSRs of several devices through one YubiHSM session.
+
+  Produces the same certificate chains and control logs as running
+  sidewalk_signing_tool.py once per device with --eddsa_csr, --ecdsa_csr,
+  --apid and --control_log_dir, without reconnecting to the HSM and re-reading
+  the CA objects for every device. Signing is serialized, the session may be
+  shared between provisioning workers."""
+
+  def __init__(self, logger, sst_prod_tag, sst_hsm_conn_addr, sst_hsm_pin, control_log_dir="out"):
+    self._logger = logger
+    self._prod_tag = sst_prod_tag
+    self._conn_addr = sst_hsm_conn_addr
+    self._pin = sst_hsm_pin
+    self._control_log_dir = control_log_dir
+    self._lock = threading.Lock()
+    self._sst = None
+    self._stage = None
+    self._hsm = None
+    self._session = None
+    self._store = None
+
+  def __enter__(self):
+    self.open()
+    return self
+
+  def __exit__(self, *exc):
+    self.close()
+
+  def open(self):
+    # imported here so that users of a mock signer do not need the HSM libraries
+    import sidewalk_signing_tool as sst
+    self._sst = sst
+    self._stage = self._get_stage(self._prod_tag)
+    self._logger.info("Opening HSM session at {0}".format(self._conn_addr))
+    self._hsm = sst.YubiHsm.connect(self._conn_addr)
+    self._session = sst.create_hsm_session(self._hsm, self._pin, None, self._stage)
+    self._store = sst.SidewalkCertsOnHsm(self._session, self._prod_tag)
+    os.makedirs(self._control_log_dir, exist_ok=True)
+
+  def close(self):
+    if self._session:
+      self._session.close()
+      self._session = None
+    if self._hsm:
+      self._hsm.close()
+      self._hsm = None
+    self._store = None
+
+  def sign_csrs(self, csr_ed25519, csr_p256r1, apid):
+    sst = self._sst
+    ed25519_pubk, smsn, _ = sst.decode_csr(csr_ed25519, sst.SMSN_LEN, sst.CURVE.ED25519)
+    p256r1_pubk, p256r1_smsn, _ = sst.decode_csr(csr_p256r1, sst.SMSN_LEN, sst.CURVE.P256R1)
+    if smsn != p256r1_smsn:
+      raise ValueError("serials in both CSRs do not match")
+    with self._lock:
+      output = {
+        'ed25519_chain': self._generate_chain(sst.CURVE.ED25519, ed25519_pubk, smsn),
+        'p256r1_chain': self._generate_chain(sst.CURVE.P256R1, p256r1_pubk, smsn),
+        'stage': self._stage,
+        'smsn': smsn,
+        'apid': apid,
+      }
+      self._write_control_log(output)
+    return output['ed25519_chain'], output['p256r1_chain']
+
+  def _get_stage(self, prod_tag):
+    if prod_tag.startswith('RNET_'):
+      return self._sst.STAGE.PROD
+    elif prod_tag.startswith('PREPROD_'):
+      return self._sst.STAGE.PREPROD
+    elif prod_tag.startswith('TEST_'):
+      return self._sst.STAGE.TEST
+    raise ValueError("Unable to determine the stage from the product tag {0}".format(prod_tag))
+
+  def _generate_chain(self, curve, device_pubk, smsn):
+    sst = self._sst
+    chain = self._store.get_certificate_chain(self._stage, curve)
+    device_cert = sst.SidewalkCert(type=sst.CA_TYPE.DEVICE,
+                                   curve=curve,
+                                   serial=smsn,
+                                   pubk=device_pubk,
+                                   signature=self._store.sign(curve, self._stage, device_pubk + smsn))
+    chain.append(device_cert)
+    chain.validate()
+    return chain.get_raw()
+
+  def _write_control_log(self, output):
+    while True:
+      # never overwrite an existing control log file, names have a 1 s resolution
+      cl_path = path.join(self._control_log_dir, self._sst.generate_cl_filename())
+      if not path.isfile(cl_path):
+        break
+      time.sleep(1)
+    with open(cl_path, 'w') as f:
+      f.write(self._sst.output_formatter_cl_4_0_1(output))
+    self._logger.debug("Control log: {0}".format(cl_path))